@@ -5,20 +5,114 @@
 #include <BLEServer.h>
 #include <BLEUtils.h>
 #include <BLE2902.h>
+#include <esp_gatts_api.h>
+#include <esp_idf_version.h>
 #include "config.h"
+#include "CommandQueue.h"
+#include "CommandTransport.h"
 
 // 전방 선언
-class CommandProcessor;
+class LedEffectEngine;
 
-class BluetoothManager {
+// 연결 후 요청할 링크 프로파일
+enum BleLinkProfile {
+    LINK_PROFILE_LATENCY,   // 7.5-15ms 간격, 2M PHY, DLE
+    LINK_PROFILE_BALANCED,  // 30-50ms 간격 (일반적인 폰 기본값)
+    LINK_PROFILE_POWER      // 100-200ms 간격, 슬레이브 레이턴시 허용
+};
+
+// 실제로 협상된 링크 파라미터
+struct BleLinkInfo {
+    uint16_t mtu;
+    uint16_t connInterval;     // 1.25ms 단위
+    uint16_t slaveLatency;
+    uint16_t supervisionTimeout;  // 10ms 단위
+    uint8_t txPhy;
+    uint8_t rxPhy;
+    uint16_t txDataLength;
+    uint16_t rxDataLength;
+};
+
+// 연결별 역할: 운전자만 명령을 쓸 수 있고 관찰자는 알림만 받는다
+enum BleConnectionRole {
+    BLE_ROLE_DRIVER,
+    BLE_ROLE_OBSERVER
+};
+
+// 연결별 알림 구독 비트 (클라이언트가 각 특성의 CCCD에 쓴 값)
+#define BLE_SUBSCRIBE_RESPONSE   0x01
+#define BLE_SUBSCRIBE_TELEMETRY  0x02
+
+// 연결 테이블 항목 (conn_id 기준)
+struct BleConnection {
+    bool used;
+    uint16_t connId;
+    esp_bd_addr_t address;
+    esp_ble_addr_type_t addressType;  // 지향성 광고의 peer_addr_type으로 사용
+    BleConnectionRole role;
+    uint8_t subscriptions;  // BLE_SUBSCRIBE_* (연결마다 0에서 시작)
+    BleLinkInfo linkInfo;
+};
+
+// 광고 단계 (연결 해제 후 재연결 상태 머신)
+enum BleAdvertisingPhase {
+    ADV_PHASE_IDLE,       // 연결 테이블이 가득 차 광고하지 않음
+    ADV_PHASE_FAST,       // 짧은 간격의 비지향성 광고
+    ADV_PHASE_DIRECTED,   // 마지막 운전자 주소로 지향성 광고
+    ADV_PHASE_SLOW        // 전력 절약용 긴 간격 광고
+};
+
+class BluetoothManager : public CommandTransport {
 private:
+    static BluetoothManager* instance;  // GAP/GATTS 이벤트 핸들러용
+    
     BLEServer* pServer;
     BLECharacteristic* pCharacteristic;
-    CommandProcessor* commandProcessor;
+    BLECharacteristic* pTelemetryCharacteristic;
+    BLECharacteristic* pCommandCharacteristic;
+    BLE2902* responseCccd;    // 연결별 구독 판별용 (BLE2902 자체 값은 모든 연결이 공유)
+    BLE2902* telemetryCccd;
+    CommandQueue* commandQueue;
+    LedEffectEngine* ledEffects;
+    
+    // 연결 테이블 (BLE 태스크에서 갱신, 통신 태스크에서 조회하므로 임계 구역으로 보호)
+    BleConnection connections[BLE_MAX_CONNECTIONS];
+    volatile uint8_t connectionCount;
+    uint8_t oldConnectionCount;
+    portMUX_TYPE connectionLock;
+    unsigned long rejectedWrites;  // 관찰자가 보낸 명령 (폐기)
     
-    bool deviceConnected;
-    bool oldDeviceConnected;
     String receivedMessage;
+    volatile uint16_t lastAppliedSequence;  // 스트리밍 명령 누적 ACK (운전자 연결)
+    
+    // 링크 튜닝 (운전자 연결에 적용, 관찰자는 balanced 고정)
+    BleLinkProfile linkProfile;
+    BleLinkInfo idleLinkInfo;      // 운전자가 없을 때 getLinkInfo() 반환값
+    int pendingDataLengthSlot;     // DLE 완료 이벤트에는 주소가 없어 마지막 요청 슬롯에 반영
+    
+    // 재연결 광고 상태 머신 (BLE 콜백은 플래그만 세우고 통신 태스크에서 단계 전환)
+    BleAdvertisingPhase advertisingPhase;
+    unsigned long phaseStartedAt;
+    volatile bool connectPending;
+    volatile bool disconnectPending;
+    esp_bd_addr_t lastDriverAddress;
+    esp_ble_addr_type_t lastDriverAddressType;
+    bool hasLastDriver;
+    
+    // 운전자 연결 해제 → 재연결 시간
+    volatile bool reconnectPending;
+    unsigned long disconnectedAt;
+    unsigned long lastReconnectMs;
+    BleAdvertisingPhase lastReconnectPhase;
+    unsigned long reconnectCount;
+    
+    // 왕복 지연 벤치마크
+    int benchmarkTotal;
+    int benchmarkIndex;
+    unsigned long benchmarkSentAt;
+    unsigned long benchmarkMin;
+    unsigned long benchmarkMax;
+    unsigned long benchmarkSum;
     
 public:
     BluetoothManager();
@@ -26,24 +120,81 @@ public:
     
     // 초기화
     bool initialize();
-    void setCommandProcessor(CommandProcessor* processor);
+    void setCommandQueue(CommandQueue* queue);
+    void setLedEffectEngine(LedEffectEngine* engine);
     
     // 연결 상태 관리
     bool isConnected() const;
+    uint8_t getConnectionCount() const;
+    bool hasDriver() const;
     void handleConnectionChange();
     
     // 메시지 송수신
     void sendMessage(const String& message);
     String getLastReceivedMessage() const;
     
+    // 텔레메트리 (바이너리 알림)
+    size_t getMaxNotifyPayload() const;
+    
+    // CommandTransport
+    const char* getName() const override;
+    bool isActive() const override;
+    bool sendResponse(const char* text, size_t length) override;
+    bool sendTelemetry(const uint8_t* data, size_t length) override;
+    size_t getMaxPayload() const override;
+    uint16_t getLastAppliedSequence() const override;
+    void acknowledgeSequence(uint16_t sequence) override;
+    
+    // 링크 프로파일 및 협상 결과
+    void setLinkProfile(BleLinkProfile profile);
+    BleLinkProfile getLinkProfile() const;
+    const BleLinkInfo& getLinkInfo() const;
+    String getLinkInfoString() const;
+    String getConnectionsString() const;
+    String getAdvertisingString() const;
+    
+    // 왕복 지연 벤치마크 (notify → 클라이언트 에코 write)
+    bool startBenchmark(int count);
+    
     // BLE 서버 콜백 클래스 (친구 클래스)
     friend class ServerCallbacks;
     friend class CharacteristicCallbacks;
+    friend class CommandStreamCallbacks;
     
     // 내부 콜백 처리
-    void onConnect();
-    void onDisconnect();
-    void onMessageReceived(const String& message);
+    void onConnect(esp_ble_gatts_cb_param_t* param);
+    void onDisconnect(uint16_t connId);
+    void onMtuChanged(uint16_t connId, uint16_t mtu);
+    void onMessageReceived(const String& message, uint32_t rxCycles, uint16_t connId);
+    void onStreamCommandReceived(CommandMessage& message, uint16_t connId);
+    
+private:
+    int findConnection(uint16_t connId) const;
+    int findConnectionByAddress(const esp_bd_addr_t address) const;
+    int findDriver() const;
+    bool isDriver(uint16_t connId) const;
+    void handleRoleCommand(const String& message, uint16_t connId);
+    
+    // 알림 전송: 같은 버퍼를 연결마다 그대로 넘김 (클라이언트별 복사 없음)
+    // 해당 특성의 CCCD를 켠 연결에만 전송, MTU보다 긴 텍스트 응답은 조각으로 나눔
+    uint8_t subscriptionBit(BLECharacteristic* characteristic) const;
+    bool sendNotification(BLECharacteristic* characteristic, uint16_t connId, const uint8_t* data, size_t length);
+    bool sendFitted(BLECharacteristic* characteristic, uint16_t connId, uint16_t mtu, const uint8_t* data, size_t length);
+    bool notifyConnection(BLECharacteristic* characteristic, uint16_t connId, const uint8_t* data, size_t length);
+    bool notifyAll(BLECharacteristic* characteristic, const uint8_t* data, size_t length);
+    void onCccdWritten(uint16_t connId, uint16_t handle, const uint8_t* value, uint16_t length);
+    
+    void startAdvertisingPhase(BleAdvertisingPhase phase);
+    void updateAdvertising();
+    static const char* phaseToString(BleAdvertisingPhase phase);
+    bool canDirectToLastDriver() const;
+    static esp_ble_addr_type_t connectAddressType(const esp_ble_gatts_cb_param_t* param);
+    
+    void applyLinkProfile(int slot);
+    void sendBenchmarkProbe();
+    void handleBenchmarkEcho(const String& message);
+    static void gapEventHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t* param);
+    static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf, esp_ble_gatts_cb_param_t* param);
 };
 
 // BLE 서버 콜백 클래스
@@ -53,8 +204,9 @@ private:
     
 public:
     ServerCallbacks(BluetoothManager* manager);
-    void onConnect(BLEServer* pServer) override;
-    void onDisconnect(BLEServer* pServer) override;
+    void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) override;
+    void onDisconnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) override;
+    void onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) override;
 };
 
 // BLE 특성 콜백 클래스
@@ -64,7 +216,18 @@ private:
     
 public:
     CharacteristicCallbacks(BluetoothManager* manager);
-    void onWrite(BLECharacteristic* pCharacteristic) override;
+    void onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) override;
+};
+
+// 스트리밍 명령 특성 콜백 클래스 (Write Without Response)
+// 페이로드: [sequence u16][clientTime u32][명령 문자열] (little-endian)
+class CommandStreamCallbacks : public BLECharacteristicCallbacks {
+private:
+    BluetoothManager* btManager;
+    
+public:
+    CommandStreamCallbacks(BluetoothManager* manager);
+    void onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) override;
 };
 
 #endif // BLUETOOTH_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef BOOT_SEQUENCER_H
+#define BOOT_SEQUENCER_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+
+// 부팅 단계 (setup()에서 진행되는 순서, 뒤의 두 단계는 setup() 이후에 기록됨)
+enum BootStage {
+    BOOT_STAGE_SERIAL,          // 시리얼 시작
+    BOOT_STAGE_I2C,             // 버스 속도 결정
+    BOOT_STAGE_MOTORS_SAFE,     // PCA9685 설정 + 정지 프레임 출력
+    BOOT_STAGE_COMMAND_PATH,    // 명령 큐 + 시리얼 경로 준비
+    BOOT_STAGE_ADVERTISING,     // 첫 BLE 광고 시작
+    BOOT_STAGE_SETUP_DONE,      // 나머지 경로와 제어 루프까지 준비 (통신 태스크 시작)
+    BOOT_STAGE_BACKGROUND_DONE, // 디스플레이/LED 등 백그라운드 단계 완료
+    BOOT_STAGE_FIRST_COMMAND,   // 처음으로 처리한 명령
+    BOOT_STAGE_COUNT
+};
+
+// 백그라운드 단계에서 실행할 함수
+typedef void (*BootStageFunction)(void* arg);
+
+// 단계별 부팅 시각 기록과 백그라운드 단계 실행
+// 시각은 micros() 기준(앱 시작부터)이며 단계마다 처음 기록된 값만 유지한다.
+// 명령 경로와 무관한 느린 초기화(디스플레이 재시도, 시작 화면 등)는 runInBackground()로 넘겨
+// 통신 태스크가 먼저 명령을 받기 시작하게 한다.
+class BootSequencer {
+private:
+    volatile uint32_t stageUs[BOOT_STAGE_COUNT];  // 0이면 아직 도달하지 않음
+    TaskHandle_t backgroundTask;
+    BootStageFunction backgroundFunction;
+    void* backgroundArg;
+    
+public:
+    BootSequencer();
+    
+    // 단계 도달 기록 (두 번째 이후 호출은 무시, 어느 태스크에서나 호출 가능)
+    void mark(BootStage stage);
+    bool isReached(BootStage stage) const;
+    uint32_t getStageUs(BootStage stage) const;
+    
+    // 함수를 낮은 우선순위 태스크에서 실행하고 끝나면 BOOT_STAGE_BACKGROUND_DONE 기록
+    // (태스크를 만들 수 없으면 그 자리에서 실행)
+    bool runInBackground(BootStageFunction function, void* arg);
+    
+    void printSummary() const;
+    String getStatusString() const;
+    
+private:
+    static void backgroundTaskEntry(void* arg);
+    static const char* stageToString(BootStage stage);
+};
+
+#endif // BOOT_SEQUENCER_H
\ No newline at end of file
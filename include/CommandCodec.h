@@ -0,0 +1,182 @@
+#ifndef COMMAND_CODEC_H
+#define COMMAND_CODEC_H
+
+// 바이너리 명령 인코더/디코더
+// 텍스트 배치 명령("speed:70;right")과 같은 의미를 한 번의 쓰기로 전달한다.
+// 호스트 도구와 공유할 수 있도록 Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+//
+// 구조: [COMMAND_BINARY_MARKER u8] [op u8][인자]...
+//   COMMAND_OP_SPEED     [speed u8]              0-100%
+//   COMMAND_OP_MOVE      [direction u8]          Direction 열거형 값 (DIR_STOP ~ DIR_DIAGONAL_FR)
+//   COMMAND_OP_VELOCITY  [vx i8][vy i8][omega i8] 각 -100~100%
+//   COMMAND_OP_STOP
+//   COMMAND_OP_MACRO     [index u8]
+// 이동/속도/매크로 중 나중 op가 앞의 것을 덮어쓰며, 전체가 한 번의 모터 출력으로 적용된다.
+// 텍스트 명령은 ASCII(< 0x80)이므로 첫 바이트로 구분된다.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define COMMAND_BINARY_MARKER  0x80
+
+#define COMMAND_OP_SPEED       0x01
+#define COMMAND_OP_MOVE        0x02
+#define COMMAND_OP_VELOCITY    0x03
+#define COMMAND_OP_STOP        0x04
+#define COMMAND_OP_MACRO       0x05
+
+#define COMMAND_DIRECTION_MAX  8     // DIR_DIAGONAL_FR
+
+// MotionBatch::fields 비트
+#define MOTION_FIELD_SPEED     0x01
+#define MOTION_FIELD_DIRECTION 0x02
+#define MOTION_FIELD_VELOCITY  0x04
+#define MOTION_FIELD_MACRO     0x08
+#define MOTION_FIELD_MOTION    (MOTION_FIELD_DIRECTION | MOTION_FIELD_VELOCITY | MOTION_FIELD_MACRO)
+
+// 해석이 끝난 배치 명령 (텍스트/바이너리 공통)
+struct MotionBatch {
+    uint8_t fields;
+    uint8_t speed;
+    uint8_t direction;
+    int8_t vx;
+    int8_t vy;
+    int8_t omega;
+    uint8_t macroIndex;
+};
+
+namespace CommandCodec {
+
+inline void clear(MotionBatch& batch) {
+    batch.fields = 0;
+    batch.speed = 0;
+    batch.direction = 0;
+    batch.vx = 0;
+    batch.vy = 0;
+    batch.omega = 0;
+    batch.macroIndex = 0;
+}
+
+inline void setSpeed(MotionBatch& batch, uint8_t speed) {
+    batch.fields |= MOTION_FIELD_SPEED;
+    batch.speed = speed;
+}
+
+inline void setDirection(MotionBatch& batch, uint8_t direction) {
+    batch.fields = (uint8_t)((batch.fields & ~MOTION_FIELD_MOTION) | MOTION_FIELD_DIRECTION);
+    batch.direction = direction;
+}
+
+inline void setVelocity(MotionBatch& batch, int8_t vx, int8_t vy, int8_t omega) {
+    batch.fields = (uint8_t)((batch.fields & ~MOTION_FIELD_MOTION) | MOTION_FIELD_VELOCITY);
+    batch.vx = vx;
+    batch.vy = vy;
+    batch.omega = omega;
+}
+
+inline void setMacro(MotionBatch& batch, uint8_t index) {
+    batch.fields = (uint8_t)((batch.fields & ~MOTION_FIELD_MOTION) | MOTION_FIELD_MACRO);
+    batch.macroIndex = index;
+}
+
+inline bool isPercent(int8_t value) {
+    return value >= -100 && value <= 100;
+}
+
+// 전체가 올바를 때만 true (일부만 적용되는 일이 없도록)
+inline bool decodeBatch(const uint8_t* in, size_t len, MotionBatch& batch) {
+    clear(batch);
+    if (len < 2 || in[0] != COMMAND_BINARY_MARKER) return false;
+    
+    size_t pos = 1;
+    while (pos < len) {
+        uint8_t op = in[pos++];
+        switch (op) {
+            case COMMAND_OP_SPEED:
+                if (pos + 1 > len || in[pos] > 100) return false;
+                setSpeed(batch, in[pos]);
+                pos += 1;
+                break;
+            case COMMAND_OP_MOVE:
+                if (pos + 1 > len || in[pos] > COMMAND_DIRECTION_MAX) return false;
+                setDirection(batch, in[pos]);
+                pos += 1;
+                break;
+            case COMMAND_OP_VELOCITY:
+                if (pos + 3 > len) return false;
+                if (!isPercent((int8_t)in[pos]) || !isPercent((int8_t)in[pos + 1]) || !isPercent((int8_t)in[pos + 2])) {
+                    return false;
+                }
+                setVelocity(batch, (int8_t)in[pos], (int8_t)in[pos + 1], (int8_t)in[pos + 2]);
+                pos += 3;
+                break;
+            case COMMAND_OP_STOP:
+                setDirection(batch, 0);  // DIR_STOP
+                break;
+            case COMMAND_OP_MACRO:
+                if (pos + 1 > len) return false;
+                setMacro(batch, in[pos]);
+                pos += 1;
+                break;
+            default:
+                return false;
+        }
+    }
+    return batch.fields != 0;
+}
+
+// 호스트 도구용 인코더 (버퍼가 부족하면 false)
+class BatchEncoder {
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;
+    
+    bool put(const uint8_t* bytes, size_t count) {
+        if (length + count > capacity) return false;
+        for (size_t i = 0; i < count; i++) buffer[length++] = bytes[i];
+        return true;
+    }
+    
+public:
+    BatchEncoder() : buffer(0), capacity(0), length(0) {}
+    
+    bool begin(uint8_t* buf, size_t cap) {
+        buffer = buf;
+        capacity = cap;
+        length = 0;
+        const uint8_t marker = COMMAND_BINARY_MARKER;
+        return put(&marker, 1);
+    }
+    
+    bool speed(uint8_t percent) {
+        const uint8_t op[2] = { COMMAND_OP_SPEED, percent };
+        return put(op, 2);
+    }
+    
+    bool move(uint8_t direction) {
+        const uint8_t op[2] = { COMMAND_OP_MOVE, direction };
+        return put(op, 2);
+    }
+    
+    bool velocity(int8_t vx, int8_t vy, int8_t omega) {
+        const uint8_t op[4] = { COMMAND_OP_VELOCITY, (uint8_t)vx, (uint8_t)vy, (uint8_t)omega };
+        return put(op, 4);
+    }
+    
+    bool stop() {
+        const uint8_t op = COMMAND_OP_STOP;
+        return put(&op, 1);
+    }
+    
+    bool macro(uint8_t index) {
+        const uint8_t op[2] = { COMMAND_OP_MACRO, index };
+        return put(op, 2);
+    }
+    
+    size_t size() const { return length; }
+};
+
+} // namespace CommandCodec
+
+#endif // COMMAND_CODEC_H
\ No newline at end of file
@@ -2,32 +2,99 @@
 #define COMMAND_PROCESSOR_H
 
 #include "config.h"
+#include "CommandQueue.h"
+#include "CommandScheduler.h"
+#include "CommandCodec.h"
+#include "MotionIntent.h"
+#include "LatencyTracker.h"
 
 // 전방 선언
 class MotorController;
 class EncoderManager;
 class DisplayManager;
+class TelemetryManager;
+class BluetoothManager;
+class MacroManager;
+class TransportManager;
+class EspNowTransport;
+class FleetReceiver;
+class KeepaliveMonitor;
+class ParameterRegistry;
+class LedEffectEngine;
+class I2cBusScheduler;
+class I2cWorker;
+class I2cHealthMonitor;
+class BootSequencer;
+class TaskMonitor;
+class ControlLoop;
 
 class CommandProcessor {
 private:
     MotorController* motorController;
     EncoderManager* encoderManager;
     DisplayManager* displayManager;
+    TelemetryManager* telemetryManager;
+    BluetoothManager* bluetoothManager;
+    LatencyTracker* latencyTracker;
+    CommandScheduler* commandScheduler;
+    MacroManager* macroManager;
+    TransportManager* transportManager;
+    EspNowTransport* espNowTransport;
+    FleetReceiver* fleetReceiver;
+    KeepaliveMonitor* keepaliveMonitor;
+    ParameterRegistry* parameterRegistry;
+    LedEffectEngine* ledEffects;
+    I2cBusScheduler* i2cBus;
+    I2cWorker* i2cWorker;
+    I2cHealthMonitor* i2cHealth;
+    BootSequencer* bootSequencer;
+    TaskMonitor* taskMonitor;
+    ControlLoop* controlLoop;
     
     bool isAutoMode;
+    CommandTrace currentTrace;  // 처리 중인 명령의 단계별 타임스탬프
+    bool commandRejected;       // 처리 중인 명령이 거부됨 (누적 ACK를 올리지 않음)
     
 public:
     CommandProcessor();
-    ~CommandProcessor();
     
     // 초기화 및 의존성 주입
     void setMotorController(MotorController* controller);
     void setEncoderManager(EncoderManager* manager);
     void setDisplayManager(DisplayManager* display);
+    void setTelemetryManager(TelemetryManager* manager);
+    void setBluetoothManager(BluetoothManager* manager);
+    void setLatencyTracker(LatencyTracker* tracker);
+    void setCommandScheduler(CommandScheduler* scheduler);
+    void setMacroManager(MacroManager* manager);
+    void setTransportManager(TransportManager* manager);
+    void setEspNowTransport(EspNowTransport* transport);
+    void setFleetReceiver(FleetReceiver* receiver);
+    void setKeepaliveMonitor(KeepaliveMonitor* monitor);
+    void setParameterRegistry(ParameterRegistry* registry);
+    void setLedEffectEngine(LedEffectEngine* engine);
+    void setI2cBusScheduler(I2cBusScheduler* scheduler);
+    void setI2cWorker(I2cWorker* worker);
+    void setI2cHealthMonitor(I2cHealthMonitor* monitor);
+    void setBootSequencer(BootSequencer* sequencer);
+    void setTaskMonitor(TaskMonitor* monitor);
+    void setControlLoop(ControlLoop* loop);
     
-    // 명령 처리
+    // 명령 처리 (통신 태스크): 해석과 응답만 하고 모터 관련 변경은 동작 의도로 제어 태스크에 넘김
+    void processMessage(const CommandMessage& message);  // 큐에서 꺼낸 명령 (지연 계측 포함)
     void processCommand(const String& command);
     
+    // 제어 태스크에서만 호출 (모터 출력, 매크로/keepalive 상태는 여기서만 바뀜)
+    void applyIntent(const MotionIntent& intent);
+    void executeScheduled(const ScheduledCommand& command);
+    void updateMacros(uint32_t nowUs);
+    void updateKeepalive(uint32_t nowUs);
+    void updateBenchmark(uint32_t nowUs);
+    
+    // I2C 복구 후 모터 드라이버 재동기화 (loop()의 상태 감시에서 호출, 출력은 제어 태스크에 넘김)
+    void beginMotorResync();
+    void finishMotorResync();
+    
     // 모드 관리
     void setAutoMode(bool autoMode);
     bool isInAutoMode() const;
@@ -36,7 +103,41 @@ private:
     // 명령 처리 헬퍼 함수
     void processMovementCommand(const String& command);
     void processSpeedCommand(const String& command);
+    void processVelocityCommand(const String& command);
+    void processKeepaliveCommand(const String& command);
+    void processParameterCommand(const String& command);
+    void processParameterBinary(const CommandMessage& message);
+    void applyParameterChanges();
     bool processSystemCommand(const String& command);
+    void processTelemetryCommand(const String& command);
+    void processLinkCommand(const String& command);
+    void processTransportCommand(const String& command);
+    void processFleetCommand(const String& command);
+    void processLatencyCommand(const String& command);
+    void processI2cCommand(const String& command);
+    void processScheduleCommand(const String& command, const CommandMessage& message);
+    void processMacroCommand(const String& command);
+    void defineMacro(const String& definition);
+    void runMacro(int index);
+    
+    // 배치 명령 ("speed:70;right" 또는 바이너리): 모두 해석한 뒤 한 번에 적용
+    void processBatchCommand(const String& command);
+    void processBinaryCommand(const CommandMessage& message);
+    bool parseBatch(const String& command, MotionBatch& batch, String& invalidPart);
+    bool parseBatchPart(const String& part, MotionBatch& batch);
+    
+    // 동작 의도 전달 (적용될 때까지 잠시 기다림, 큐가 가득 차면 false)
+    bool submitIntent(MotionIntent& intent);
+    bool submitMotion(const MotionBatch& batch);
+    
+    // 제어 태스크 쪽 적용
+    void applyMotionBatch(const MotionBatch& batch, uint32_t receivedUs);
+    void applyDirection(Direction direction);
+    void applyVelocity(int8_t vx, int8_t vy, int8_t omega, uint32_t receivedUs);
+    
+    // 응답 전송 (활성화된 모든 전송 경로, 시리얼 텍스트 사용자에게는 응답 줄)
+    void sendResponse(const String& response);
+    void sendBinaryResponse(const uint8_t* data, size_t length);
     
     // 유틸리티 함수
     String toLowerCase(const String& str) const;
@@ -0,0 +1,56 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "config.h"
+
+class CommandTransport;
+
+// 명령 출처
+enum CommandSource {
+    COMMAND_SOURCE_BLE,         // 기존 READ/WRITE 특성 (텍스트)
+    COMMAND_SOURCE_BLE_STREAM,  // Write Without Response 스트리밍 특성
+    COMMAND_SOURCE_SERIAL,      // USB 시리얼 (텍스트 줄)
+    COMMAND_SOURCE_SERIAL_FRAME,// USB 시리얼 (COBS 프레임)
+    COMMAND_SOURCE_ESPNOW,      // ESP-NOW 컨트롤러
+    COMMAND_SOURCE_FLEET        // 플릿 브로드캐스트 광고 (응답 없음)
+};
+
+// 수신 콜백 → 통신 태스크로 전달되는 명령 메시지
+struct CommandMessage {
+    uint8_t source;         // CommandSource
+    CommandTransport* transport;  // 응답/ACK를 돌려보낼 경로
+    bool hasSequence;
+    uint16_t sequence;      // 클라이언트 시퀀스 번호
+    uint32_t clientTime;    // 클라이언트 타임스탬프 (ms, 클라이언트 시계)
+    uint32_t rxCycles;      // 수신 시점 사이클 카운터
+    bool overLength;        // COMMAND_MAX_LENGTH보다 길어 잘린 명령 (실행하지 않고 오류 응답)
+    uint16_t length;
+    char text[COMMAND_MAX_LENGTH + 1];
+};
+
+class CommandQueue {
+private:
+    QueueHandle_t queue;
+    unsigned long droppedCount;
+    
+public:
+    CommandQueue();
+    ~CommandQueue();
+    
+    bool initialize();
+    
+    // 수신 콜백에서 호출 (대기하지 않음, 너무 긴 명령은 overLength로 표시되어 거부됨)
+    bool push(const CommandMessage& message);
+    bool push(CommandSource source, CommandTransport* transport, const char* text, size_t length, uint32_t rxCycles);
+    
+    // 통신 태스크에서 호출
+    bool pop(CommandMessage& message);
+    bool waitForCommand(uint32_t timeoutMs);  // 메시지를 꺼내지 않고 도착할 때까지 대기
+    
+    size_t getDepth() const;
+    unsigned long getDroppedCount() const;
+};
+
+#endif // COMMAND_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef COMMAND_SCHEDULER_H
+#define COMMAND_SCHEDULER_H
+
+#include "config.h"
+#include "CommandCodec.h"
+
+// 실행 시각이 지정된 명령 (로봇 시계 기준 micros())
+// 예약 시점에 통신 태스크가 해석을 끝내 두므로 제어 틱은 문자열을 다루지 않는다.
+struct ScheduledCommand {
+    uint32_t dueUs;
+    uint32_t order;         // 같은 시각의 명령은 도착 순서대로 실행
+    bool hasSequence;
+    uint16_t sequence;
+    MotionBatch batch;
+};
+
+// 예약 결과
+enum ScheduleResult {
+    SCHEDULE_OK,
+    SCHEDULE_FULL,          // 큐가 가득 참
+    SCHEDULE_TOO_FAR        // 허용된 선행 시간(look-ahead)을 넘어섬
+};
+
+// 실행 시각 순으로 정렬되는 고정 크기 명령 큐 (최소 힙)
+// 통신 태스크에서 schedule(), 제어 틱에서 popDue()를 호출하므로 내부는 임계 구역으로 보호한다.
+class CommandScheduler {
+private:
+    ScheduledCommand heap[SCHEDULER_CAPACITY];
+    volatile uint8_t count;
+    uint32_t nextOrder;
+    portMUX_TYPE lock;
+    
+    // 통계
+    unsigned long executedCount;
+    unsigned long lateCount;
+    unsigned long rejectedCount;
+    uint32_t maxLatenessUs;
+    
+public:
+    CommandScheduler();
+    
+    ScheduleResult schedule(uint32_t dueUs, const MotionBatch& batch, bool hasSequence, uint16_t sequence);
+    
+    // 실행 시각이 된 가장 이른 명령을 꺼냄
+    bool popDue(uint32_t nowUs, ScheduledCommand& command);
+    
+    // 다음 명령까지 남은 시간 (없으면 false)
+    bool getTimeUntilNext(uint32_t nowUs, int32_t& remainingUs);
+    
+    void recordExecution(uint32_t latenessUs);
+    void clear();
+    
+    uint8_t getCount() const;
+    uint8_t getCapacity() const;
+    String getStatusString();
+    
+private:
+    static bool isEarlier(uint32_t a, uint32_t b);
+    static bool comesBefore(const ScheduledCommand& a, const ScheduledCommand& b);
+    void siftUp(uint8_t index);
+    void siftDown(uint8_t index);
+};
+
+#endif // COMMAND_SCHEDULER_H
\ No newline at end of file
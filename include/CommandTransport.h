@@ -0,0 +1,43 @@
+#ifndef COMMAND_TRANSPORT_H
+#define COMMAND_TRANSPORT_H
+
+// 명령/응답/텔레메트리 전송 경로 인터페이스 (BLE, USB 시리얼, ESP-NOW, 루프백)
+// 수신한 명령은 각 구현이 CommandQueue로 넘기고(CommandMessage::transport에 자신을 기록),
+// CommandProcessor와 TelemetryManager는 이 인터페이스로만 응답/ACK/텔레메트리를 보낸다.
+// 호스트에서도 빌드할 수 있도록 Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 아직 적용된 명령이 없음 (연결마다 이 값에서 시작, 클라이언트 시퀀스는 0xFFFE 다음에 0으로 넘어감)
+// 클라이언트가 이 값을 시퀀스로 보내면 ACK가 필요 없는 명령으로 처리한다.
+#define COMMAND_SEQUENCE_NONE 0xFFFF
+
+class CommandTransport {
+public:
+    virtual ~CommandTransport() {}
+    
+    virtual const char* getName() const = 0;
+    
+    // 응답/텔레메트리를 받을 상대가 있는지 (연결됨, 최근 프레임 수신 등)
+    virtual bool isActive() const = 0;
+    
+    // 통신 태스크에서 호출 (폴링이 필요한 전송만 구현)
+    virtual void update() {}
+    
+    // 송신 (대기하지 않으며 보내지 못하면 false)
+    virtual bool sendResponse(const char* text, size_t length) = 0;
+    virtual bool sendTelemetry(const uint8_t* data, size_t length) = 0;
+    virtual size_t getMaxPayload() const = 0;  // 텔레메트리 프레임 한 개의 최대 크기
+    
+    // 활성 링크가 없을 때의 텍스트 응답 (기본: 보내지 않음)
+    // 시리얼은 프레임 없이 줄 단위로 명령을 보내는 사용자에게 응답 줄을 그대로 출력한다.
+    virtual bool sendTextResponse(const char* /*text*/, size_t /*length*/) { return false; }
+    
+    // 누적 ACK (텔레메트리 프레임의 ackSeq로 전달)
+    // 실제로 적용된 명령만 올라가며, 새 연결/운전자 교체 시 COMMAND_SEQUENCE_NONE으로 돌아간다.
+    virtual uint16_t getLastAppliedSequence() const = 0;
+    virtual void acknowledgeSequence(uint16_t sequence) = 0;
+};
+
+#endif // COMMAND_TRANSPORT_H
\ No newline at end of file
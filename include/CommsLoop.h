@@ -0,0 +1,52 @@
+#ifndef COMMS_LOOP_H
+#define COMMS_LOOP_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+
+// 전방 선언
+class BluetoothManager;
+class TransportManager;
+class FleetReceiver;
+class CommandQueue;
+class CommandProcessor;
+class TelemetryManager;
+class TaskMonitor;
+
+// 통신 태스크
+// 수신 콜백(BLE/ESP-NOW)은 명령 큐에 넣기만 하고, 이 태스크가 큐를 비우며 명령을 처리하고 응답/텔레메트리를 보낸다.
+// 제어 태스크보다 낮고 loop()(디스플레이 외 UI/로그/버스 감시)보다 높은 우선순위로 동작한다.
+class CommsLoop {
+private:
+    BluetoothManager* bluetoothManager;
+    TransportManager* transportManager;
+    FleetReceiver* fleetReceiver;
+    CommandQueue* commandQueue;
+    CommandProcessor* commandProcessor;
+    TelemetryManager* telemetryManager;
+    TaskMonitor* taskMonitor;
+    
+    TaskHandle_t taskHandle;
+    int monitorId;
+    
+public:
+    CommsLoop();
+    ~CommsLoop();
+    
+    // 초기화 및 의존성 주입 (모든 의존성을 연결한 뒤 initialize()로 태스크 시작)
+    bool initialize();
+    void setBluetoothManager(BluetoothManager* manager);
+    void setTransportManager(TransportManager* manager);
+    void setFleetReceiver(FleetReceiver* receiver);
+    void setCommandQueue(CommandQueue* queue);
+    void setCommandProcessor(CommandProcessor* processor);
+    void setTelemetryManager(TelemetryManager* manager);
+    void setTaskMonitor(TaskMonitor* monitor);
+    
+private:
+    static void taskEntry(void* arg);
+    void runOnce();
+};
+
+#endif // COMMS_LOOP_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "config.h"
+#include "MotionIntent.h"
+
+// 전방 선언
+class CommandScheduler;
+class CommandProcessor;
+class TaskMonitor;
+
+// 고정 주기 제어 틱
+// esp_timer가 제어 태스크를 깨우고, 태스크는 예약된 명령을 실행 시각에 맞춰 처리한다.
+// 다음 명령이 틱 사이에 예정되어 있으면 one-shot 타이머로 정확한 시각에 한 번 더 깨운다.
+// 모터 출력은 이 태스크만 쓴다: 다른 태스크는 submit()으로 동작 의도를 넘기고, 틱은 잠금을 기다리지 않는다.
+class ControlLoop {
+private:
+    CommandScheduler* commandScheduler;
+    CommandProcessor* commandProcessor;
+    TaskMonitor* taskMonitor;
+    int monitorId;
+    
+    esp_timer_handle_t tickTimer;
+    esp_timer_handle_t preciseTimer;
+    TaskHandle_t taskHandle;
+    volatile bool preciseArmed;
+    
+    // 동작 의도 큐 (통신 태스크/loop() → 제어 태스크)
+    QueueHandle_t intentQueue;
+    uint32_t nextTicket;
+    volatile uint32_t appliedTicket;
+    
+    // 통계
+    unsigned long tickCount;
+    uint32_t maxTickUs;
+    
+public:
+    ControlLoop();
+    ~ControlLoop();
+    
+    // 초기화 및 의존성 주입
+    bool initialize();
+    void setCommandScheduler(CommandScheduler* scheduler);
+    void setCommandProcessor(CommandProcessor* processor);
+    void setTaskMonitor(TaskMonitor* monitor);
+    
+    // 동작 의도 전달: 제어 태스크를 바로 깨워 적용 (우선순위가 높으므로 보통 반환 전에 끝남)
+    // 번호를 반환하고 큐가 가득 차면 0
+    uint32_t submit(MotionIntent& intent);
+    bool waitApplied(uint32_t ticket, uint32_t timeoutMs);  // 제어 태스크가 아닌 곳에서만 호출
+    
+    String getStatusString() const;
+    
+private:
+    static void timerCallback(void* arg);
+    static void preciseTimerCallback(void* arg);
+    static void taskEntry(void* arg);
+    void tick();
+    void applyIntents();
+};
+
+#endif // CONTROL_LOOP_H
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define DISPLAY_MANAGER_H
 
 #include <U8x8lib.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "config.h"
 #include "version.h"  // 버전 정보 포함
 #include <Arduino.h>  // String 타입을 위해 추가
@@ -9,16 +11,23 @@
 // 전방 선언
 class MotorController;
 class EncoderManager;
+class LedEffectEngine;
+class I2cBusScheduler;
+class TaskMonitor;
 
 class DisplayManager {
 private:
     U8X8_SSD1306_128X64_NONAME_HW_I2C* display;
     MotorController* motorController;
     EncoderManager* encoderManager;
+    LedEffectEngine* ledEffects;
+    I2cBusScheduler* i2cBus;
+    TaskMonitor* taskMonitor;
     
     // 디스플레이 상태 관리
     bool showEncoderInfo;
-    bool isInitialized;
+    volatile bool isInitialized;    // 부팅 태스크에서 패널 준비가 끝나면 true (이후 display는 바뀌지 않음)
+    volatile int8_t connectionState;  // 마지막 연결 상태 (-1: 아직 없음), 준비 전 갱신은 시작 화면 뒤에 다시 그림
     
     // 통신 상태 추적
     bool isSending;
@@ -26,6 +35,30 @@ private:
     String lastResponse;
     unsigned long lastUpdateTime;
     
+    // 16x8 문자 섀도 버퍼: 쓰기는 shadow만 바꾸고 flush()에서 shown과 다른 타일만 전송
+    static const int TEXT_COLUMNS = 16;
+    static const int TEXT_ROWS = 8;
+    char shadow[TEXT_ROWS][TEXT_COLUMNS];
+    char shown[TEXT_ROWS][TEXT_COLUMNS];   // 패널에 실제로 그려진 내용
+    
+    // 명령 처리 쪽은 모델(shadow + 플래그)만 바꾸고, 갱신 태스크가 고정 주기로 최신 상태만 그림
+    portMUX_TYPE modelLock;
+    volatile bool frameDirty;
+    volatile bool motorStatusDirty;
+    volatile bool panelOnline;      // 꺼져 있으면 전송하지 않고 모델만 갱신
+    volatile bool resyncPending;    // 다음 프레임에서 패널 재설정 + 전체 다시 그리기
+    TaskHandle_t refreshTask;
+    int monitorId;
+    unsigned long modelUpdateCount;
+    
+    // 갱신당 I2C 바이트 (diff 전송 / 이전 방식 환산)
+    unsigned long flushCount;
+    unsigned long lastFlushBytes;
+    unsigned long lastLegacyBytes;
+    unsigned long pendingLegacyBytes;
+    unsigned long totalFlushBytes;
+    unsigned long totalLegacyBytes;
+    
     // 디스플레이 설정
     static const int SCREEN_WIDTH = 128;
     static const int SCREEN_HEIGHT = 64;
@@ -43,6 +76,11 @@ public:
     bool initialize();
     void setMotorController(MotorController* controller);
     void setEncoderManager(EncoderManager* manager);
+    void setLedEffectEngine(LedEffectEngine* engine);
+    void setI2cBusScheduler(I2cBusScheduler* scheduler);
+    void setTaskMonitor(TaskMonitor* monitor);
+    bool startRefreshTask();  // 이후 화면 업데이트는 모델 갱신만 하고 바로 반환
+    void setPanelOnline(bool online);  // I2C 상태 감시에서 호출
     
     // 화면 업데이트
     void updateConnectionStatus(bool connected);
@@ -62,7 +100,10 @@ public:
     void clearScreen();
     void clearLine(int line);
     
-    // LED 효과
+    // I2C 전송량 통계
+    String getStatusString() const;
+    
+    // LED 효과 (LedEffectEngine에 요청만 하고 바로 반환)
     void showMessageReceivedEffect();
     void showStartupEffect();
     
@@ -70,7 +111,17 @@ private:
     // 내부 헬퍼 함수
     void displayEncoderInfo();
     void displayMotorStatus();
+    void renderMotorStatus();
+    void renderConnectionStatus(bool connected);
     void displayText(int x, int y, const String& text);
+    void writeLine(int row, const String& text);
+    void requestFlush();
+    void flush();
+    void resyncPanel();
+    void acquireBus();
+    void releaseBus();
+    static void refreshTaskEntry(void* arg);
+    String abbreviate(const String& text) const;
 };
 
 #endif // DISPLAY_MANAGER_H
\ No newline at end of file
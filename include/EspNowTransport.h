@@ -0,0 +1,75 @@
+#ifndef ESPNOW_TRANSPORT_H
+#define ESPNOW_TRANSPORT_H
+
+#include <esp_now.h>
+#include <Preferences.h>
+#include "config.h"
+#include "CommandQueue.h"
+#include "CommandTransport.h"
+
+// ESP-NOW 비연결형 명령 전송 (페어링된 컨트롤러 1대)
+// 패킷 구조는 SerialFrameCodec 프레임에서 COBS/CRC를 뺀 것과 같다 (ESP-NOW 자체 CRC 사용):
+//   [type u8][sequence u16][clientTime u32][payload]
+// 수신 콜백은 WiFi 태스크에서 호출되므로 큐에 넣기만 하고, NVS 저장/피어 등록/시리얼 출력은 update()에서 처리한다.
+// 콜백과 공유하는 페어링 상태는 stateLock으로 보호한다.
+class EspNowTransport : public CommandTransport {
+private:
+    static EspNowTransport* instance;  // 수신 콜백용
+    
+    CommandQueue* commandQueue;
+    Preferences preferences;
+    bool initialized;
+    
+    // 페어링 (stateLock 안에서만 변경)
+    portMUX_TYPE stateLock;
+    uint8_t peerAddress[6];
+    bool paired;
+    bool pairing;
+    unsigned long pairingStartTime;
+    bool pairingPending;  // 콜백에서 새 컨트롤러를 받아 저장 대기 중
+    uint8_t pendingAddress[6];
+    
+    // 링크 상태
+    volatile unsigned long lastReceiveTime;
+    volatile uint16_t lastAppliedSequence;
+    
+    // 통계
+    volatile unsigned long packetsReceived;
+    volatile unsigned long packetsRejected;
+    volatile unsigned long queueDrops;    // 명령 큐가 가득 차 버린 패킷 (콜백에서는 세기만 함)
+    unsigned long reportedQueueDrops;
+    unsigned long sendFailures;
+    
+public:
+    EspNowTransport();
+    ~EspNowTransport();
+    
+    // 초기화 (WiFi STA 모드 + ESP-NOW, NVS에서 페어링 정보 로드)
+    bool initialize();
+    void setCommandQueue(CommandQueue* queue);
+    
+    // 페어링: 창이 열려 있는 동안 처음 명령을 보낸 컨트롤러를 저장
+    void startPairing();
+    void unpair();
+    bool isPaired() const;
+    
+    // CommandTransport
+    const char* getName() const override;
+    bool isActive() const override;
+    void update() override;
+    bool sendResponse(const char* text, size_t length) override;
+    bool sendTelemetry(const uint8_t* data, size_t length) override;
+    size_t getMaxPayload() const override;
+    uint16_t getLastAppliedSequence() const override;
+    void acknowledgeSequence(uint16_t sequence) override;
+    
+    String getStatusString() const;
+    
+private:
+    static void receiveCallback(const uint8_t* mac, const uint8_t* data, int length);
+    void onReceive(const uint8_t* mac, const uint8_t* data, int length);
+    static bool addPeer(const uint8_t* address);
+    bool sendPacket(uint8_t type, const uint8_t* payload, size_t length);
+};
+
+#endif // ESPNOW_TRANSPORT_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef FLEET_CODEC_H
+#define FLEET_CODEC_H
+
+// 플릿 브로드캐스트 패킷 (BLE 광고의 제조사 데이터 필드)
+// 송신기 한 대가 연결 없이 여러 로봇을 동시에 구동하기 위한 형식이다.
+// 송신기/호스트 도구와 공유할 수 있도록 Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+//
+// 구조 (little-endian, 12바이트):
+//   [companyId u16][type u8 = FLEET_PACKET_TYPE][groupMask u32][sequence u8]
+//   [vx i8][vy i8][omega i8][flags u8]
+// groupMask의 비트 n이 켜져 있으면 로봇 ID n이 대상이다.
+// 송신기는 같은 패킷을 여러 번 광고하므로 수신 측은 sequence가 바뀐 것만 적용한다.
+// 구동 중에는 FLEET_TIMEOUT_MS보다 짧은 주기로 sequence를 올려 다시 보내야 한다
+// (같은 sequence의 반복 광고는 생존 신호로 보지 않으므로, 멈춘 송신기가 같은 패킷을 계속 내보내도 로봇은 정지).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLEET_COMPANY_ID     0xFFFF  // 시험용 (Bluetooth SIG 미할당 ID)
+#define FLEET_PACKET_TYPE    0x46    // 'F'
+#define FLEET_PACKET_SIZE    12
+#define FLEET_MAX_ROBOT_ID   31
+
+#define FLEET_FLAG_STOP      0x01    // 대상 로봇 즉시 정지 (속도 무시)
+
+struct FleetCommand {
+    uint32_t groupMask;
+    uint8_t sequence;
+    int8_t vx;
+    int8_t vy;
+    int8_t omega;
+    uint8_t flags;
+};
+
+namespace FleetCodec {
+
+inline size_t encode(const FleetCommand& command, uint8_t* out) {
+    out[0] = (uint8_t)(FLEET_COMPANY_ID & 0xFF);
+    out[1] = (uint8_t)(FLEET_COMPANY_ID >> 8);
+    out[2] = FLEET_PACKET_TYPE;
+    out[3] = (uint8_t)(command.groupMask & 0xFF);
+    out[4] = (uint8_t)((command.groupMask >> 8) & 0xFF);
+    out[5] = (uint8_t)((command.groupMask >> 16) & 0xFF);
+    out[6] = (uint8_t)(command.groupMask >> 24);
+    out[7] = command.sequence;
+    out[8] = (uint8_t)command.vx;
+    out[9] = (uint8_t)command.vy;
+    out[10] = (uint8_t)command.omega;
+    out[11] = command.flags;
+    return FLEET_PACKET_SIZE;
+}
+
+// 제조사 데이터가 플릿 패킷이면 true
+inline bool decode(const uint8_t* in, size_t len, FleetCommand& command) {
+    if (len != FLEET_PACKET_SIZE) return false;
+    if (in[0] != (uint8_t)(FLEET_COMPANY_ID & 0xFF) || in[1] != (uint8_t)(FLEET_COMPANY_ID >> 8) ||
+        in[2] != FLEET_PACKET_TYPE) {
+        return false;
+    }
+    
+    command.groupMask = (uint32_t)in[3] | ((uint32_t)in[4] << 8) | ((uint32_t)in[5] << 16) | ((uint32_t)in[6] << 24);
+    command.sequence = in[7];
+    command.vx = (int8_t)in[8];
+    command.vy = (int8_t)in[9];
+    command.omega = (int8_t)in[10];
+    command.flags = in[11];
+    return command.vx >= -100 && command.vx <= 100 && command.vy >= -100 && command.vy <= 100 &&
+           command.omega >= -100 && command.omega <= 100;
+}
+
+inline bool isAddressed(const FleetCommand& command, uint8_t robotId) {
+    return robotId <= FLEET_MAX_ROBOT_ID && (command.groupMask & ((uint32_t)1 << robotId)) != 0;
+}
+
+} // namespace FleetCodec
+
+#endif // FLEET_CODEC_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef FLEET_RECEIVER_H
+#define FLEET_RECEIVER_H
+
+#include <BLEDevice.h>
+#include <BLEScan.h>
+#include <BLEAdvertisedDevice.h>
+#include <Preferences.h>
+#include "config.h"
+#include "CommandQueue.h"
+#include "FleetCodec.h"
+
+// 플릿 브로드캐스트 수신기
+// 연결 없이 광고 패킷(FleetCodec)을 스캔하여 자기 ID가 포함된 구동 명령을 CommandQueue로 넘긴다.
+// GATT 서버(BluetoothManager)의 광고/연결은 그대로 유지되므로 설정용 연결과 함께 사용할 수 있다.
+class FleetReceiver {
+private:
+    BLEScan* pScan;
+    CommandQueue* commandQueue;
+    Preferences preferences;
+    
+    uint8_t robotId;
+    bool enabled;
+    volatile bool storagePending;  // NVS에 반영할 설정 변경 있음
+    
+    // 수신 상태 (스캔 콜백은 BLE 태스크에서 호출됨)
+    volatile bool haveSequence;
+    volatile uint8_t lastSequence;
+    volatile unsigned long lastPacketTime;   // 새 sequence를 받은 시각
+    volatile bool driving;       // 마지막으로 적용한 명령이 이동 명령
+    
+    // 통계
+    volatile unsigned long packetsApplied;
+    volatile unsigned long packetsIgnored;
+    unsigned long timeoutStops;
+    
+public:
+    FleetReceiver();
+    ~FleetReceiver();
+    
+    // 초기화 (BluetoothManager 초기화 이후, NVS에서 로봇 ID/사용 여부 로드)
+    bool initialize();
+    void setCommandQueue(CommandQueue* queue);
+    
+    // 스캔 시작/중지 (설정의 NVS 저장은 commitStorage()에서, 통신 태스크 밖)
+    void setEnabled(bool enable);
+    bool isEnabled() const;
+    bool setRobotId(int id);
+    uint8_t getRobotId() const;
+    void commitStorage();  // UI 루프에서 호출
+    
+    // 통신 태스크에서 호출: 송신기가 끊기면 정지
+    void update();
+    
+    String getStatusString() const;
+    
+    friend class FleetScanCallbacks;
+    
+private:
+    void startScan();
+    void onAdvertisement(BLEAdvertisedDevice& device);
+    void pushStop();
+};
+
+// 스캔 결과 콜백 클래스
+class FleetScanCallbacks : public BLEAdvertisedDeviceCallbacks {
+private:
+    FleetReceiver* receiver;
+    
+public:
+    FleetScanCallbacks(FleetReceiver* fleetReceiver);
+    void onResult(BLEAdvertisedDevice advertisedDevice) override;
+};
+
+#endif // FLEET_RECEIVER_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef I2C_BUS_SCHEDULER_H
+#define I2C_BUS_SCHEDULER_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+
+// 버스 사용자 (숫자가 작을수록 우선)
+enum I2cClient {
+    I2C_CLIENT_MOTOR,       // PCA9685 - 제어 지연에 직접 영향
+    I2C_CLIENT_SENSOR,      // 추후 추가될 센서
+    I2C_CLIENT_DISPLAY,     // SSD1306 - 긴 전송은 조각 단위로 양보
+    I2C_CLIENT_COUNT
+};
+
+// 공유 Wire 버스 중재
+// 트랜잭션 단위로 acquire()/release()하며, 버스를 기다리는 사용자가 있으면
+// 더 낮은 우선순위 사용자는 조각 사이에서 yieldIfContended()로 버스를 넘긴다.
+// 내부 뮤텍스는 우선순위 상속을 하므로 디스플레이 태스크가 잡고 있어도 모터 쪽 대기는 한 조각 이내다.
+class I2cBusScheduler {
+private:
+    SemaphoreHandle_t busLock;
+    portMUX_TYPE statsLock;
+    volatile uint8_t waiting[I2C_CLIENT_COUNT];
+    I2cClient owner;
+    uint32_t acquiredUs;
+    uint32_t clockHz;           // probe로 정한 버스 속도
+    
+    // 사용자별 통계
+    struct ClientStats {
+        unsigned long transactions;
+        unsigned long yields;       // 더 높은 우선순위에 버스를 넘긴 횟수
+        uint64_t busTimeUs;         // 버스를 잡고 있던 총 시간
+        uint32_t maxHoldUs;
+        uint64_t totalWaitUs;
+        uint32_t maxWaitUs;         // 버스를 얻기까지 최악 대기
+    };
+    ClientStats stats[I2C_CLIENT_COUNT];
+    unsigned long resetCount;
+    
+public:
+    I2cBusScheduler();
+    ~I2cBusScheduler();
+    
+    // 트랜잭션 (같은 태스크에서 짝을 맞춰 호출)
+    void acquire(I2cClient client);
+    void release();
+    
+    // 더 높은 우선순위 사용자가 기다리면 버스를 넘기고 다시 얻음 (긴 전송의 조각 사이에서 호출)
+    bool yieldIfContended(I2cClient client);
+    
+    // 버스를 점유한 상태로 Wire 재시작 (다른 사용자의 전송 도중에 끊지 않음)
+    void resetBus(I2cClient client);
+    
+    // 부팅 시 빠른 속도부터 시도해 응답하는 장치가 모두 안정적인 가장 빠른 속도 선택
+    uint32_t selectClock();
+    uint32_t getClockHz() const;
+    
+    void resetStats();
+    String getStatusString();
+    
+private:
+    bool isHigherPriorityWaiting(I2cClient client);
+    bool verifyClock(bool checkDriver, bool checkDisplay);
+    static bool probeAddress(uint8_t address);
+    static const char* clientToString(I2cClient client);
+};
+
+#endif // I2C_BUS_SCHEDULER_H
\ No newline at end of file
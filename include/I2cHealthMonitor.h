@@ -0,0 +1,95 @@
+#ifndef I2C_HEALTH_MONITOR_H
+#define I2C_HEALTH_MONITOR_H
+
+#include "config.h"
+
+// 전방 선언
+class I2cBusScheduler;
+class CommandProcessor;
+class DisplayManager;
+
+// 감시 대상 장치 (복구 후 재동기화 순서 = 우선순위)
+enum I2cDevice {
+    I2C_DEVICE_MOTOR_DRIVER,    // PCA9685
+    I2C_DEVICE_DISPLAY,         // SSD1306
+    I2C_DEVICE_COUNT
+};
+
+// 복구 상태
+enum I2cHealthState {
+    I2C_HEALTH_OK,
+    I2C_HEALTH_RECOVER,         // SCL 클록으로 SDA 해제 후 Wire 재초기화
+    I2C_HEALTH_SETTLE,          // 버스 안정화 대기
+    I2C_HEALTH_RESYNC_MOTOR,    // PCA9685 모드/주파수 재설정 (먼저)
+    I2C_HEALTH_RESYNC_OUTPUT,   // 발진기 안정화 후 정지 프레임
+    I2C_HEALTH_RESYNC_DISPLAY,  // OLED 재설정 + 전체 다시 그리기
+    I2C_HEALTH_FAILED           // 복구 실패, 잠시 후 다시 시도
+};
+
+// I2C 버스 상태 감시와 복구
+// 워커의 전송 결과와 주기적인 주소 probe로 장치별 NACK/타임아웃을 세고,
+// 버스가 멈췄다고 판단되면 loop()에서 한 단계씩 진행하는 상태 머신으로 복구한다 (ms 단위 지연 없음).
+// 복구 뒤에는 모터 드라이버를 정지 상태로 먼저 맞추고, 디스플레이는 그다음에 다시 그린다.
+class I2cHealthMonitor {
+private:
+    I2cBusScheduler* i2cBus;
+    CommandProcessor* commandProcessor;  // 모터 재동기화는 제어 태스크에 넘김 (모터 출력은 한 곳에서만)
+    DisplayManager* displayManager;
+    
+    // 장치별 통계
+    struct DeviceHealth {
+        uint8_t address;
+        bool online;
+        uint8_t consecutiveFailures;
+        unsigned long ackCount;
+        unsigned long nackCount;
+        unsigned long timeoutCount;     // 타임아웃/버스 오류 (SDA가 잡혀 있을 때)
+        uint8_t lastError;
+    };
+    DeviceHealth devices[I2C_DEVICE_COUNT];
+    portMUX_TYPE statsLock;
+    
+    I2cHealthState state;
+    volatile bool recoveryRequested;
+    unsigned long stateStartMs;
+    unsigned long lastProbeMs;
+    uint8_t recoveryAttempts;
+    
+    // 통계
+    unsigned long recoveryCount;
+    unsigned long failedRecoveryCount;
+    unsigned long lastRecoveryStartMs;
+    unsigned long lastRecoveryMs;   // 감지 → 모터 재동기화 완료
+    uint8_t lastReleasePulses;      // SDA 해제까지 보낸 SCL 펄스 수
+    
+public:
+    I2cHealthMonitor();
+    
+    // 의존성 주입
+    void setI2cBusScheduler(I2cBusScheduler* scheduler);
+    void setCommandProcessor(CommandProcessor* processor);
+    void setDisplayManager(DisplayManager* display);
+    
+    // 전송 결과 기록 (Wire.endTransmission 반환값, 워커 태스크에서도 호출)
+    void recordResult(uint8_t address, uint8_t error);
+    
+    // loop()에서 호출
+    void update(unsigned long nowMs);
+    void requestRecovery();
+    
+    bool isDeviceOnline(I2cDevice device) const;
+    I2cHealthState getState() const;
+    String getStatusString();
+    
+private:
+    void probeDevices();
+    uint8_t probe(I2cDevice device);
+    bool needsRecovery();
+    void enterState(I2cHealthState newState, unsigned long nowMs);
+    uint8_t releaseBus();
+    int findDevice(uint8_t address) const;
+    static const char* stateToString(I2cHealthState state);
+    static const char* deviceToString(I2cDevice device);
+};
+
+#endif // I2C_HEALTH_MONITOR_H
\ No newline at end of file
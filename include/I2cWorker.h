@@ -0,0 +1,83 @@
+#ifndef I2C_WORKER_H
+#define I2C_WORKER_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "I2cBusScheduler.h"
+#include "LatencyHistogram.h"
+
+// 전방 선언
+class I2cHealthMonitor;
+class TaskMonitor;
+
+// 완료 콜백 (워커 태스크에서 호출되므로 짧게)
+typedef void (*I2cCompletion)(void* context, bool success);
+
+// 레지스터 쓰기 한 번 (data[0]이 시작 레지스터, 장치가 자동 증가)
+struct I2cTransaction {
+    I2cClient client;
+    uint8_t address;
+    uint8_t length;
+    uint8_t data[I2C_TRANSACTION_MAX_LENGTH];
+    I2cCompletion onComplete;
+    void* context;
+    uint32_t submitUs;      // submit 시각 (워커가 채움)
+};
+
+// 비동기 I2C 쓰기
+// 호출한 쪽은 트랜잭션을 넘기고 바로 돌아가고, 전용 태스크가 Wire로 전송한다.
+// Wire(IDF I2C 드라이버)는 전송 중 인터럽트 완료를 기다리며 태스크를 재우므로 그동안 CPU는 다른 태스크가 쓴다.
+// 모터 프레임은 최신 것 하나만 유지하는 슬롯으로, 그 밖의 트랜잭션은 FIFO 큐로 받는다.
+class I2cWorker {
+private:
+    I2cBusScheduler* i2cBus;
+    I2cHealthMonitor* healthMonitor;
+    TaskMonitor* taskMonitor;
+    int monitorId;
+    TaskHandle_t taskHandle;
+    QueueHandle_t queue;
+    
+    portMUX_TYPE slotLock;
+    I2cTransaction latestSlot;
+    volatile bool latestPending;
+    
+    // 통계
+    volatile unsigned long submittedCount;
+    volatile unsigned long completedCount;
+    volatile unsigned long coalescedCount;   // 전송 전에 더 새로운 프레임으로 대체됨
+    unsigned long droppedCount;     // 큐가 가득 차 거부됨
+    unsigned long errorCount;
+    LatencyHistogram completionHistogram;  // submit → 전송 완료
+    LatencyHistogram busHistogram;         // 전송 시간
+    
+public:
+    I2cWorker();
+    ~I2cWorker();
+    
+    bool initialize();
+    void setI2cBusScheduler(I2cBusScheduler* scheduler);
+    void setHealthMonitor(I2cHealthMonitor* monitor);
+    void setTaskMonitor(TaskMonitor* monitor);
+    bool isRunning() const;
+    
+    // FIFO 전송 요청 (큐가 가득 차면 false)
+    bool submit(const I2cTransaction& transaction);
+    
+    // 아직 전송되지 않은 이전 요청을 대체 (모터 프레임: 중간 프레임은 버려도 됨)
+    void submitLatest(const I2cTransaction& transaction);
+    
+    // 대기 중인 요청이 모두 끝날 때까지 기다림 (벤치마크용)
+    bool waitIdle(uint32_t timeoutMs);
+    
+    const LatencyHistogram& getBusHistogram() const;
+    void resetStats();
+    String getStatusString() const;
+    
+private:
+    static void taskEntry(void* arg);
+    void execute(I2cTransaction& transaction);
+};
+
+#endif // I2C_WORKER_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef KEEPALIVE_MONITOR_H
+#define KEEPALIVE_MONITOR_H
+
+#include "config.h"
+
+// 전방 선언
+class MotorController;
+
+// 데드맨 상태
+enum KeepaliveState {
+    KEEPALIVE_OFF,          // 비활성 (설정값을 바로 출력)
+    KEEPALIVE_WAITING,      // 활성, 스트림 시작 전 또는 이산 명령으로 해제됨
+    KEEPALIVE_STREAMING,    // 설정값 보간 중
+    KEEPALIVE_RAMPING,      // 설정값 누락 - 0으로 감속 중
+    KEEPALIVE_STOPPED       // 감속 완료, 다음 설정값을 기다림
+};
+
+// 스트리밍 조이스틱 제어용 데드맨 감시
+// 클라이언트는 선언한 주기로 vel: 설정값을 보내고, 제어 틱은 설정값 사이를 선형 보간한다.
+// 설정값이 주기 × 누락 허용 횟수 동안 오지 않으면 keepalive_ramp_ms 파라미터에 걸쳐 0으로 감속한다.
+// 설정/해제/설정값은 통신 태스크가 동작 의도로 넘기고, 모든 호출은 제어 태스크에서 일어난다.
+class KeepaliveMonitor {
+private:
+    MotorController* motorController;
+    
+    volatile KeepaliveState state;
+    uint16_t periodMs;
+    uint8_t missLimit;
+    
+    // 보간: from → target (한 주기 동안), output은 마지막으로 출력한 값
+    int8_t from[3];
+    int8_t target[3];
+    int8_t output[3];
+    bool outputValid;       // output이 지금 모터에 나가 있는 값 (다른 명령이 모터를 쓰면 false)
+    uint32_t setpointUs;    // 마지막 설정값 수신 시각
+    uint32_t rampStartUs;
+    
+    // 통계
+    unsigned long setpointCount;
+    unsigned long timeoutCount;
+    uint32_t maxGapUs;          // 설정값 사이 최대 간격
+    uint32_t lastReactionUs;    // 기한 → 감지까지 (제어 틱 주기 이내여야 함)
+    uint32_t maxReactionUs;
+    
+public:
+    KeepaliveMonitor();
+    
+    void setMotorController(MotorController* controller);
+    
+    // 설정 (명령 파서의 int를 좁히기 전에 범위 검사하도록 int로 받음)
+    bool configure(int periodMs, int missLimit);
+    static bool isValidConfig(int periodMs, int missLimit);  // 통신 태스크에서 넘기기 전에 검사
+    void disable();     // 스트리밍/감속 중이면 모터를 정지한 뒤 해제
+    bool isEnabled() const;
+    bool isActive() const;      // 제어 틱에서 update()가 필요한 상태
+    
+    // 새 설정값 (보간 시작), 이산 명령이 들어오면 cancel()로 감시 해제
+    void setSetpoint(int8_t vx, int8_t vy, int8_t omega, uint32_t nowUs);
+    void cancel();
+    
+    // 제어 틱에서 호출, 시간 초과로 정지가 끝나면 true
+    bool update(uint32_t nowUs);
+    
+    KeepaliveState getState() const;
+    String getStatusString() const;
+    
+private:
+    void applyOutput(int8_t vx, int8_t vy, int8_t omega);
+    static const char* stateToString(KeepaliveState state);
+};
+
+#endif // KEEPALIVE_MONITOR_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <Arduino.h>
+
+// log2 버킷 지연 히스토그램 (정적 메모리, 동적 할당 없음)
+// 버킷 0은 0us, 버킷 i(i >= 1)는 [2^(i-1), 2^i) us 구간을 센다.
+class LatencyHistogram {
+public:
+    static const int BUCKET_COUNT = 24;  // 최대 약 8.4초
+    
+private:
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+    
+public:
+    LatencyHistogram();
+    
+    void record(uint32_t us);
+    void reset();
+    
+    uint32_t getCount() const;
+    uint32_t getMin() const;
+    uint32_t getMax() const;
+    uint32_t getAverage() const;
+    uint32_t getPercentile(uint8_t percent) const;  // 해당 버킷의 상한 (최대값으로 제한)
+    
+    // "name n:120 p50:511us p99:2047us max:1830us" 형식
+    String toString(const char* name) const;
+};
+
+#endif // LATENCY_HISTOGRAM_H
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include "config.h"
+#include "LatencyHistogram.h"
+
+// 명령 처리 단계 (수신 → 모터 출력 완료)
+enum LatencyStage {
+    LATENCY_STAGE_QUEUE,     // 수신 → 통신 태스크에서 꺼냄
+    LATENCY_STAGE_PARSE,     // 꺼냄 → 명령 해석 완료
+    LATENCY_STAGE_DISPATCH,  // 해석 완료 → I2C 쓰기 시작
+    LATENCY_STAGE_I2C,       // I2C 쓰기 시작 → 완료 (PCA9685 출력 변경)
+    LATENCY_STAGE_TOTAL,     // 수신 → I2C 쓰기 완료
+    LATENCY_STAGE_COUNT
+};
+
+// 명령 하나의 단계별 사이클 카운터 타임스탬프 (0이면 해당 단계 없음)
+struct CommandTrace {
+    bool hasSequence;
+    uint16_t sequence;
+    uint32_t clientTime;
+    uint32_t rxCycles;
+    uint32_t dequeueCycles;
+    uint32_t parseCycles;
+    uint32_t i2cStartCycles;
+    uint32_t i2cDoneCycles;
+};
+
+class LatencyTracker {
+private:
+    LatencyHistogram histograms[LATENCY_STAGE_COUNT];
+    CommandTrace lastTrace;
+    uint32_t cyclesPerUs;
+    
+public:
+    LatencyTracker();
+    
+    // 사이클 카운터 (RISC-V mcycle)
+    static uint32_t now();
+    
+    void record(const CommandTrace& trace);
+    void reset();
+    
+    const LatencyHistogram& getHistogram(LatencyStage stage) const;
+    String getStageString(LatencyStage stage) const;
+    String getLastTraceString() const;
+    
+private:
+    uint32_t cyclesToUs(uint32_t cycles) const;
+    static const char* stageName(LatencyStage stage);
+};
+
+#endif // LATENCY_TRACKER_H
\ No newline at end of file
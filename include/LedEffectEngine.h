@@ -0,0 +1,72 @@
+#ifndef LED_EFFECT_ENGINE_H
+#define LED_EFFECT_ENGINE_H
+
+#include <esp_timer.h>
+#include "config.h"
+
+// 효과 종류 (LED_PATTERNS 테이블 인덱스)
+enum LedPatternId {
+    LED_PATTERN_MESSAGE,    // 명령 수신: 짧게 두 번
+    LED_PATTERN_STARTUP,    // 부팅 완료: 세 번
+    LED_PATTERN_COUNT
+};
+
+// 높은 우선순위 효과는 실행 중인 낮은 효과를 중단시키고, 같거나 낮으면 대기열에 들어간다
+enum LedPriority {
+    LED_PRIORITY_LOW,
+    LED_PRIORITY_NORMAL,
+    LED_PRIORITY_HIGH
+};
+
+// 효과 한 단계: LED 상태와 유지 시간
+struct LedStep {
+    bool on;
+    uint16_t durationMs;
+};
+
+// esp_timer one-shot으로 구동되는 비차단 LED 효과 엔진
+// trigger()는 대기열에 넣고 필요하면 타이머만 시작하므로 어떤 문맥에서 호출해도 바로 반환된다.
+// 효과가 없을 때는 기본 상태(BLE 연결 여부)를 표시한다.
+class LedEffectEngine {
+private:
+    esp_timer_handle_t stepTimer;
+    portMUX_TYPE lock;
+    
+    // 대기열 (우선순위 순으로 꺼냄, 같은 우선순위는 먼저 들어온 순)
+    uint8_t queue[LED_QUEUE_LENGTH];
+    uint8_t queueCount;
+    
+    // 실행 중인 효과 (-1이면 기본 상태 표시 중)
+    int activePattern;
+    uint8_t activeStep;
+    bool baseLevel;
+    
+    // 통계
+    unsigned long triggerCount;
+    unsigned long coalescedCount;   // 같은 효과가 이미 실행/대기 중이라 합쳐짐
+    unsigned long droppedCount;     // 대기열이 가득 참
+    unsigned long preemptedCount;
+    
+public:
+    LedEffectEngine();
+    ~LedEffectEngine();
+    
+    bool initialize();
+    
+    // 효과 요청 (비차단)
+    bool trigger(LedPatternId pattern);
+    void setBaseLevel(bool on);     // 효과가 끝나면 돌아갈 상태
+    void cancelAll();
+    
+    bool isBusy() const;
+    String getStatusString() const;
+    
+private:
+    static void timerCallback(void* arg);
+    void advance();
+    void startPattern(int pattern);   // lock 안에서 호출
+    int popNext();                    // lock 안에서 호출
+    void applyStep();                 // lock 안에서 호출
+};
+
+#endif // LED_EFFECT_ENGINE_H
\ No newline at end of file
@@ -0,0 +1,249 @@
+#ifndef LOG_CATALOG_H
+#define LOG_CATALOG_H
+
+// 바이너리 로그 카탈로그와 레코드 인코더/디코더
+// 호스트 도구(tools/log_decoder)와 공유하므로 Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+//
+// 펌웨어는 형식 문자열 대신 카탈로그 번호와 인자만 기록하고, 글자로 바꾸는 일은 호스트(또는 "log:text" 모드의 출력 단계)가 한다.
+// 번호는 카탈로그 순서이므로 새 항목은 항상 끝에 추가한다 (중간에 넣으면 이전 캡처를 잘못 해석함).
+//
+// 레코드 (little-endian):
+//   [length u8][id u16][timeUs u32][args int32 x N][textLength u8][text]
+//   length는 레코드 전체 바이트 수, N은 형식 문자열의 %d/%u/%x 개수이고
+//   text는 형식 문자열에 %s가 있을 때만 붙는다 (%s는 하나만 허용).
+// USB 시리얼로는 여러 레코드를 이어 붙여 SERIAL_FRAME_LOG 프레임 하나로 보낸다.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+#define LOG_RECORD_HEADER_SIZE 7
+#define LOG_MAX_ARGS 4
+#define LOG_MAX_TEXT_LENGTH 64         // 이보다 긴 문자열 인자는 잘림
+#define LOG_MAX_RECORD_SIZE (LOG_RECORD_HEADER_SIZE + LOG_MAX_ARGS * 4 + 1 + LOG_MAX_TEXT_LENGTH)
+
+// X(이름, 레벨, 형식 문자열)
+#define LOG_CATALOG(X) \
+    X(LOG_DROPPED,               LOG_LEVEL_WARN,  "log: %u records dropped (buffer full)") \
+    X(LOG_COMMAND_PROCESSING,    LOG_LEVEL_DEBUG, "Processing command: %s") \
+    X(LOG_COMMAND_RESPONSE,      LOG_LEVEL_DEBUG, "%s") /* 사용 안 함 (번호 유지) */ \
+    X(LOG_COMMAND_UNKNOWN_MOVE,  LOG_LEVEL_WARN,  "Unknown movement command: %s") \
+    X(LOG_AUTO_MODE,             LOG_LEVEL_INFO,  "Auto mode: %s") \
+    X(LOG_MOTOR_SET,             LOG_LEVEL_DEBUG, "%s Motor: %d") \
+    X(LOG_MOTOR_INVALID_INDEX,   LOG_LEVEL_WARN,  "Invalid motor index: %d") \
+    X(LOG_MECANUM_SET,           LOG_LEVEL_DEBUG, "Mecanum Motors - FL:%d FR:%d RL:%d RR:%d") \
+    X(LOG_SPEED_SET,             LOG_LEVEL_INFO,  "Speed set to: %d%% (PWM: %d)") \
+    X(LOG_BLE_WRITE,             LOG_LEVEL_DEBUG, "CharacteristicCallbacks::onWrite called") \
+    X(LOG_BLE_WRITE_VALUE,       LOG_LEVEL_DEBUG, "Received value: %s") \
+    X(LOG_BLE_WRITE_EMPTY,       LOG_LEVEL_WARN,  "Warning: Received empty value in onWrite!") \
+    X(LOG_BLE_NO_MANAGER,        LOG_LEVEL_ERROR, "Warning: btManager is null in onWrite!") \
+    X(LOG_BLE_RECEIVED,          LOG_LEVEL_DEBUG, "BLE Received: %s (conn:%u)") \
+    X(LOG_BLE_NO_QUEUE,          LOG_LEVEL_ERROR, "Warning: No command queue set!") \
+    X(LOG_BLE_QUEUE_FULL,        LOG_LEVEL_WARN,  "Warning: Command queue full, command dropped!") \
+    X(LOG_BLE_STREAM_QUEUE_FULL, LOG_LEVEL_WARN,  "Warning: Command queue full, stream command dropped!") \
+    X(LOG_BLE_STREAM_INVALID,    LOG_LEVEL_WARN,  "Warning: Invalid command stream packet!") \
+    X(LOG_DISPLAY_NOT_READY,     LOG_LEVEL_DEBUG, "Display not ready for %s update") \
+    X(LOG_DISPLAY_CONNECTION,    LOG_LEVEL_INFO,  "Updating BLE connection status: %s") \
+    X(LOG_BLE_CLIENTS_LOST,      LOG_LEVEL_INFO,  "Connection lost, clients: %u") \
+    X(LOG_BLE_CLIENTS_NEW,       LOG_LEVEL_INFO,  "New connection established, clients: %u") \
+    X(LOG_BLE_ADV_PHASE,         LOG_LEVEL_INFO,  "Advertising phase: %s") \
+    X(LOG_BLE_ADV_FAILED,        LOG_LEVEL_ERROR, "Failed to start advertising!") \
+    X(LOG_BLE_SEND_NOT_CONNECTED, LOG_LEVEL_WARN, "Cannot send message: Not connected") \
+    X(LOG_BLE_SEND_NO_CHARACTERISTIC, LOG_LEVEL_ERROR, "Cannot send message: Characteristic not initialized") \
+    X(LOG_BLE_SEND,              LOG_LEVEL_DEBUG, "Sending message: %s") \
+    X(LOG_BLE_LINK_PROFILE_SET,  LOG_LEVEL_INFO,  "Link profile set to: %s") \
+    X(LOG_BLE_LINK_PROFILE_APPLY, LOG_LEVEL_INFO, "Applying link profile: %s conn:%u") \
+    X(LOG_BLE_PHY_UNSUPPORTED,   LOG_LEVEL_WARN,  "PHY update not supported") \
+    X(LOG_BLE_DLE_UNSUPPORTED,   LOG_LEVEL_WARN,  "Data length extension not supported") \
+    X(LOG_BLE_BENCH_NO_DRIVER,   LOG_LEVEL_WARN,  "Cannot start benchmark: No driver connected") \
+    X(LOG_BLE_BENCH_START,       LOG_LEVEL_INFO,  "Starting RTT benchmark, probes: %d") \
+    X(LOG_BLE_BENCH_STALE,       LOG_LEVEL_DEBUG, "Ignoring stale RTT echo") \
+    X(LOG_BLE_TABLE_FULL,        LOG_LEVEL_WARN,  "Connection table full, disconnecting") \
+    X(LOG_BLE_CONNECTED,         LOG_LEVEL_INFO,  "BLE device connected, conn:%u (%s)") \
+    X(LOG_BLE_RECONNECTED,       LOG_LEVEL_INFO,  "Driver reconnected in %ums via %s") \
+    X(LOG_BLE_DRIVER_LEFT,       LOG_LEVEL_INFO,  "Driver disconnected, driver slot is free") \
+    X(LOG_BLE_DISCONNECTED,      LOG_LEVEL_INFO,  "BLE device disconnected, conn:%u") \
+    X(LOG_BLE_MTU,               LOG_LEVEL_INFO,  "MTU negotiated: %u conn:%u") \
+    X(LOG_BLE_ROLE_TAKEN,        LOG_LEVEL_INFO,  "Driver role taken by conn:%u") \
+    X(LOG_BLE_ROLE_OCCUPIED,     LOG_LEVEL_INFO,  "Driver role already taken") \
+    X(LOG_BLE_ROLE_RELEASED,     LOG_LEVEL_INFO,  "Driver role released by conn:%u") \
+    X(LOG_BLE_SERVER_EVENT,      LOG_LEVEL_DEBUG, "ServerCallbacks::%s called") \
+    X(LOG_BLE_NULL_MANAGER,      LOG_LEVEL_ERROR, "Warning: btManager is null in %s!") \
+    X(LOG_BLE_SETUP,             LOG_LEVEL_DEBUG, "%s") \
+    X(LOG_BLE_SETUP_FAILED,      LOG_LEVEL_ERROR, "Failed to %s!") \
+    X(LOG_MOTION_INTENT_DROPPED, LOG_LEVEL_WARN,  "Warning: Motion intent queue full, intent %u dropped!") \
+    X(LOG_MOTION_INTENT_LATE,    LOG_LEVEL_WARN,  "Motion intent %u not applied within %u ms")
+    
+enum LogId {
+#define LOG_CATALOG_ID(name, level, format) name,
+    LOG_CATALOG(LOG_CATALOG_ID)
+#undef LOG_CATALOG_ID
+    LOG_ID_COUNT
+};
+
+// 레벨을 이름으로 바로 찾을 수 있는 상수 (LOG_LEVEL_OF_LOG_MECANUM_SET 등, 컴파일 시간 비교용)
+enum LogIdLevel {
+#define LOG_CATALOG_LEVEL(name, level, format) LOG_LEVEL_OF_##name = level,
+    LOG_CATALOG(LOG_CATALOG_LEVEL)
+#undef LOG_CATALOG_LEVEL
+};
+
+namespace LogCatalog {
+
+struct Entry {
+    uint8_t level;
+    const char* name;
+    const char* format;
+};
+
+inline const Entry* find(uint16_t id) {
+    static const Entry entries[] = {
+#define LOG_CATALOG_ENTRY(name, level, format) { level, #name, format },
+        LOG_CATALOG(LOG_CATALOG_ENTRY)
+#undef LOG_CATALOG_ENTRY
+    };
+    return id < LOG_ID_COUNT ? &entries[id] : nullptr;
+}
+
+inline char levelToChar(uint8_t level) {
+    switch (level) {
+        case LOG_LEVEL_ERROR: return 'E';
+        case LOG_LEVEL_WARN: return 'W';
+        case LOG_LEVEL_INFO: return 'I';
+        case LOG_LEVEL_DEBUG: return 'D';
+        default: return '?';
+    }
+}
+
+inline void writeU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)(value >> 8);
+}
+
+inline void writeU32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)((value >> 8) & 0xFF);
+    out[2] = (uint8_t)((value >> 16) & 0xFF);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+inline uint32_t readU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// 레코드 하나를 인코딩하고 길이 반환 (out은 LOG_MAX_RECORD_SIZE 이상, text가 없으면 nullptr)
+inline size_t encodeRecord(uint16_t id, uint32_t timeUs, const int32_t* args, uint8_t argCount,
+                           const char* text, uint8_t* out) {
+    if (argCount > LOG_MAX_ARGS) argCount = LOG_MAX_ARGS;
+    
+    size_t n = LOG_RECORD_HEADER_SIZE;
+    writeU16(out + 1, id);
+    writeU32(out + 3, timeUs);
+    for (uint8_t i = 0; i < argCount; i++) {
+        writeU32(out + n, (uint32_t)args[i]);
+        n += 4;
+    }
+    if (text) {
+        size_t textLength = 0;
+        while (text[textLength] && textLength < LOG_MAX_TEXT_LENGTH) textLength++;
+        out[n++] = (uint8_t)textLength;
+        for (size_t i = 0; i < textLength; i++) {
+            out[n++] = (uint8_t)text[i];
+        }
+    }
+    out[0] = (uint8_t)n;
+    return n;
+}
+
+// 레코드를 형식 문자열대로 글자로 바꿈 (시각/레벨 접두어 없이 본문만, 반환값은 쓴 글자 수)
+// 카탈로그에 없는 번호나 길이가 맞지 않는 레코드는 원시 값으로 표시
+inline size_t formatRecord(const uint8_t* record, size_t length, char* out, size_t outSize) {
+    if (outSize == 0) return 0;
+    out[0] = '\0';
+    if (length < LOG_RECORD_HEADER_SIZE || record[0] != length) return 0;
+    
+    uint16_t id = (uint16_t)(record[1] | (record[2] << 8));
+    const Entry* entry = find(id);
+    if (!entry) {
+        int written = snprintf(out, outSize, "<unknown log id %u, %u bytes>", id, (unsigned)length);
+        return written < 0 ? 0 : ((size_t)written < outSize ? (size_t)written : outSize - 1);
+    }
+    
+    // 정수 인자가 모두 앞에 오고 문자열은 그 뒤에 있음
+    size_t intCount = 0;
+    for (const char* f = entry->format; *f; f++) {
+        if (*f == '%' && f[1] != '\0') {
+            f++;
+            if (*f != '%' && *f != 's') intCount++;
+        }
+    }
+    const uint8_t* cursor = record + LOG_RECORD_HEADER_SIZE;
+    const uint8_t* end = record + length;
+    const uint8_t* textCursor = cursor + intCount * 4;
+    size_t n = 0;
+    for (const char* f = entry->format; *f && n + 1 < outSize; f++) {
+        if (*f != '%' || f[1] == '\0') {
+            out[n++] = *f;
+            continue;
+        }
+        
+        char spec = *++f;
+        char piece[LOG_MAX_TEXT_LENGTH + 1];
+        piece[0] = '\0';
+        if (spec == '%') {
+            piece[0] = '%';
+            piece[1] = '\0';
+        } else if (spec == 's') {
+            size_t textLength = textCursor < end ? *textCursor++ : 0;
+            if (textLength > (size_t)(end - textCursor)) textLength = end - textCursor;
+            if (textLength > LOG_MAX_TEXT_LENGTH) textLength = LOG_MAX_TEXT_LENGTH;
+            for (size_t i = 0; i < textLength; i++) {
+                piece[i] = (char)textCursor[i];
+            }
+            piece[textLength] = '\0';
+            textCursor = end;   // %s는 하나만
+        } else if (cursor + 4 <= end) {
+            uint32_t value = readU32(cursor);
+            cursor += 4;
+            if (spec == 'u') {
+                snprintf(piece, sizeof(piece), "%lu", (unsigned long)value);
+            } else if (spec == 'x') {
+                snprintf(piece, sizeof(piece), "%lx", (unsigned long)value);
+            } else {
+                snprintf(piece, sizeof(piece), "%ld", (long)(int32_t)value);
+            }
+        } else {
+            snprintf(piece, sizeof(piece), "<missing>");
+        }
+        
+        for (const char* p = piece; *p && n + 1 < outSize; p++) {
+            out[n++] = *p;
+        }
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// 시각/레벨 접두어를 붙인 한 줄 (예: "[12.345678] D Mecanum Motors - FL:4095 FR:4095 RL:4095 RR:4095")
+inline size_t formatLine(const uint8_t* record, size_t length, char* out, size_t outSize) {
+    if (outSize == 0) return 0;
+    out[0] = '\0';
+    if (length < LOG_RECORD_HEADER_SIZE) return 0;
+    
+    uint32_t timeUs = readU32(record + 3);
+    const Entry* entry = find((uint16_t)(record[1] | (record[2] << 8)));
+    int prefix = snprintf(out, outSize, "[%lu.%06lu] %c ", (unsigned long)(timeUs / 1000000),
+                          (unsigned long)(timeUs % 1000000), levelToChar(entry ? entry->level : LOG_LEVEL_NONE));
+    if (prefix < 0 || (size_t)prefix >= outSize) return 0;
+    return prefix + formatRecord(record, length, out + prefix, outSize - prefix);
+}
+
+} // namespace LogCatalog
+
+#endif // LOG_CATALOG_H
\ No newline at end of file
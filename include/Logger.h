@@ -0,0 +1,67 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "config.h"
+#include "LogCatalog.h"
+
+// 로그 기록 매크로
+// 카탈로그 레벨이 LOG_COMPILE_LEVEL보다 자세한 로그는 상수 조건으로 빠져 인자 계산까지 사라진다.
+//   LOG(LOG_MECANUM_SET, fl, fr, rl, rr);
+//   LOG_TEXT(LOG_COMMAND_PROCESSING, cmd.c_str());     // 형식 문자열에 %s가 있는 항목
+#define LOG(id, ...) \
+    do { if (LOG_LEVEL_OF_##id <= LOG_COMPILE_LEVEL) Logger::record(id, ##__VA_ARGS__); } while (0)
+#define LOG_TEXT(id, text, ...) \
+    do { if (LOG_LEVEL_OF_##id <= LOG_COMPILE_LEVEL) Logger::recordText(id, text, ##__VA_ARGS__); } while (0)
+    
+// 지연 바이너리 로그
+// 기록하는 쪽은 카탈로그 번호, 시각, 인자만 링 버퍼에 복사하고 바로 돌아간다 (글자 변환/시리얼 전송 없음).
+// loop()가 drain()으로 모아 SERIAL_FRAME_LOG 프레임으로 보내며, 호스트의 tools/log_decoder가 글자로 되돌린다.
+// ESP32-C3에는 원자적 read-modify-write 명령이 없으므로 여러 태스크의 기록은 레코드 복사 동안만 임계 구역으로 직렬화한다.
+class Logger {
+private:
+    static uint8_t buffer[LOG_BUFFER_SIZE];
+    static volatile uint32_t head;      // 기록 위치 (계속 증가, 마스크로 인덱스)
+    static volatile uint32_t tail;      // 출력 위치 (drain만 증가)
+    static portMUX_TYPE lock;
+    
+    static bool textOutput;
+    static uint16_t frameSequence;
+    
+    // 통계
+    static unsigned long writtenCount;
+    static volatile unsigned long droppedCount;
+    static unsigned long reportedDropCount;
+    static unsigned long framesSent;
+    static uint32_t peakUsage;
+    
+public:
+    template<typename... Args>
+    static void record(LogId id, Args... args) {
+        const int32_t values[] = { 0, static_cast<int32_t>(args)... };
+        write(id, values + 1, sizeof...(Args), nullptr);
+    }
+    
+    template<typename... Args>
+    static void recordText(LogId id, const char* text, Args... args) {
+        const int32_t values[] = { 0, static_cast<int32_t>(args)... };
+        write(id, values + 1, sizeof...(Args), text ? text : "");
+    }
+    
+    static void write(LogId id, const int32_t* args, uint8_t argCount, const char* text);
+    
+    // loop()에서 호출: TX 버퍼에 자리가 있는 만큼만 보내고 바로 반환
+    static void drain();
+    
+    static void setTextOutput(bool enabled);   // true면 drain()에서 글자로 바꿔 출력 (시리얼 모니터용)
+    static bool isTextOutput();
+    static void resetStats();
+    static String getStatusString();
+    
+private:
+    static uint32_t usage();
+    static size_t peekRecord(uint32_t position, uint8_t* out);
+    static bool drainBinary();
+    static bool drainText();
+};
+
+#endif // LOGGER_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+// 보낸 응답/텔레메트리를 그대로 보관했다가 돌려주는 전송 (호스트 테스트용)
+// tools/telemetry_decoder --loopback에서 BLE 링크 대신 사용한다.
+
+#include <string.h>
+#include "CommandTransport.h"
+
+#define LOOPBACK_PACKET_COUNT 128
+#define LOOPBACK_PACKET_SIZE  256
+
+#define LOOPBACK_RESPONSE  0
+#define LOOPBACK_TELEMETRY 1
+
+class LoopbackTransport : public CommandTransport {
+private:
+    struct Packet {
+        uint8_t kind;
+        uint16_t length;
+        uint8_t data[LOOPBACK_PACKET_SIZE];
+    };
+    
+    Packet packets[LOOPBACK_PACKET_COUNT];
+    size_t head;
+    size_t tail;
+    size_t maxPayload;
+    uint16_t lastAppliedSequence;
+    bool active;
+    
+    bool push(uint8_t kind, const uint8_t* data, size_t length) {
+        size_t next = (head + 1) % LOOPBACK_PACKET_COUNT;
+        if (next == tail || length > LOOPBACK_PACKET_SIZE) return false;
+        packets[head].kind = kind;
+        packets[head].length = (uint16_t)length;
+        memcpy(packets[head].data, data, length);
+        head = next;
+        return true;
+    }
+    
+public:
+    // mtu: 흉내낼 링크의 ATT MTU (알림 페이로드 = mtu - 3)
+    explicit LoopbackTransport(size_t mtu = 247)
+        : head(0), tail(0), maxPayload(mtu > 3 ? mtu - 3 : 0), lastAppliedSequence(COMMAND_SEQUENCE_NONE), active(true) {}
+        
+    const char* getName() const override { return "loopback"; }
+    bool isActive() const override { return active; }
+    void setActive(bool value) { active = value; }
+    
+    bool sendResponse(const char* text, size_t length) override {
+        return push(LOOPBACK_RESPONSE, (const uint8_t*)text, length);
+    }
+    
+    bool sendTelemetry(const uint8_t* data, size_t length) override {
+        if (length > maxPayload) return false;
+        return push(LOOPBACK_TELEMETRY, data, length);
+    }
+    
+    size_t getMaxPayload() const override { return maxPayload; }
+    
+    uint16_t getLastAppliedSequence() const override { return lastAppliedSequence; }
+    void acknowledgeSequence(uint16_t sequence) override { lastAppliedSequence = sequence; }
+    
+    // 보낸 순서대로 하나씩 꺼냄 (out은 LOOPBACK_PACKET_SIZE 이상)
+    bool receive(uint8_t* kind, uint8_t* out, size_t* length) {
+        if (tail == head) return false;
+        *kind = packets[tail].kind;
+        *length = packets[tail].length;
+        memcpy(out, packets[tail].data, packets[tail].length);
+        tail = (tail + 1) % LOOPBACK_PACKET_COUNT;
+        return true;
+    }
+};
+
+#endif // LOOPBACK_TRANSPORT_H
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef MACRO_MANAGER_H
+#define MACRO_MANAGER_H
+
+#include <Preferences.h>
+#include "config.h"
+
+// 전방 선언
+class MotorController;
+
+// 매크로 한 단계: 차체 속도 설정값(-100~100%)과 유지 시간
+struct MacroStep {
+    int8_t vx;          // 전진(+) / 후진(-)
+    int8_t vy;          // 좌(+) / 우(-)
+    int8_t omega;       // 좌회전(+) / 우회전(-)
+    uint16_t durationMs;
+};
+
+struct Macro {
+    bool used;
+    char name[MACRO_NAME_MAX_LENGTH + 1];
+    uint8_t stepCount;
+    MacroStep steps[MACRO_MAX_STEPS];
+};
+
+// NVS에 저장되는 모션 매크로
+// 부팅 시 RAM 테이블로 읽어 두고, 실행은 제어 틱에서 무선 통신 없이 진행한다.
+// 정의/삭제는 RAM 테이블에 바로 반영하고, NVS 쓰기는 UI 루프의 commitStorage()에서 통신 태스크 밖에서 한다
+// (플래시 지우기 수십 ms 동안 명령 처리가 멈추지 않도록).
+// NVS 레코드: [stepCount u8][nameLength u8][name][vx i8, vy i8, omega i8, durationMs u16le] * stepCount
+class MacroManager {
+private:
+    MotorController* motorController;
+    Preferences preferences;
+    Macro macros[MACRO_MAX_COUNT];
+    portMUX_TYPE storageLock;   // macros[]와 dirtyMask (UI 루프가 복사해 가는 동안 보호)
+    uint8_t dirtyMask;          // NVS에 반영할 슬롯 (비트 = 인덱스)
+    
+    // 실행 상태 (제어 태스크에서만 변경)
+    // 실행 중인 매크로는 시작할 때 복사해 두므로 통신 태스크가 정의/삭제해도 끝까지 그대로 진행
+    Macro activeMacro;
+    volatile int activeIndex;  // -1이면 실행 중 아님
+    uint8_t activeStep;
+    uint32_t stepStartUs;
+    unsigned long runCount;
+    
+public:
+    MacroManager();
+    ~MacroManager();
+    
+    // 초기화 (NVS에서 매크로 로드)
+    bool initialize();
+    void setMotorController(MotorController* controller);
+    
+    // 정의/삭제 (RAM 테이블은 즉시, NVS는 commitStorage()에서)
+    int defineMacro(const String& name, const MacroStep* steps, uint8_t stepCount);
+    bool deleteMacro(const String& name);
+    void commitStorage();  // UI 루프에서 호출
+    int findMacro(const String& name) const;
+    
+    // 실행
+    bool startMacro(int index, uint32_t nowUs);
+    void stopMacro();   // 실행 중단 후 정지
+    void cancel();      // 수동 명령이 들어오면 모터 출력은 그대로 두고 실행만 중단
+    bool isRunning() const;
+    bool update(uint32_t nowUs);  // 제어 틱에서 호출, 출력이 바뀌면 true
+    
+    // 조회
+    bool isDefined(int index) const;
+    uint8_t getCount() const;
+    String getMacroString(int index) const;
+    String getStatusString() const;
+    
+private:
+    void loadMacros();
+    bool saveMacro(int index, const Macro& macro);
+    void applyStep(const MacroStep& step);
+    static void makeKey(int index, char* key);
+};
+
+#endif // MACRO_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef MOTION_INTENT_H
+#define MOTION_INTENT_H
+
+#include "CommandCodec.h"
+
+// 통신 태스크/loop()가 해석을 끝내고 제어 태스크에 넘기는 동작 의도
+// 모터 출력, 매크로/keepalive 상태 변경은 모두 제어 태스크에서 이 값을 적용할 때만 일어난다.
+enum MotionIntentType {
+    MOTION_INTENT_BATCH,            // 속도/방향/차체 속도/매크로 (batch)
+    MOTION_INTENT_MACRO_STOP,       // 실행 중인 매크로 중단 후 정지
+    MOTION_INTENT_KEEPALIVE_ON,     // value0: 주기(ms), value1: 누락 허용 횟수 (범위 검사 완료)
+    MOTION_INTENT_KEEPALIVE_OFF,
+    MOTION_INTENT_OUTPUT_MODE,      // value0: 1이면 비동기 출력
+    MOTION_INTENT_PWM_FREQUENCY,    // pwm_freq 파라미터 반영
+    MOTION_INTENT_BENCHMARK,        // value0: 프레임 수 (제어 틱마다 한 프레임씩 진행)
+    MOTION_INTENT_RESYNC_BEGIN,     // I2C 복구 후 PCA9685 모드/주파수 재설정
+    MOTION_INTENT_RESYNC_FINISH     // 발진기 안정화 후 정지 프레임 (매크로/설정값 스트림 해제)
+};
+
+struct MotionIntent {
+    uint8_t type;          // MotionIntentType
+    MotionBatch batch;
+    int32_t value0;
+    int32_t value1;
+    uint32_t receivedUs;   // 통신 태스크가 받은 시각 (keepalive 설정값 간격 계산용)
+    uint32_t ticket;       // ControlLoop::submit()이 채움
+};
+
+#endif // MOTION_INTENT_H
\ No newline at end of file
@@ -3,13 +3,45 @@
 
 #include <Adafruit_PWMServoDriver.h>
 #include "config.h"
+#include "I2cWorker.h"
+#include "LatencyHistogram.h"
+
+// I2C 벤치마크 진행 단계
+enum BenchmarkPhase {
+    BENCHMARK_IDLE,
+    BENCHMARK_SYNC,     // 동기 쓰기 (틱마다 한 프레임)
+    BENCHMARK_ASYNC,    // 비동기 제출 후 완료 확인 (틱마다 확인, 기다리지 않음)
+    BENCHMARK_DONE
+};
 
 class MotorController {
 private:
     Adafruit_PWMServoDriver* pwm;
+    I2cBusScheduler* i2cBus;
+    I2cWorker* outputWorker;
+    bool asyncOutput;
+    uint16_t frameChannels[MOTOR_CHANNEL_COUNT];  // 채널별 OFF 값 (ON은 항상 0)
     int currentSpeed;
     Direction currentDirection;
     bool isRunning;
+    int wheelDuty[4];  // 마지막으로 출력한 바퀴별 부호 있는 PWM (FL, FR, RL, RR)
+    uint16_t appliedPwmFrequency;
+    
+    // 마지막 출력 프레임의 I2C 쓰기 구간 (사이클 카운터)
+    uint32_t outputFrameCount;
+    uint32_t lastOutputStartCycles;
+    uint32_t lastOutputEndCycles;
+    
+    // 벤치마크 (제어 태스크에서만 진행, 요청한 태스크는 끝난 뒤 결과만 읽음)
+    volatile BenchmarkPhase benchmarkPhase;
+    int benchmarkFrames;
+    int benchmarkIndex;
+    bool benchmarkPending;      // 완료를 기다리는 비동기 프레임이 있음
+    uint32_t benchmarkTag;
+    uint32_t benchmarkStartUs;
+    LatencyHistogram benchmarkSyncHistogram;
+    LatencyHistogram benchmarkAsyncHistogram;
+    LatencyHistogram benchmarkDoneHistogram;
     
 public:
     MotorController();
@@ -17,6 +49,24 @@ public:
     
     // 초기화
     bool initialize();
+    void applyPwmFrequency();  // pwm_freq 파라미터가 바뀌었으면 다시 설정
+    
+    // 버스 복구 후 재동기화: 두 단계 사이에 발진기 안정화(PCA9685_WAKE_US)를 기다림
+    void beginResync();        // MODE1/PRESCALE 재설정 (지연 없이 레지스터 직접 쓰기)
+    void resyncOutput();       // 정지 프레임 출력
+    void setI2cBusScheduler(I2cBusScheduler* scheduler);
+    void setI2cWorker(I2cWorker* worker);
+    
+    // 출력 방식: 비동기면 프레임을 워커에 넘기고 바로 반환
+    void setAsyncOutput(bool enabled);
+    bool isAsyncOutput() const;
+    
+    // 현재 프레임을 동기/비동기로 반복 출력해 호출 측 점유 시간 비교 (출력 값은 바뀌지 않음)
+    // 제어 틱마다 updateBenchmark()로 한 프레임씩 진행하므로 제어 루프를 멈추지 않는다
+    bool startBenchmark(int frames);
+    void updateBenchmark(uint32_t nowUs);
+    bool isBenchmarkRunning() const;
+    String getBenchmarkResult() const;
     
     // 개별 모터 제어
     void setMotor(MotorIndex motorIndex, int speed);
@@ -35,6 +85,9 @@ public:
     void moveDiagonalFR();
     void stop();
     
+    // 차체 속도 지정 (각 -100~100%, 메카넘 역기구학)
+    void setBodyVelocity(int vx, int vy, int omega);
+    
     // 속도 관리
     void setSpeed(int speed);  // 0-100%
     int getSpeed() const;
@@ -42,10 +95,33 @@ public:
     // 상태 확인
     Direction getCurrentDirection() const;
     bool isMotorRunning() const;
+    int getWheelDuty(MotorIndex motorIndex) const;
+    
+    // 지연 계측용 출력 프레임 정보 (비동기 출력이면 종료 시각은 워커에 넘긴 시각)
+    uint32_t getOutputFrameCount() const;
+    uint32_t getLastOutputStartCycles() const;
+    uint32_t getLastOutputEndCycles() const;
     
     // 방향을 문자열로 변환
     String directionToString(Direction dir) const;
     Direction stringToDirection(const String& dirStr) const;
+    
+private:
+    // PCA9685 쓰기 구간을 모터 우선순위 트랜잭션으로 감쌈
+    void acquireBus();
+    void releaseBus();
+    
+    // 라이브러리의 delay() 없이 레지스터 직접 쓰기 (버스 잠금 안에서 호출)
+    bool writeRegister(uint8_t reg, uint8_t value);
+    void writePrescale(uint16_t frequency);  // 슬립 → PRESCALE → 깨우기
+    
+    // frameChannels 출력 (동기/비동기 모두 자동 증가 연속 쓰기 한 번)
+    size_t buildFrame(uint8_t* data, int firstChannel, int count) const;
+    void writeFrame();
+    void writeFrameSync();
+    void writeChannelsSync(int firstChannel, int count);
+    void submitFrame(I2cCompletion onComplete, void* context);
+    static void onBenchmarkComplete(void* context, bool success);
 };
 
 #endif // MOTOR_CONTROLLER_H
\ No newline at end of file
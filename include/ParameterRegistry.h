@@ -0,0 +1,121 @@
+#ifndef PARAMETER_REGISTRY_H
+#define PARAMETER_REGISTRY_H
+
+#include <Preferences.h>
+#include "config.h"
+
+// 바이너리 파라미터 명령 (텍스트 명령은 ASCII, 모션 배치는 0x80으로 구분)
+//
+// 요청: [PARAM_BINARY_MARKER u8][op u8][인자]
+//   PARAM_OP_GET    [count u8][id u8]*count          count 0이면 전체
+//   PARAM_OP_SET    [count u8]([id u8][value i32le])*count   전부 검증한 뒤 한 번에 적용
+//   PARAM_OP_SAVE                                    현재 값을 NVS에 저장 (값을 복사해 두고 UI 루프에서 기록)
+//   PARAM_OP_RESET                                   기본값으로 되돌림 (저장은 SAVE로)
+// 응답: [PARAM_BINARY_MARKER][op][status u8][count u8]([id u8][type u8][value i32le])*count
+//   응답이 전송 경로의 최대 크기를 넘으면 같은 형식으로 나누어 보낸다.
+#define PARAM_BINARY_MARKER  0x81
+
+#define PARAM_OP_GET         0x01
+#define PARAM_OP_SET         0x02
+#define PARAM_OP_SAVE        0x03
+#define PARAM_OP_RESET       0x04
+
+#define PARAM_RESPONSE_HEADER_SIZE 4
+#define PARAM_RECORD_SIZE    6
+
+enum ParameterStatus {
+    PARAM_STATUS_OK = 0,
+    PARAM_STATUS_INVALID = 1,       // 잘못된 요청 형식
+    PARAM_STATUS_UNKNOWN_ID = 2,
+    PARAM_STATUS_OUT_OF_RANGE = 3,
+    PARAM_STATUS_STORAGE = 4        // NVS 오류
+};
+
+enum ParameterType {
+    PARAM_TYPE_U8 = 0,
+    PARAM_TYPE_U16 = 1,
+    PARAM_TYPE_U32 = 2,
+    PARAM_TYPE_I32 = 3
+};
+
+// 파라미터 ID (전송/NVS 키에 쓰이므로 값을 바꾸지 말고 추가만 할 것)
+enum ParameterId {
+    PARAM_MAX_SPEED = 1,
+    PARAM_PWM_FREQUENCY = 2,
+    PARAM_ENCODER_PRINT_MS = 3,
+    PARAM_TELEMETRY_BATCH_MS = 4,
+    PARAM_KEEPALIVE_RAMP_MS = 5
+};
+
+// 런타임 파라미터 값 (핫 패스에서는 필드를 직접 읽음)
+struct RobotParameters {
+    uint8_t maxSpeed;           // 모든 이동 명령의 최대 출력 (%)
+    uint16_t pwmFrequency;      // PCA9685 PWM 주파수 (Hz)
+    uint32_t encoderPrintMs;    // 인코더 정보 출력 주기
+    uint16_t telemetryBatchMs;  // 텔레메트리 프레임 최대 대기 시간
+    uint16_t keepaliveRampMs;   // 데드맨 감속 시간
+};
+
+// 파라미터 정의 (컴파일 타임 테이블)
+struct ParameterInfo {
+    uint8_t id;
+    const char* name;
+    ParameterType type;
+    uint16_t offset;            // RobotParameters 내 위치
+    int32_t minValue;
+    int32_t maxValue;
+    int32_t defaultValue;
+};
+
+// 타입이 있는 파라미터 레지스트리
+// 값은 정적 구조체에 보관하므로 values().maxSpeed 처럼 읽기 비용은 필드 접근과 같다.
+// 쓰기는 통신 태스크의 명령 처리 경로에서만 일어나며 각 필드는 32비트 이하라 읽는 쪽에서 잠금이 필요 없다.
+class ParameterRegistry {
+private:
+    static RobotParameters current;
+    Preferences preferences;
+    bool storageReady;
+    
+    // 저장 요청 시점의 값 (NVS 쓰기는 통신 태스크 밖의 commitStorage()에서)
+    RobotParameters pendingSave;
+    volatile bool savePending;
+    portMUX_TYPE saveLock;
+    
+public:
+    ParameterRegistry();
+    ~ParameterRegistry();
+    
+    // 초기화 (NVS에 저장된 값 적용)
+    bool initialize();
+    
+    // 핫 패스 읽기
+    static const RobotParameters& values() { return current; }
+    
+    // 테이블 조회
+    static uint8_t getCount();
+    static const ParameterInfo* getInfo(uint8_t index);
+    static const ParameterInfo* findById(uint8_t id);
+    static const ParameterInfo* findByName(const String& name);
+    
+    // 값 읽기/쓰기 (범위 밖이면 거부)
+    int32_t get(const ParameterInfo& info) const;
+    ParameterStatus set(const ParameterInfo& info, int32_t value);
+    void resetToDefaults();
+    bool save();           // 현재 값으로 저장 예약 (저장소를 열지 못했으면 false)
+    void commitStorage();  // UI 루프에서 호출
+    
+    // 바이너리 요청 처리, 응답 길이 반환 (응답 버퍼는 PARAM_RESPONSE_HEADER_SIZE + 전체 레코드 크기 이상)
+    size_t handleBinary(const uint8_t* request, size_t length, uint8_t* response, size_t capacity);
+    
+    // 텍스트: "param:max_speed=80 (0-100)"
+    String getParameterString(const ParameterInfo& info) const;
+    
+private:
+    void load();
+    static int32_t readField(const RobotParameters& values, const ParameterInfo& info);
+    size_t writeRecord(const ParameterInfo& info, uint8_t* out) const;
+    static int32_t readInt32(const uint8_t* in);
+    static void makeKey(uint8_t id, char* key);
+};
+
+#endif // PARAMETER_REGISTRY_H
\ No newline at end of file
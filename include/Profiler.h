@@ -0,0 +1,71 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+#include "LatencyHistogram.h"
+
+// 프로파일 지점 X(번호, 출력 이름)
+#define PROFILE_PROBES(X) \
+    X(PROFILE_ENCODER_ISR,       "encoder_isr") \
+    X(PROFILE_PROCESS_COMMAND,   "process_cmd") \
+    X(PROFILE_MECANUM_SET,       "mecanum_set") \
+    X(PROFILE_DISPLAY_UPDATE,    "display_update") \
+    X(PROFILE_DISPLAY_FLUSH,     "display_flush") \
+    X(PROFILE_BLE_WRITE,         "ble_write") \
+    X(PROFILE_BLE_STREAM_WRITE,  "ble_stream")
+    
+enum ProfileProbe {
+#define PROFILE_PROBE_ID(id, name) id,
+    PROFILE_PROBES(PROFILE_PROBE_ID)
+#undef PROFILE_PROBE_ID
+    PROFILE_PROBE_COUNT
+};
+
+// 구간 계측: 블록 시작에 PROFILE_SCOPE(PROFILE_xxx); 를 두면 블록을 나갈 때까지의 CPU 사이클을 기록한다.
+// PROFILER_ENABLED가 0이면 아무 코드도 남지 않는다 (Profiler 클래스와 히스토그램도 빌드에서 빠짐).
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(probe) ProfileScope profileScope_(probe)
+#else
+#define PROFILE_SCOPE(probe) do {} while (0)
+#endif
+
+#if PROFILER_ENABLED
+
+// 사이클 단위 핫패스 프로파일러
+// 지점마다 log2 버킷 히스토그램(LatencyHistogram, 정적 메모리)에 사이클 수를 누적한다.
+// ISR과 태스크가 모두 기록하므로 기록은 짧은 임계 구역에서 한다 (Arduino GPIO ISR은 IRAM 전용으로 등록되지 않아 플래시 코드 호출 가능).
+class Profiler {
+private:
+    static LatencyHistogram histograms[PROFILE_PROBE_COUNT];
+    static portMUX_TYPE lock;
+    
+public:
+    static void record(ProfileProbe probe, uint32_t cycles);
+    static void reset();
+    
+    // "encoder_isr n:1200 min:190 p50:255 p99:511 max:806cyc (p50:1 p99:3 max:5us)" 형식
+    static String getProbeString(ProfileProbe probe);
+    
+private:
+    static const char* probeToString(ProfileProbe probe);
+};
+
+// 생성 시각부터 소멸 시각까지의 사이클 수를 기록 (ISR에서도 인라인으로 펼쳐지도록 강제)
+class ProfileScope {
+private:
+    ProfileProbe probe;
+    uint32_t startCycles;
+    
+public:
+    __attribute__((always_inline)) inline explicit ProfileScope(ProfileProbe probe)
+        : probe(probe), startCycles(ESP.getCycleCount()) {
+    }
+    
+    __attribute__((always_inline)) inline ~ProfileScope() {
+        Profiler::record(probe, ESP.getCycleCount() - startCycles);
+    }
+};
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
\ No newline at end of file
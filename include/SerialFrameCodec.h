@@ -0,0 +1,138 @@
+#ifndef SERIAL_FRAME_CODEC_H
+#define SERIAL_FRAME_CODEC_H
+
+// USB 시리얼용 바이너리 프레임 인코더/디코더 (COBS + CRC16)
+// 호스트 도구와 공유할 수 있도록 Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+//
+// 전송 형태: 0x00 [COBS(프레임)] 0x00
+//   프레임 앞뒤에 구분자를 두므로 같은 포트로 나가는 디버그 텍스트와 섞여도
+//   호스트는 0x00 단위로 잘라 CRC가 맞는 것만 받아들이면 된다.
+// 프레임 (little-endian):
+//   [type u8][sequence u16][clientTime u32][payload][crc16 u16]
+//   crc16 = CRC-16/CCITT-FALSE (type ~ payload)
+// 로봇 → 호스트 프레임의 sequence는 누적 ACK(마지막으로 적용된 명령 시퀀스, 없으면 0xFFFF), clientTime은 로봇 micros()이다.
+// payload는 BLE 경로와 동일하다: 명령은 텍스트 또는 CommandCodec 바이너리, 텔레메트리는 TelemetryCodec 프레임.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SERIAL_FRAME_COMMAND      0x01  // 호스트 → 로봇: 명령
+#define SERIAL_FRAME_RESPONSE     0x02  // 로봇 → 호스트: 텍스트 응답
+#define SERIAL_FRAME_TELEMETRY    0x03  // 로봇 → 호스트: 텔레메트리 프레임
+#define SERIAL_FRAME_LOG          0x04  // 로봇 → 호스트: 바이너리 로그 레코드 묶음 (LogCatalog), sequence는 로그 프레임 번호
+
+#define SERIAL_FRAME_HEADER_SIZE  7
+#define SERIAL_FRAME_CRC_SIZE     2
+#define SERIAL_FRAME_MAX_PAYLOAD  248
+#define SERIAL_FRAME_MAX_DECODED  (SERIAL_FRAME_HEADER_SIZE + SERIAL_FRAME_MAX_PAYLOAD + SERIAL_FRAME_CRC_SIZE)
+#define SERIAL_FRAME_MAX_ENCODED  (SERIAL_FRAME_MAX_DECODED + SERIAL_FRAME_MAX_DECODED / 254 + 1 + 2)
+
+struct SerialFrame {
+    uint8_t type;
+    uint16_t sequence;
+    uint32_t clientTime;
+    const uint8_t* payload;  // 디코딩 버퍼 안을 가리킴
+    size_t length;
+};
+
+namespace SerialFrameCodec {
+
+inline uint16_t crc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// out은 len + len / 254 + 1 이상
+inline size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t n = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = n++;
+            code = 1;
+        } else {
+            out[n++] = in[i];
+            if (++code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = n++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIndex] = code;
+    return n;
+}
+
+// 성공 시 디코딩된 길이, 실패 시 0 반환 (out은 len 이상)
+inline size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t n = 0;
+    size_t i = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) return 0;
+        for (uint8_t j = 1; j < code; j++) {
+            out[n++] = in[i++];
+        }
+        if (code != 0xFF && i < len) {
+            out[n++] = 0;
+        }
+    }
+    return n;
+}
+
+// 구분자를 포함한 전송 바이트 수 반환 (실패 시 0, out은 SERIAL_FRAME_MAX_ENCODED 이상)
+inline size_t encodeFrame(uint8_t type, uint16_t sequence, uint32_t clientTime,
+                          const uint8_t* payload, size_t length, uint8_t* out) {
+    if (length > SERIAL_FRAME_MAX_PAYLOAD) return 0;
+    
+    uint8_t raw[SERIAL_FRAME_MAX_DECODED];
+    raw[0] = type;
+    raw[1] = (uint8_t)(sequence & 0xFF);
+    raw[2] = (uint8_t)(sequence >> 8);
+    raw[3] = (uint8_t)(clientTime & 0xFF);
+    raw[4] = (uint8_t)((clientTime >> 8) & 0xFF);
+    raw[5] = (uint8_t)((clientTime >> 16) & 0xFF);
+    raw[6] = (uint8_t)(clientTime >> 24);
+    for (size_t i = 0; i < length; i++) {
+        raw[SERIAL_FRAME_HEADER_SIZE + i] = payload[i];
+    }
+    size_t rawLength = SERIAL_FRAME_HEADER_SIZE + length;
+    uint16_t crc = crc16(raw, rawLength);
+    raw[rawLength++] = (uint8_t)(crc & 0xFF);
+    raw[rawLength++] = (uint8_t)(crc >> 8);
+    
+    out[0] = 0;
+    size_t n = 1 + cobsEncode(raw, rawLength, out + 1);
+    out[n++] = 0;
+    return n;
+}
+
+// 구분자를 뺀 COBS 바이트열을 디코딩 (scratch는 len 이상, frame.payload는 scratch를 가리킴)
+inline bool decodeFrame(const uint8_t* in, size_t len, uint8_t* scratch, SerialFrame& frame) {
+    size_t rawLength = cobsDecode(in, len, scratch);
+    if (rawLength < SERIAL_FRAME_HEADER_SIZE + SERIAL_FRAME_CRC_SIZE) return false;
+    
+    size_t bodyLength = rawLength - SERIAL_FRAME_CRC_SIZE;
+    uint16_t crc = (uint16_t)(scratch[bodyLength] | (scratch[bodyLength + 1] << 8));
+    if (crc != crc16(scratch, bodyLength)) return false;
+    
+    frame.type = scratch[0];
+    frame.sequence = (uint16_t)(scratch[1] | (scratch[2] << 8));
+    frame.clientTime = (uint32_t)scratch[3] | ((uint32_t)scratch[4] << 8) |
+                       ((uint32_t)scratch[5] << 16) | ((uint32_t)scratch[6] << 24);
+    frame.payload = scratch + SERIAL_FRAME_HEADER_SIZE;
+    frame.length = bodyLength - SERIAL_FRAME_HEADER_SIZE;
+    return true;
+}
+
+} // namespace SerialFrameCodec
+
+#endif // SERIAL_FRAME_CODEC_H
\ No newline at end of file
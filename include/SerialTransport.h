@@ -0,0 +1,65 @@
+#ifndef SERIAL_TRANSPORT_H
+#define SERIAL_TRANSPORT_H
+
+#include "config.h"
+#include "CommandQueue.h"
+#include "SerialFrameCodec.h"
+#include "CommandTransport.h"
+
+// USB-CDC 시리얼 명령 전송
+// 0x00으로 시작하는 바이트열은 COBS 프레임(SerialFrameCodec), 그 외는 기존과 같은 줄 단위 텍스트 명령으로 처리한다.
+// 수신은 통신 태스크에서 비차단으로 처리하고, 명령은 BLE와 같은 CommandQueue로 넘긴다.
+class SerialTransport : public CommandTransport {
+private:
+    CommandQueue* commandQueue;
+    
+    // 수신 상태
+    bool inFrame;
+    uint8_t frameBuffer[SERIAL_FRAME_MAX_ENCODED];
+    size_t frameLength;
+    uint32_t frameStartCycles;
+    char lineBuffer[COMMAND_MAX_LENGTH + 1];
+    size_t lineLength;
+    uint32_t lineStartCycles;
+    
+    // 프레임 링크 상태 (유효한 프레임을 받은 뒤에만 응답/텔레메트리 프레임 전송)
+    unsigned long lastFrameTime;
+    bool linkActive;
+    volatile uint16_t lastAppliedSequence;
+    
+    // 통계
+    unsigned long framesReceived;
+    unsigned long framesSent;
+    unsigned long badFrames;
+    unsigned long txDropped;
+    
+public:
+    SerialTransport();
+    ~SerialTransport();
+    
+    // 초기화 및 의존성 주입 (Serial.begin 이후 호출)
+    bool initialize();
+    void setCommandQueue(CommandQueue* queue);
+    
+    // CommandTransport
+    // update(): 통신 태스크에서 호출, 도착한 바이트만 처리하고 바로 반환
+    // 송신은 TX 버퍼에 자리가 없으면 기다리지 않고 버림
+    const char* getName() const override;
+    bool isActive() const override;
+    void update() override;
+    bool sendResponse(const char* text, size_t length) override;
+    bool sendTextResponse(const char* text, size_t length) override;
+    bool sendTelemetry(const uint8_t* data, size_t length) override;
+    size_t getMaxPayload() const override;
+    uint16_t getLastAppliedSequence() const override;
+    void acknowledgeSequence(uint16_t sequence) override;
+    
+    String getStatusString() const;
+    
+private:
+    void handleFrame(uint32_t rxCycles);
+    void handleTextByte(char c);
+    bool sendFrame(uint8_t type, uint16_t sequence, const uint8_t* payload, size_t length);
+};
+
+#endif // SERIAL_TRANSPORT_H
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include "config.h"
+
+// 태스크별 스택 여유와 CPU 사용률 집계
+// 우리 태스크는 깨어나 일한 시간을 addBusyTime()으로 직접 보고하고 (Arduino 코어는 FreeRTOS 실행 시간 통계를 끄고 빌드됨),
+// 라이브러리 태스크(esp_timer, BLE 호스트)는 이름으로 찾아 스택 여유만 보고한다.
+// 바쁜 시간에는 작업 도중 더 높은 우선순위 태스크에 선점된 시간도 포함되므로 상한값으로 본다.
+class TaskMonitor {
+private:
+    struct TaskEntry {
+        TaskHandle_t handle;
+        const char* name;
+        bool reportsBusy;       // addBusyTime()을 호출하는 태스크
+        uint64_t busyUs;        // 현재 집계 구간의 누적 작업 시간
+        uint32_t maxBusyUs;     // 한 번 깨어났을 때의 최대 작업 시간
+    };
+    TaskEntry tasks[TASK_MONITOR_MAX_TASKS];
+    int taskCount;
+    portMUX_TYPE lock;
+    int64_t windowStartUs;         // esp_timer 기준 (micros()는 약 71분마다 넘침)
+    
+public:
+    TaskMonitor();
+    
+    // 태스크 등록 (id 반환, 자리가 없으면 -1)
+    int registerTask(TaskHandle_t handle, const char* name);
+    int registerTaskByName(const char* name);  // 라이브러리 태스크 (스택만)
+    
+    // 태스크가 한 번 깨어나 처리한 시간 보고 (해당 태스크에서 호출, id가 -1이면 무시)
+    void addBusyTime(int id, uint32_t busyUs);
+    
+    void resetStats();
+    String getStatusString();
+};
+
+#endif // TASK_MONITOR_H
\ No newline at end of file
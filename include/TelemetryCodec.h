@@ -0,0 +1,273 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+// 텔레메트리 프레임 인코더/디코더
+// 펌웨어와 호스트 도구(tools/telemetry_decoder)가 같은 헤더를 공유하므로
+// Arduino 의존성 없이 표준 C++ 타입만 사용한다.
+//
+// 프레임 구조 (little-endian, varint = LEB128):
+//   [version u8][sampleCount u8][ackSeq u16][firstSeq varint]
+//   샘플 * sampleCount
+// ackSeq는 마지막으로 적용된 명령 시퀀스 번호(누적 ACK)이며, 샘플이 0개인 프레임은 순수 ACK로 쓰인다.
+// 이 연결에서 아직 적용된 명령이 없으면 ackSeq는 0xFFFF (COMMAND_SEQUENCE_NONE)이다.
+// 샘플 구조 (프레임 안에서 직전 샘플 대비 델타, 첫 샘플은 0 대비):
+//   [dtMs varint][encoder zigzag varint x4][duty zigzag varint x4]
+//   [direction u8][speed u8][loopUs varint][status u8]
+// 프레임마다 델타 기준이 초기화되므로 알림 하나가 유실되어도 다음 프레임은 독립적으로 복원된다.
+//
+// 첫 샘플은 절대값이라 MTU 23(페이로드 20)에는 샘플 하나도 들어가지 않을 수 있다.
+// 이때는 샘플 하나짜리 프레임을 조각으로 나누어 보낸다:
+//   [0x82][index u8 (bit7: 마지막 조각)][프레임 바이트...]
+// 수신 측은 index 0부터 순서대로 이어 붙이고, 중간 조각이 빠지면 그 프레임만 버린다.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define TELEMETRY_FRAME_VERSION     2
+#define TELEMETRY_FRAME_HEADER_MAX  9    // version + count + ackSeq + varint(u32)
+#define TELEMETRY_SAMPLE_MAX_SIZE   56   // 최악의 경우 샘플 하나의 인코딩 크기
+#define TELEMETRY_FRAME_MIN_BUFFER  (TELEMETRY_FRAME_HEADER_MAX + TELEMETRY_SAMPLE_MAX_SIZE)  // 샘플 하나짜리 프레임
+
+// 조각 패킷 (프레임 버전과 겹치지 않는 첫 바이트)
+#define TELEMETRY_FRAGMENT_MARKER   0x82
+#define TELEMETRY_FRAGMENT_HEADER   2    // marker + index
+#define TELEMETRY_FRAGMENT_LAST     0x80
+
+// 상태 비트
+#define TELEMETRY_STATUS_CONNECTED  0x01
+#define TELEMETRY_STATUS_RUNNING    0x02
+#define TELEMETRY_STATUS_AUTO_MODE  0x04
+#define TELEMETRY_STATUS_OVERRUN    0x80  // 샘플 버퍼 오버런 발생 (샘플 유실)
+
+struct TelemetrySample {
+    uint32_t timeMs;       // 로봇 시각 (millis)
+    int32_t encoder[4];    // FL, FR, RL, RR 인코더 카운트
+    int16_t duty[4];       // FL, FR, RL, RR 부호 있는 PWM 듀티 (-4095 ~ 4095)
+    uint8_t direction;     // Direction 열거형 값
+    uint8_t speed;         // 설정 속도 (0-100%)
+    uint16_t loopUs;       // 직전 통신 태스크 한 바퀴 실행 시간 (us)
+    uint8_t status;        // TELEMETRY_STATUS_* 비트
+};
+
+namespace TelemetryCodec {
+
+inline size_t writeVarint(uint8_t* out, uint32_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+// 성공 시 소비한 바이트 수, 실패 시 0 반환
+inline size_t readVarint(const uint8_t* in, size_t len, uint32_t* value) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < len && i < 5; i++) {
+        result |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0) {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+inline uint32_t zigzagEncode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+inline int32_t zigzagDecode(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// 이전 샘플 대비 델타로 샘플 하나를 인코딩 (out은 TELEMETRY_SAMPLE_MAX_SIZE 이상)
+inline size_t encodeSample(uint8_t* out, const TelemetrySample& sample, const TelemetrySample& prev) {
+    size_t n = 0;
+    n += writeVarint(out + n, sample.timeMs - prev.timeMs);
+    for (int i = 0; i < 4; i++) {
+        n += writeVarint(out + n, zigzagEncode((int32_t)((uint32_t)sample.encoder[i] - (uint32_t)prev.encoder[i])));
+    }
+    for (int i = 0; i < 4; i++) {
+        n += writeVarint(out + n, zigzagEncode((int32_t)sample.duty[i] - prev.duty[i]));
+    }
+    out[n++] = sample.direction;
+    out[n++] = sample.speed;
+    n += writeVarint(out + n, sample.loopUs);
+    out[n++] = sample.status;
+    return n;
+}
+
+// 성공 시 소비한 바이트 수, 실패 시 0 반환
+inline size_t decodeSample(const uint8_t* in, size_t len, TelemetrySample* sample, const TelemetrySample& prev) {
+    size_t n = 0;
+    size_t used;
+    uint32_t value;
+    
+    if ((used = readVarint(in + n, len - n, &value)) == 0) return 0;
+    sample->timeMs = prev.timeMs + value;
+    n += used;
+    
+    for (int i = 0; i < 4; i++) {
+        if ((used = readVarint(in + n, len - n, &value)) == 0) return 0;
+        sample->encoder[i] = (int32_t)((uint32_t)prev.encoder[i] + (uint32_t)zigzagDecode(value));
+        n += used;
+    }
+    for (int i = 0; i < 4; i++) {
+        if ((used = readVarint(in + n, len - n, &value)) == 0) return 0;
+        sample->duty[i] = (int16_t)(prev.duty[i] + zigzagDecode(value));
+        n += used;
+    }
+    
+    if (len - n < 2) return 0;
+    sample->direction = in[n++];
+    sample->speed = in[n++];
+    
+    if ((used = readVarint(in + n, len - n, &value)) == 0) return 0;
+    sample->loopUs = (uint16_t)value;
+    n += used;
+    
+    if (len - n < 1) return 0;
+    sample->status = in[n++];
+    return n;
+}
+
+// 하나의 알림 페이로드에 여러 샘플을 채워 넣는 프레임 빌더
+class FrameEncoder {
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;
+    uint8_t count;
+    TelemetrySample prev;
+    
+public:
+    FrameEncoder() : buffer(nullptr), capacity(0), length(0), count(0) {
+        memset(&prev, 0, sizeof(prev));
+    }
+    
+    // buf는 TELEMETRY_FRAME_MIN_BUFFER 이상 (첫 샘플은 cap보다 커도 받아 조각 전송에 맡김)
+    void begin(uint8_t* buf, size_t cap, uint32_t firstSeq) {
+        buffer = buf;
+        capacity = cap;
+        count = 0;
+        memset(&prev, 0, sizeof(prev));
+        buffer[0] = TELEMETRY_FRAME_VERSION;
+        buffer[1] = 0;
+        buffer[2] = 0;
+        buffer[3] = 0;
+        length = 4 + writeVarint(buffer + 4, firstSeq);
+    }
+    
+    // 전송 직전에 최신 누적 ACK를 기록 (고정 위치이므로 언제든 갱신 가능)
+    void setAck(uint16_t ackSeq) {
+        buffer[2] = (uint8_t)(ackSeq & 0xFF);
+        buffer[3] = (uint8_t)(ackSeq >> 8);
+    }
+    
+    // 공간이 부족하면 false (프레임은 변경되지 않음), 빈 프레임에는 항상 들어감
+    bool append(const TelemetrySample& sample) {
+        if (count == 0xFF) return false;
+        uint8_t tmp[TELEMETRY_SAMPLE_MAX_SIZE];
+        size_t n = encodeSample(tmp, sample, prev);
+        if (count > 0 && length + n > capacity) return false;
+        memcpy(buffer + length, tmp, n);
+        length += n;
+        prev = sample;
+        buffer[1] = ++count;
+        return true;
+    }
+    
+    uint8_t sampleCount() const { return count; }
+    size_t size() const { return length; }
+};
+
+// payload보다 큰 프레임을 나눌 조각 수 (조각으로 보낼 수 없으면 0)
+inline size_t fragmentCount(size_t frameLength, size_t payload) {
+    if (payload <= TELEMETRY_FRAGMENT_HEADER) return 0;
+    size_t chunk = payload - TELEMETRY_FRAGMENT_HEADER;
+    size_t count = (frameLength + chunk - 1) / chunk;
+    return count <= 0x7F ? count : 0;
+}
+
+// index번째 조각을 out(payload 이상)에 만들고 크기 반환
+inline size_t buildFragment(uint8_t* out, size_t payload, const uint8_t* frame, size_t frameLength, uint8_t index) {
+    size_t chunk = payload - TELEMETRY_FRAGMENT_HEADER;
+    size_t offset = (size_t)index * chunk;
+    if (offset >= frameLength) return 0;
+    size_t n = frameLength - offset < chunk ? frameLength - offset : chunk;
+    out[0] = TELEMETRY_FRAGMENT_MARKER;
+    out[1] = index | (offset + n == frameLength ? TELEMETRY_FRAGMENT_LAST : 0);
+    memcpy(out + TELEMETRY_FRAGMENT_HEADER, frame + offset, n);
+    return TELEMETRY_FRAGMENT_HEADER + n;
+}
+
+inline bool isFragment(const uint8_t* in, size_t len) {
+    return len > TELEMETRY_FRAGMENT_HEADER && in[0] == TELEMETRY_FRAGMENT_MARKER;
+}
+
+// 조각을 이어 붙여 원래 프레임으로 복원 (호스트 측)
+class FrameAssembler {
+private:
+    uint8_t buffer[TELEMETRY_FRAME_MIN_BUFFER];
+    size_t length;
+    int nextIndex;  // -1: 첫 조각 대기
+    
+public:
+    FrameAssembler() : length(0), nextIndex(-1) {}
+    
+    // 마지막 조각으로 프레임이 완성되면 true (frame()/size()로 조회)
+    bool push(const uint8_t* in, size_t len) {
+        if (!isFragment(in, len)) return false;
+        int index = in[1] & 0x7F;
+        if (index == 0) {
+            length = 0;
+            nextIndex = 0;
+        }
+        size_t n = len - TELEMETRY_FRAGMENT_HEADER;
+        if (index != nextIndex || length + n > sizeof(buffer)) {
+            nextIndex = -1;  // 중간 조각 유실 - 다음 index 0까지 버림
+            return false;
+        }
+        memcpy(buffer + length, in + TELEMETRY_FRAGMENT_HEADER, n);
+        length += n;
+        nextIndex++;
+        if (in[1] & TELEMETRY_FRAGMENT_LAST) {
+            nextIndex = -1;
+            return true;
+        }
+        return false;
+    }
+    
+    const uint8_t* frame() const { return buffer; }
+    size_t size() const { return length; }
+};
+
+// 프레임 하나를 디코딩. 복원한 샘플 수 반환, 형식 오류 시 -1
+inline int decodeFrame(const uint8_t* in, size_t len, TelemetrySample* out, size_t maxSamples,
+                       uint32_t* firstSeq, uint16_t* ackSeq) {
+    if (len < 5 || in[0] != TELEMETRY_FRAME_VERSION) return -1;
+    uint8_t count = in[1];
+    *ackSeq = (uint16_t)(in[2] | (in[3] << 8));
+    size_t n = 4;
+    size_t used = readVarint(in + n, len - n, firstSeq);
+    if (used == 0) return -1;
+    n += used;
+    
+    TelemetrySample prev;
+    memset(&prev, 0, sizeof(prev));
+    for (uint8_t i = 0; i < count; i++) {
+        if (i >= maxSamples) return -1;
+        used = decodeSample(in + n, len - n, &out[i], prev);
+        if (used == 0) return -1;
+        n += used;
+        prev = out[i];
+    }
+    return (n == len) ? count : -1;
+}
+
+} // namespace TelemetryCodec
+
+#endif // TELEMETRY_CODEC_H
\ No newline at end of file
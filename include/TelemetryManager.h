@@ -0,0 +1,83 @@
+#ifndef TELEMETRY_MANAGER_H
+#define TELEMETRY_MANAGER_H
+
+#include <esp_timer.h>
+#include "config.h"
+#include "TelemetryCodec.h"
+
+// 전방 선언
+class MotorController;
+class EncoderManager;
+class BluetoothManager;
+class CommandProcessor;
+class TransportManager;
+class CommandTransport;
+
+class TelemetryManager {
+private:
+    MotorController* motorController;
+    EncoderManager* encoderManager;
+    BluetoothManager* bluetoothManager;
+    CommandProcessor* commandProcessor;
+    TransportManager* transportManager;
+    
+    esp_timer_handle_t sampleTimer;
+    int rateHz;
+    
+    // 샘플 링 버퍼 (타이머 콜백 → loop)
+    TelemetrySample samples[TELEMETRY_BUFFER_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile bool overrun;
+    portMUX_TYPE bufferLock;
+    
+    // 전송 중인 프레임
+    uint8_t frameBuffer[TELEMETRY_MAX_FRAME_SIZE];
+    TelemetryCodec::FrameEncoder frame;
+    uint32_t nextSequence;
+    unsigned long frameStartTime;
+    
+    // 전송 경로별 누적 명령 ACK
+    uint16_t lastSentAck[TRANSPORT_MAX_COUNT];
+    unsigned long lastAckTime[TRANSPORT_MAX_COUNT];
+    
+    volatile uint16_t lastLoopUs;
+    
+    // 통계
+    unsigned long framesSent;
+    unsigned long samplesDropped;
+    
+public:
+    TelemetryManager();
+    ~TelemetryManager();
+    
+    // 초기화 및 의존성 주입
+    bool initialize();
+    void setMotorController(MotorController* controller);
+    void setEncoderManager(EncoderManager* manager);
+    void setBluetoothManager(BluetoothManager* manager);
+    void setCommandProcessor(CommandProcessor* processor);
+    void setTransportManager(TransportManager* manager);
+    
+    // 전송 주기 설정 (0이면 중지)
+    bool setRate(int hz);
+    int getRate() const;
+    
+    // 통신 태스크에서 호출: 샘플을 프레임으로 묶어 전송
+    void update();
+    void recordLoopTime(unsigned long loopUs);
+    
+    String getStatusString() const;
+    
+private:
+    static void sampleTimerCallback(void* arg);
+    void takeSample();
+    bool popSample(TelemetrySample& sample);
+    void startFrame();
+    void flushFrame();
+    bool sendFrame(CommandTransport* transport, size_t length);
+    void sendAckOnlyFrame(uint8_t index, CommandTransport* transport, uint16_t ack);
+    size_t getFrameCapacity() const;
+};
+
+#endif // TELEMETRY_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef TRANSPORT_MANAGER_H
+#define TRANSPORT_MANAGER_H
+
+#include "config.h"
+#include "CommandTransport.h"
+
+// 등록된 전송 경로 목록 (고정 크기)
+// 응답은 활성화된 모든 경로로 보내고, 텔레메트리는 TelemetryManager가 경로별 ACK를 붙여 보낸다.
+class TransportManager {
+private:
+    CommandTransport* transports[TRANSPORT_MAX_COUNT];
+    uint8_t count;
+    
+public:
+    TransportManager();
+    
+    bool addTransport(CommandTransport* transport);
+    uint8_t getCount() const;
+    CommandTransport* getTransport(uint8_t index) const;
+    int indexOf(const CommandTransport* transport) const;
+    
+    // 통신 태스크에서 호출
+    void update();
+    
+    // 활성화된 모든 경로로 응답 전송 (텍스트 응답은 비활성 경로의 sendTextResponse()로도)
+    void sendResponse(const String& response);
+    void sendResponse(const uint8_t* data, size_t length);  // 바이너리 응답
+    
+    // 활성화된 경로 중 가장 작은 텔레메트리 프레임 크기 (없으면 0)
+    size_t getMinPayload() const;
+    
+    String getStatusString() const;
+};
+
+#endif // TRANSPORT_MANAGER_H
\ No newline at end of file
@@ -27,6 +27,7 @@
 #define MOTOR_RR_SPEED 9   // ENB - 속도 제어
 #define MOTOR_RR_DIR_A 10  // IN3 - 방향 제어 A
 #define MOTOR_RR_DIR_B 11  // IN4 - 방향 제어 B
+#define MOTOR_CHANNEL_COUNT 12  // 채널 0~11을 한 프레임으로 출력
 
 // 인코더 핀 정의
 #define ENCODER_FL_A 0  // GPIO0 - 전방 좌측
@@ -48,18 +49,172 @@
 #define PWM_HALF 2048
 #define PWM_FREQUENCY 1000
 
+// ==============================================
+// I2C 버스 설정 (PCA9685 + SSD1306 공유)
+// ==============================================
+#define I2C_BUS_CLOCK_HZ 400000        // 속도 probe 전 시작 속도 (probe 결과는 I2cBusScheduler::getClockHz())
+#define I2C_CLOCK_CANDIDATES { 1000000, 800000, 400000, 100000 }  // 빠른 순서로 시도 (C3 데이터시트 보장은 800kHz)
+#define I2C_CLOCK_PROBE_ROUNDS 16      // 속도마다 PCA9685 쓰기/읽기 + OLED 명령 반복 횟수
+#define PCA9685_SUBADR1 0x02           // 속도 probe용 읽기/쓰기 레지스터 (MODE1.SUB1이 꺼져 있으면 동작에 영향 없음)
+#define PCA9685_SUBADR1_DEFAULT 0xE2
+#define I2C_SDA_PIN SDA                // 버스 복구 시 GPIO로 직접 제어
+#define I2C_SCL_PIN SCL
+#define DISPLAY_I2C_ADDRESS 0x3C
+#define DISPLAY_I2C_CHUNK_TILES 4      // 한 번에 보내는 타일 수 (32B + 헤더 ≈ 0.9ms), 조각 사이에서 모터에 양보
+#define PCA9685_I2C_ADDRESS 0x40       // Adafruit_PWMServoDriver 기본 주소
+#define PCA9685_LED0_ON_L 0x06         // 채널 0 레지스터 (채널당 4바이트, MODE1 자동 증가)
+#define PCA9685_MODE1 0x00
+#define PCA9685_PRESCALE 0xFE
+#define PCA9685_MODE1_SLEEP 0x10       // 발진기 정지 (PRESCALE은 슬립 중에만 쓸 수 있음)
+#define PCA9685_MODE1_AI 0x20          // 레지스터 자동 증가
+#define PCA9685_OSCILLATOR_HZ 25000000
+#define PCA9685_WAKE_US 500            // 슬립 해제 후 발진기 안정화 (데이터시트 최소값)
+
+// 비동기 I2C 워커
+#define I2C_ASYNC_MOTOR_OUTPUT true    // 모터 프레임을 워커에 넘기고 바로 반환
+#define I2C_TRANSACTION_MAX_LENGTH 49  // PCA9685 12채널 연속 쓰기 (레지스터 1 + 채널당 4)
+#define I2C_WORKER_QUEUE_LENGTH 8
+#define I2C_WORKER_TASK_PRIORITY 4     // 제어 태스크(5)보다 낮고 통신 태스크(3)보다 높게
+#define I2C_WORKER_TASK_STACK_SIZE 3072
+#define I2C_BENCHMARK_DEFAULT_FRAMES 20
+#define I2C_BENCHMARK_MAX_FRAMES 200
+#define I2C_BENCHMARK_FRAME_TIMEOUT_US 100000  // 비동기 프레임 완료를 기다리는 최대 시간
+
+// 버스 상태 감시 및 복구
+#define I2C_HEALTH_PROBE_INTERVAL_MS 1000   // 장치 주소 probe 주기
+#define I2C_HEALTH_FAILURE_THRESHOLD 3      // 연속 실패가 이만큼이면 오프라인/복구
+#define I2C_RECOVERY_SETTLE_MS 10           // Wire 재초기화 후 장치 확인까지 대기
+#define I2C_RESYNC_WAKE_MS 2                // PCA9685 깨우기 → 정지 프레임 (500us, millis 해상도 고려)
+#define I2C_RECOVERY_MAX_ATTEMPTS 3
+#define I2C_RECOVERY_RETRY_MS 2000          // 복구 실패 후 다시 시도까지
+
 // ==============================================
 // BLE 설정
 // ==============================================
 #define SERVICE_UUID        "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
 #define CHARACTERISTIC_UUID "beb5483e-36e1-4688-b7f5-ea07361b26a8"
 #define BLE_DEVICE_NAME     "KIMSF1"
+#define TELEMETRY_CHARACTERISTIC_UUID "6e400003-b5a3-f393-e0a9-e50e24dcca9e"
+#define COMMAND_CHARACTERISTIC_UUID   "6e400002-b5a3-f393-e0a9-e50e24dcca9e"  // Write Without Response 스트리밍 명령
+#define BLE_ACK_INTERVAL_MS 20         // 텔레메트리가 없을 때 누적 ACK 최소 전송 간격
+
+// BLE 링크 튜닝 (연결 간격 단위 1.25ms, 감독 타임아웃 단위 10ms)
+#define BLE_PREFERRED_MTU 247
+#define BLE_PREFERRED_DATA_LEN 251     // LE Data Length Extension 최대 페이로드
+#define BLE_LATENCY_CONN_INTERVAL_MIN 6    // 7.5ms
+#define BLE_LATENCY_CONN_INTERVAL_MAX 12   // 15ms
+#define BLE_SUPERVISION_TIMEOUT 400        // 4s
+#define BLE_BENCHMARK_DEFAULT_COUNT 20
+#define BLE_BENCHMARK_MAX_COUNT 200
+#define BLE_MAX_CONNECTIONS 3          // 운전자 1 + 관찰자 2 (Bluedroid 기본 ACL 연결 수 4 이내)
+
+// 재연결 광고 단계: 빠른 광고 → 마지막 운전자에게 지향성 광고 → 느린 광고 (간격 단위 0.625ms)
+#define BLE_ADV_FAST_INTERVAL_MIN 32       // 20ms
+#define BLE_ADV_FAST_INTERVAL_MAX 48       // 30ms
+#define BLE_ADV_FAST_DURATION_MS 5000
+#define BLE_ADV_DIRECTED_DURATION_MS 5000
+#define BLE_ADV_SLOW_INTERVAL_MIN 1600     // 1s
+#define BLE_ADV_SLOW_INTERVAL_MAX 2000     // 1.25s
+#define BLE_ADV_DIRECTED_ADDR_TYPE BLE_ADDR_TYPE_RANDOM  // 연결 이벤트에 주소 타입이 없는 IDF(5.0 미만)에서 가정하는 값
+
+// 플릿 브로드캐스트 스캔 (연결 유지를 위해 스캔 창은 간격의 절반)
+#define FLEET_SCAN_INTERVAL_MS 100
+#define FLEET_SCAN_WINDOW_MS 50
+#define FLEET_TIMEOUT_MS 500           // 송신기 광고가 끊기면 정지
+#define FLEET_NVS_NAMESPACE "fleet"
+
+// ==============================================
+// 텔레메트리 설정
+// ==============================================
+#define TELEMETRY_DEFAULT_RATE_HZ 50
+#define TELEMETRY_MIN_RATE_HZ 10
+#define TELEMETRY_MAX_RATE_HZ 200
+#define TELEMETRY_BUFFER_SIZE 64       // 샘플 링 버퍼 크기
+#define TELEMETRY_MAX_BATCH_MS 50      // 프레임이 다 차지 않아도 이 시간이 지나면 전송
+#define TELEMETRY_MAX_FRAME_SIZE 244   // MTU 247 - ATT 헤더 3
 
 // ==============================================
 // 시스템 설정
 // ==============================================
-#define SERIAL_BAUD_RATE 115200
+#define SERIAL_BAUD_RATE 115200        // USB-CDC에서는 무시됨 (USB 전송 속도로 동작)
+#define SERIAL_RX_BUFFER_SIZE 1024
+#define SERIAL_TX_BUFFER_SIZE 2048     // 최대 프레임(SERIAL_FRAME_MAX_ENCODED)보다 충분히 크게
+#define SERIAL_LINK_TIMEOUT_MS 2000    // 이 시간 동안 프레임이 없으면 프레임 응답/텔레메트리 중지
+#define TRANSPORT_MAX_COUNT 4          // BLE, 시리얼, ESP-NOW (+ 여유 1)
+
+// ESP-NOW (WiFi 채널은 컨트롤러와 같아야 함)
+#define ESPNOW_CHANNEL 1
+#define ESPNOW_LINK_TIMEOUT_MS 1000    // 이 시간 동안 수신이 없으면 응답/텔레메트리 중지
+#define ESPNOW_PAIRING_WINDOW_MS 30000
+#define ESPNOW_NVS_NAMESPACE "espnow"
+#define COMMAND_QUEUE_LENGTH 16        // 수신 → 통신 태스크 명령 큐 길이
+#define COMMAND_MAX_LENGTH 240         // 명령 문자열 최대 길이 (넘으면 실행하지 않고 command:too_long 응답)
 #define ENCODER_PRINT_INTERVAL 5000  // 5초마다 인코더 정보 출력
+#define LED_QUEUE_LENGTH 4             // 대기 중인 LED 효과 최대 개수
+
+// 지연 바이너리 로그 (LogCatalog.h, Logger.h)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 4            // 1:ERROR 2:WARN 3:INFO 4:DEBUG, 이보다 자세한 로그는 빌드에서 제거 (build_flags로 변경)
+#endif
+#define LOG_BUFFER_SIZE 4096           // 링 버퍼 크기 (2의 거듭제곱)
+#define LOG_DRAIN_MAX_FRAMES 4         // drain() 한 번에 보내는 최대 프레임(text 모드는 줄) 수
+#define LOG_DEFAULT_TEXT_OUTPUT false  // 기본은 바이너리 프레임, "log:text"로 시리얼 모니터용 글자 출력
+#define LOG_TEXT_LINE_SIZE 160
+
+// 핫패스 사이클 프로파일러 (Profiler.h, "profile" 명령)
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1             // 0이면 PROFILE_SCOPE 계측 코드가 빌드에서 모두 제거됨 (build_flags로 변경)
+#endif
+#define DISPLAY_I2C_TRANSFER_OVERHEAD 7  // drawTile 1회당 주소/제어/위치 명령 바이트 (SSD1306, 추정치)
+#define DISPLAY_REFRESH_PERIOD_MS 66   // 약 15fps, 그 사이의 중간 상태는 그리지 않음
+#define DISPLAY_TASK_PRIORITY 0        // loop()(1)/통신 태스크보다 낮게: 명령 처리가 비어 있을 때만 I2C 전송
+#define DISPLAY_TASK_STACK_SIZE 3072
+#define BOOT_TASK_PRIORITY 0           // 부팅 백그라운드 단계 (디스플레이 초기화 재시도 등), loop()보다 낮게
+#define BOOT_TASK_STACK_SIZE 4096
+
+// ==============================================
+// 제어 루프 및 예약 명령 설정
+// ==============================================
+#define CONTROL_TICK_PERIOD_US 1000    // 1kHz 제어 틱
+#define CONTROL_TASK_PRIORITY 5        // 가장 높게 (통신/UI 부하와 무관한 틱)
+#define CONTROL_TASK_STACK_SIZE 4096
+#define MOTION_INTENT_QUEUE_LENGTH 8   // 통신 태스크 → 제어 태스크 동작 의도
+#define MOTION_INTENT_WAIT_MS 20       // 응답/ACK 전에 제어 태스크의 적용을 기다리는 최대 시간
+
+// 태스크 구성 (우선순위): 제어 5 > I2C 워커 4 > 통신 3 > loop() 1 (버스 감시/로그) > 디스플레이 0
+#define COMMS_TASK_PRIORITY 3          // 명령 처리/응답/텔레메트리
+#define COMMS_TASK_STACK_SIZE 8192     // 명령 처리 경로의 String 사용 (loop() 기본 스택과 같게)
+#define COMMS_IDLE_WAIT_MS 10          // 명령이 없을 때 연결 관리/텔레메트리 주기
+#define UI_LOOP_PERIOD_MS 10           // loop() 주기
+#define TASK_MONITOR_MAX_TASKS 10
+#define SCHEDULER_CAPACITY 32          // 예약 명령 최대 개수
+#define SCHEDULER_MAX_LOOKAHEAD_MS 5000   // 이보다 먼 미래의 명령은 거부
+#define SCHEDULER_LATE_THRESHOLD_US 1000  // 이보다 늦게 실행되면 지연으로 집계
+
+// 데드맨 keepalive (스트리밍 vel: 설정값)
+#define KEEPALIVE_DEFAULT_PERIOD_MS 50    // 20Hz 조이스틱
+#define KEEPALIVE_MIN_PERIOD_MS 10
+#define KEEPALIVE_MAX_PERIOD_MS 1000
+#define KEEPALIVE_DEFAULT_MISSES 3        // 이만큼 주기를 놓치면 감속 정지
+#define KEEPALIVE_MAX_MISSES 20
+#define KEEPALIVE_RAMP_MS 250             // 0까지 감속 시간
+
+// ==============================================
+// 모션 매크로 설정
+// ==============================================
+#define MACRO_MAX_COUNT 8
+#define MACRO_MAX_STEPS 16
+#define MACRO_NAME_MAX_LENGTH 12
+#define MACRO_TRIGGER_BASE 0x01        // 1바이트 명령 0x01~0x08 → 매크로 0~7 실행
+#define MACRO_NVS_NAMESPACE "macros"
+
+// ==============================================
+// 런타임 파라미터 설정
+// ==============================================
+// 아래 항목의 기본값은 위 #define 값을 쓰고, 실행 중 값은 ParameterRegistry가 관리한다.
+// (PWM_FREQUENCY, ENCODER_PRINT_INTERVAL, TELEMETRY_MAX_BATCH_MS, KEEPALIVE_RAMP_MS)
+#define PARAM_NVS_NAMESPACE "params"
+#define PARAM_RESPONSE_MAX_SIZE 64     // 바이너리 응답 버퍼 (헤더 + 전체 레코드)
 
 // ==============================================
 // 모터 인덱스 열거형
@@ -83,7 +238,8 @@ enum Direction {
     DIR_ROTATE_LEFT,
     DIR_ROTATE_RIGHT,
     DIR_DIAGONAL_FL,
-    DIR_DIAGONAL_FR
+    DIR_DIAGONAL_FR,
+    DIR_VELOCITY       // 차체 속도 직접 지정 (vel: 명령, 매크로)
 };
 
 #endif // CONFIG_H
\ No newline at end of file
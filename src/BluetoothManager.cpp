@@ -1,10 +1,45 @@
 #include "BluetoothManager.h"
-#include "CommandProcessor.h"
+#include "LatencyTracker.h"
+#include "LedEffectEngine.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+// GAP/GATTS 이벤트 핸들러용 인스턴스
+BluetoothManager* BluetoothManager::instance = nullptr;
+
+// 프로파일별 연결 파라미터 (간격 단위 1.25ms)
+struct LinkProfileParams {
+    uint16_t minInterval;
+    uint16_t maxInterval;
+    uint16_t slaveLatency;
+    bool prefer2MPhy;
+    const char* name;
+};
+
+static const LinkProfileParams LINK_PROFILES[] = {
+    { BLE_LATENCY_CONN_INTERVAL_MIN, BLE_LATENCY_CONN_INTERVAL_MAX, 0, true, "latency" },  // 7.5-15ms
+    { 24, 40, 0, false, "balanced" },   // 30-50ms
+    { 80, 160, 4, false, "power" }      // 100-200ms
+};
 
 BluetoothManager::BluetoothManager() 
-    : pServer(nullptr), pCharacteristic(nullptr), commandProcessor(nullptr),
-      deviceConnected(false), oldDeviceConnected(false) {
-    Serial.println("BluetoothManager constructor called");
+    : pServer(nullptr), pCharacteristic(nullptr), pTelemetryCharacteristic(nullptr),
+      pCommandCharacteristic(nullptr), responseCccd(nullptr), telemetryCccd(nullptr),
+      commandQueue(nullptr), ledEffects(nullptr),
+      connectionCount(0), oldConnectionCount(0), rejectedWrites(0),
+      lastAppliedSequence(COMMAND_SEQUENCE_NONE), linkProfile(LINK_PROFILE_LATENCY), pendingDataLengthSlot(-1),
+      advertisingPhase(ADV_PHASE_IDLE), phaseStartedAt(0), connectPending(false), disconnectPending(false),
+      hasLastDriver(false), reconnectPending(false), disconnectedAt(0), lastReconnectMs(0),
+      lastReconnectPhase(ADV_PHASE_IDLE), reconnectCount(0),
+      benchmarkTotal(0), benchmarkIndex(0), benchmarkSentAt(0), benchmarkMin(0), benchmarkMax(0), benchmarkSum(0) {
+    memset(connections, 0, sizeof(connections));
+    memset(&idleLinkInfo, 0, sizeof(idleLinkInfo));
+    memset(lastDriverAddress, 0, sizeof(lastDriverAddress));
+    lastDriverAddressType = BLE_ADV_DIRECTED_ADDR_TYPE;
+    idleLinkInfo.mtu = 23;
+    connectionLock = portMUX_INITIALIZER_UNLOCKED;
+    instance = this;
+    LOG_TEXT(LOG_BLE_SETUP, "BluetoothManager constructor called");
 }
 
 BluetoothManager::~BluetoothManager() {
@@ -12,29 +47,34 @@ BluetoothManager::~BluetoothManager() {
 }
 
 bool BluetoothManager::initialize() {
-    Serial.println("Initializing Bluetooth Manager...");
+    LOG_TEXT(LOG_BLE_SETUP, "Initializing Bluetooth Manager...");
     
     // BLE 장치 초기화
     BLEDevice::init(BLE_DEVICE_NAME);
-    Serial.println("BLE device initialized");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE device initialized");
+    
+    // 로컬 MTU를 키워 두면 클라이언트의 MTU 교환 요청 시 큰 값으로 협상됨
+    BLEDevice::setMTU(BLE_PREFERRED_MTU);
+    BLEDevice::setCustomGapHandler(gapEventHandler);
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
     
     pServer = BLEDevice::createServer();
     if (!pServer) {
-        Serial.println("Failed to create BLE server!");
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "create BLE server");
         return false;
     }
-    Serial.println("BLE server created");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE server created");
     
     pServer->setCallbacks(new ServerCallbacks(this));
-    Serial.println("Server callbacks set");
+    LOG_TEXT(LOG_BLE_SETUP, "Server callbacks set");
     
     // BLE 서비스 생성
     BLEService* pService = pServer->createService(SERVICE_UUID);
     if (!pService) {
-        Serial.println("Failed to create BLE service!");
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "create BLE service");
         return false;
     }
-    Serial.println("BLE service created");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE service created");
     
     // BLE 특성 생성
     pCharacteristic = pService->createCharacteristic(
@@ -45,149 +85,907 @@ bool BluetoothManager::initialize() {
     );
     
     if (!pCharacteristic) {
-        Serial.println("Failed to create BLE characteristic!");
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "create BLE characteristic");
         return false;
     }
-    Serial.println("BLE characteristic created");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE characteristic created");
     
     pCharacteristic->setCallbacks(new CharacteristicCallbacks(this));
-    pCharacteristic->addDescriptor(new BLE2902());
+    responseCccd = new BLE2902();
+    pCharacteristic->addDescriptor(responseCccd);
     pCharacteristic->setValue("Mecanum Ready");
-    Serial.println("Characteristic callbacks and descriptor set");
+    LOG_TEXT(LOG_BLE_SETUP, "Characteristic callbacks and descriptor set");
+    
+    // 텔레메트리 특성 생성 (알림 전용)
+    pTelemetryCharacteristic = pService->createCharacteristic(
+        TELEMETRY_CHARACTERISTIC_UUID,
+        BLECharacteristic::PROPERTY_NOTIFY
+    );
+    
+    if (!pTelemetryCharacteristic) {
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "create telemetry characteristic");
+        return false;
+    }
+    telemetryCccd = new BLE2902();
+    pTelemetryCharacteristic->addDescriptor(telemetryCccd);
+    LOG_TEXT(LOG_BLE_SETUP, "Telemetry characteristic created");
+    
+    // 스트리밍 명령 특성 생성 (응답 없는 쓰기: 연결 이벤트당 여러 패킷 전송 가능)
+    pCommandCharacteristic = pService->createCharacteristic(
+        COMMAND_CHARACTERISTIC_UUID,
+        BLECharacteristic::PROPERTY_WRITE_NR
+    );
+    
+    if (!pCommandCharacteristic) {
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "create command characteristic");
+        return false;
+    }
+    pCommandCharacteristic->setCallbacks(new CommandStreamCallbacks(this));
+    LOG_TEXT(LOG_BLE_SETUP, "Command stream characteristic created");
     
     // 서비스 시작
     pService->start();
-    Serial.println("BLE service started");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE service started");
     
     // 광고 설정 및 시작
     BLEAdvertising* pAdvertising = BLEDevice::getAdvertising();
     if (!pAdvertising) {
-        Serial.println("Failed to get advertising object!");
+        LOG_TEXT(LOG_BLE_SETUP_FAILED, "get advertising object");
         return false;
     }
     
     pAdvertising->addServiceUUID(SERVICE_UUID);
     pAdvertising->setScanResponse(true);
-    pAdvertising->setMinPreferred(0x06);
-    pAdvertising->setMinPreferred(0x12);
+    // 스캔 응답에 선호 연결 간격(7.5-15ms) 힌트 포함
+    pAdvertising->setMinPreferred(BLE_LATENCY_CONN_INTERVAL_MIN);
+    pAdvertising->setMaxPreferred(BLE_LATENCY_CONN_INTERVAL_MAX);
+    // 광고 데이터 설정을 겸해 첫 광고는 라이브러리로 시작 (빠른 광고 단계)
+    pAdvertising->setMinInterval(BLE_ADV_FAST_INTERVAL_MIN);
+    pAdvertising->setMaxInterval(BLE_ADV_FAST_INTERVAL_MAX);
     BLEDevice::startAdvertising();
+    advertisingPhase = ADV_PHASE_FAST;
+    phaseStartedAt = millis();
     
-    Serial.println("BLE advertising started");
-    Serial.println("BLE server ready, waiting for connections...");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE advertising started");
+    LOG_TEXT(LOG_BLE_SETUP, "BLE server ready, waiting for connections...");
     return true;
 }
 
-void BluetoothManager::setCommandProcessor(CommandProcessor* processor) {
-    commandProcessor = processor;
-    Serial.println("Command processor set");
+void BluetoothManager::setCommandQueue(CommandQueue* queue) {
+    commandQueue = queue;
+    LOG_TEXT(LOG_BLE_SETUP, "Command queue set");
+}
+
+void BluetoothManager::setLedEffectEngine(LedEffectEngine* engine) {
+    ledEffects = engine;
 }
 
 bool BluetoothManager::isConnected() const {
-    return deviceConnected;
+    return connectionCount > 0;
+}
+
+uint8_t BluetoothManager::getConnectionCount() const {
+    return connectionCount;
+}
+
+bool BluetoothManager::hasDriver() const {
+    return findDriver() >= 0;
 }
 
 void BluetoothManager::handleConnectionChange() {
-    // 연결 해제 감지
-    if (!deviceConnected && oldDeviceConnected) {
-        Serial.println("Connection lost, restarting advertising...");
-        delay(500); // 연결 해제 이벤트 처리 시간
-        pServer->startAdvertising(); // 재광고 시작
-        Serial.println("Advertising restarted");
-        oldDeviceConnected = deviceConnected;
+    uint8_t count = connectionCount;
+    
+    // 연결 해제 감지 (재광고는 updateAdvertising()에서 처리)
+    if (count < oldConnectionCount) {
+        LOG(LOG_BLE_CLIENTS_LOST, count);
+        if (count == 0 && ledEffects) {
+            ledEffects->setBaseLevel(false);
+        }
+        oldConnectionCount = count;
     }
     
     // 새로운 연결 감지
-    if (deviceConnected && !oldDeviceConnected) {
-        Serial.println("New connection established");
-        oldDeviceConnected = deviceConnected;
+    if (count > oldConnectionCount) {
+        LOG(LOG_BLE_CLIENTS_NEW, count);
+        oldConnectionCount = count;
+    }
+    
+    updateAdvertising();
+}
+
+void BluetoothManager::updateAdvertising() {
+    // 대기 없이 통신 태스크의 매 주기마다 호출되는 광고 상태 머신
+    bool disconnected = disconnectPending;
+    bool connected = connectPending;
+    disconnectPending = false;
+    connectPending = false;
+    
+    if (connectionCount >= BLE_MAX_CONNECTIONS) {
+        if (advertisingPhase != ADV_PHASE_IDLE) {
+            startAdvertisingPhase(ADV_PHASE_IDLE);
+        }
+        return;
+    }
+    
+    if (disconnected) {
+        // 끊긴 클라이언트가 곧바로 다시 붙을 수 있도록 빠른 광고부터 시작
+        startAdvertisingPhase(ADV_PHASE_FAST);
+        return;
+    }
+    
+    if (connected || advertisingPhase == ADV_PHASE_IDLE) {
+        // 연결이 생기면 스택이 광고를 멈춤 - 연결 중에는 운전자 링크를 방해하지 않도록 느린 광고로 관찰자 대기
+        startAdvertisingPhase(connectionCount > 0 ? ADV_PHASE_SLOW : ADV_PHASE_FAST);
+        return;
+    }
+    
+    unsigned long elapsed = millis() - phaseStartedAt;
+    if (advertisingPhase == ADV_PHASE_FAST && elapsed >= BLE_ADV_FAST_DURATION_MS) {
+        // 운전자 자리가 비어 있고 이전 운전자를 알면 그 주소로만 지향성 광고
+        startAdvertisingPhase(canDirectToLastDriver() && !hasDriver() ? ADV_PHASE_DIRECTED : ADV_PHASE_SLOW);
+    } else if (advertisingPhase == ADV_PHASE_DIRECTED && elapsed >= BLE_ADV_DIRECTED_DURATION_MS) {
+        startAdvertisingPhase(ADV_PHASE_SLOW);
+    }
+}
+
+void BluetoothManager::startAdvertisingPhase(BleAdvertisingPhase phase) {
+    // 광고 데이터는 initialize()에서 설정한 것을 그대로 쓰고 파라미터만 바꿔 재시작
+    esp_ble_gap_stop_advertising();
+    advertisingPhase = phase;
+    phaseStartedAt = millis();
+    
+    LOG_TEXT(LOG_BLE_ADV_PHASE, phaseToString(phase));
+    if (phase == ADV_PHASE_IDLE) {
+        return;
+    }
+    
+    esp_ble_adv_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.adv_type = ADV_TYPE_IND;
+    params.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
+    params.channel_map = ADV_CHNL_ALL;
+    params.adv_filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY;
+    
+    if (phase == ADV_PHASE_SLOW) {
+        params.adv_int_min = BLE_ADV_SLOW_INTERVAL_MIN;
+        params.adv_int_max = BLE_ADV_SLOW_INTERVAL_MAX;
+    } else {
+        params.adv_int_min = BLE_ADV_FAST_INTERVAL_MIN;
+        params.adv_int_max = BLE_ADV_FAST_INTERVAL_MAX;
+    }
+    
+    if (phase == ADV_PHASE_DIRECTED) {
+        // 저duty 지향성 광고 (고duty는 1.28s 제한이 있어 단계 길이를 맞출 수 없음)
+        params.adv_type = ADV_TYPE_DIRECT_IND_LOW;
+        memcpy(params.peer_addr, lastDriverAddress, sizeof(esp_bd_addr_t));
+        params.peer_addr_type = lastDriverAddressType;
+    }
+    
+    if (esp_ble_gap_start_advertising(&params) != ESP_OK) {
+        LOG(LOG_BLE_ADV_FAILED);
+    }
+}
+
+bool BluetoothManager::canDirectToLastDriver() const {
+    if (!hasLastDriver) return false;
+    // 해결 가능한 개인 주소(RPA, 최상위 2비트 01)는 주기적으로 바뀌고 본딩(IRK)이 없어
+    // 이전 주소로 지향성 광고를 해도 central이 응답하지 않음 - 바로 느린 광고로
+    bool resolvable = lastDriverAddressType == BLE_ADDR_TYPE_RANDOM && (lastDriverAddress[0] & 0xC0) == 0x40;
+    return !resolvable;
+}
+
+esp_ble_addr_type_t BluetoothManager::connectAddressType(const esp_ble_gatts_cb_param_t* param) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    return param->connect.ble_addr_type;
+#else
+    // 이전 IDF의 연결 이벤트에는 주소 타입이 없음
+    (void)param;
+    return BLE_ADV_DIRECTED_ADDR_TYPE;
+#endif
+}
+
+const char* BluetoothManager::phaseToString(BleAdvertisingPhase phase) {
+    switch (phase) {
+        case ADV_PHASE_FAST: return "fast";
+        case ADV_PHASE_DIRECTED: return "directed";
+        case ADV_PHASE_SLOW: return "slow";
+        default: return "idle";
+    }
+}
+
+String BluetoothManager::getAdvertisingString() const {
+    // 예: "adv:slow reconnect:412ms via:fast n:3"
+    String info = "adv:";
+    info += phaseToString(advertisingPhase);
+    info += " reconnect:";
+    if (reconnectCount > 0) {
+        info += lastReconnectMs;
+        info += "ms via:";
+        info += phaseToString(lastReconnectPhase);
+    } else {
+        info += "-";
     }
+    info += " n:";
+    info += reconnectCount;
+    return info;
 }
 
 void BluetoothManager::sendMessage(const String& message) {
-    if (!deviceConnected) {
-        Serial.println("Cannot send message: Not connected");
+    if (!isConnected()) {
+        LOG(LOG_BLE_SEND_NOT_CONNECTED);
         return;
     }
     
     if (!pCharacteristic) {
-        Serial.println("Cannot send message: Characteristic not initialized");
+        LOG(LOG_BLE_SEND_NO_CHARACTERISTIC);
         return;
     }
     
-    Serial.print("Sending message: ");
-    Serial.println(message);
+    LOG_TEXT(LOG_BLE_SEND, message.c_str());
     
+    // 읽기용 값은 한 번만 갱신하고 알림은 모든 연결로 전송
     pCharacteristic->setValue(message.c_str());
-    pCharacteristic->notify();
+    notifyAll(pCharacteristic, (const uint8_t*)message.c_str(), message.length());
 }
 
 String BluetoothManager::getLastReceivedMessage() const {
     return receivedMessage;
 }
 
-void BluetoothManager::onConnect() {
-    deviceConnected = true;
-    digitalWrite(LED_PIN, HIGH);
-    Serial.println("BLE device connected");
+const char* BluetoothManager::getName() const {
+    return "ble";
+}
+
+bool BluetoothManager::isActive() const {
+    return isConnected();
+}
+
+bool BluetoothManager::sendResponse(const char* text, size_t length) {
+    if (!isConnected() || !pCharacteristic) return false;
     
-    // 연결 성공 메시지 전송
-    sendMessage("Connected to Mecanum Robot");
+    // 바이너리 응답도 있으므로 길이 그대로 전송 (String 변환 시 0x00에서 잘림)
+    pCharacteristic->setValue((uint8_t*)text, length);
+    return notifyAll(pCharacteristic, (const uint8_t*)text, length);
 }
 
-void BluetoothManager::onDisconnect() {
-    deviceConnected = false;
-    digitalWrite(LED_PIN, LOW);
-    Serial.println("BLE device disconnected");
+size_t BluetoothManager::getMaxPayload() const {
+    return getMaxNotifyPayload();
 }
 
-void BluetoothManager::onMessageReceived(const String& message) {
-    receivedMessage = message;
-    Serial.print("BLE Received: ");
-    Serial.println(message);
+bool BluetoothManager::sendTelemetry(const uint8_t* data, size_t length) {
+    if (!isConnected() || !pTelemetryCharacteristic) {
+        return false;
+    }
+    
+    // 읽기 속성이 없으므로 setValue() 없이 프레임 버퍼를 바로 전송
+    return notifyAll(pTelemetryCharacteristic, data, length);
+}
+
+uint8_t BluetoothManager::subscriptionBit(BLECharacteristic* characteristic) const {
+    return characteristic == pTelemetryCharacteristic ? BLE_SUBSCRIBE_TELEMETRY : BLE_SUBSCRIBE_RESPONSE;
+}
+
+bool BluetoothManager::sendNotification(BLECharacteristic* characteristic, uint16_t connId,
+                                        const uint8_t* data, size_t length) {
+    esp_err_t result = esp_ble_gatts_send_indicate((esp_gatt_if_t)pServer->getGattsIf(), connId,
+                                                   characteristic->getHandle(), length,
+                                                   const_cast<uint8_t*>(data), false);
+    return result == ESP_OK;
+}
+
+bool BluetoothManager::sendFitted(BLECharacteristic* characteristic, uint16_t connId, uint16_t mtu,
+                                  const uint8_t* data, size_t length) {
+    // 스택은 MTU-3보다 긴 알림을 보내지 않으므로 연결의 MTU에 맞춰 전송
+    size_t payload = mtu > 3 ? mtu - 3 : 0;
+    if (length <= payload) {
+        return sendNotification(characteristic, connId, data, length);
+    }
+    // 텔레메트리 프레임은 쪼개면 디코딩할 수 없음 - 실패로 알림 (프레임 크기는 getMaxPayload()로 맞춤)
+    if (characteristic == pTelemetryCharacteristic || payload == 0) {
+        return false;
+    }
+    // 텍스트 응답은 MTU 크기 조각으로 순서대로 전송 (클라이언트는 이어 붙여 읽음)
+    bool sent = true;
+    for (size_t pos = 0; pos < length; pos += payload) {
+        size_t chunk = min(payload, length - pos);
+        if (!sendNotification(characteristic, connId, data + pos, chunk)) {
+            sent = false;
+            break;
+        }
+    }
+    return sent;
+}
+
+bool BluetoothManager::notifyConnection(BLECharacteristic* characteristic, uint16_t connId,
+                                        const uint8_t* data, size_t length) {
+    // 스택 API는 CCCD를 확인하지 않으므로 구독하지 않은 클라이언트에는 보내지 않음
+    uint8_t bit = subscriptionBit(characteristic);
+    portENTER_CRITICAL(&connectionLock);
+    int slot = findConnection(connId);
+    bool subscribed = slot >= 0 && (connections[slot].subscriptions & bit);
+    uint16_t mtu = slot >= 0 ? connections[slot].linkInfo.mtu : 23;
+    portEXIT_CRITICAL(&connectionLock);
+    
+    if (!subscribed) return false;
+    return sendFitted(characteristic, connId, mtu, data, length);
+}
+
+bool BluetoothManager::notifyAll(BLECharacteristic* characteristic, const uint8_t* data, size_t length) {
+    // 연결 목록만 잠금 안에서 복사하고 전송은 잠금 밖에서 수행
+    uint16_t targets[BLE_MAX_CONNECTIONS];
+    uint16_t targetMtu[BLE_MAX_CONNECTIONS];
+    uint8_t targetCount = 0;
+    uint8_t bit = subscriptionBit(characteristic);
+    
+    portENTER_CRITICAL(&connectionLock);
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (connections[i].used && (connections[i].subscriptions & bit)) {
+            targets[targetCount] = connections[i].connId;
+            targetMtu[targetCount] = connections[i].linkInfo.mtu;
+            targetCount++;
+        }
+    }
+    portEXIT_CRITICAL(&connectionLock);
+    
+    // 구독한 연결 중 하나라도 전체를 받지 못하면 실패로 보고
+    bool sent = targetCount > 0;
+    for (uint8_t i = 0; i < targetCount; i++) {
+        if (!sendFitted(characteristic, targets[i], targetMtu[i], data, length)) {
+            sent = false;
+        }
+    }
+    return sent;
+}
+
+uint16_t BluetoothManager::getLastAppliedSequence() const {
+    return lastAppliedSequence;
+}
+
+void BluetoothManager::acknowledgeSequence(uint16_t sequence) {
+    // 개별 응답 대신 누적 ACK 갱신 (텔레메트리 프레임에 실려 전송됨)
+    lastAppliedSequence = sequence;
+}
+
+size_t BluetoothManager::getMaxNotifyPayload() const {
+    // 모든 연결이 받을 수 있도록 가장 작은 ATT MTU에서 알림 헤더(3바이트)를 뺀 크기
+    uint16_t mtu = 0;
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (connections[i].used && (mtu == 0 || connections[i].linkInfo.mtu < mtu)) {
+            mtu = connections[i].linkInfo.mtu;
+        }
+    }
+    if (mtu == 0) mtu = 23;
+    return mtu > 3 ? mtu - 3 : 0;
+}
+
+int BluetoothManager::findConnection(uint16_t connId) const {
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (connections[i].used && connections[i].connId == connId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int BluetoothManager::findConnectionByAddress(const esp_bd_addr_t address) const {
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (connections[i].used && memcmp(connections[i].address, address, sizeof(esp_bd_addr_t)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int BluetoothManager::findDriver() const {
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (connections[i].used && connections[i].role == BLE_ROLE_DRIVER) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool BluetoothManager::isDriver(uint16_t connId) const {
+    int slot = findConnection(connId);
+    return slot >= 0 && connections[slot].role == BLE_ROLE_DRIVER;
+}
+
+void BluetoothManager::setLinkProfile(BleLinkProfile profile) {
+    linkProfile = profile;
+    LOG_TEXT(LOG_BLE_LINK_PROFILE_SET, LINK_PROFILES[linkProfile].name);
+    
+    int driver = findDriver();
+    if (driver >= 0) {
+        applyLinkProfile(driver);
+    }
+}
+
+BleLinkProfile BluetoothManager::getLinkProfile() const {
+    return linkProfile;
+}
+
+const BleLinkInfo& BluetoothManager::getLinkInfo() const {
+    int driver = findDriver();
+    return driver >= 0 ? connections[driver].linkInfo : idleLinkInfo;
+}
+
+String BluetoothManager::getLinkInfoString() const {
+    // 운전자 연결 기준
+    // 예: "link:latency mtu:247 int:7.50ms lat:0 to:4000ms phy:2M/2M dle:251/251 clients:2/3"
+    const BleLinkInfo& linkInfo = getLinkInfo();
+    String info = "link:";
+    info += LINK_PROFILES[linkProfile].name;
+    info += " mtu:";
+    info += linkInfo.mtu;
+    info += " int:";
+    info += String(linkInfo.connInterval * 1.25f);
+    info += "ms lat:";
+    info += linkInfo.slaveLatency;
+    info += " to:";
+    info += (unsigned long)linkInfo.supervisionTimeout * 10;
+    info += "ms phy:";
+    info += linkInfo.txPhy == ESP_BLE_GAP_PHY_2M ? "2M" : "1M";
+    info += "/";
+    info += linkInfo.rxPhy == ESP_BLE_GAP_PHY_2M ? "2M" : "1M";
+    info += " dle:";
+    info += linkInfo.txDataLength;
+    info += "/";
+    info += linkInfo.rxDataLength;
+    info += " clients:";
+    info += connectionCount;
+    info += "/";
+    info += BLE_MAX_CONNECTIONS;
+    return info;
+}
+
+String BluetoothManager::getConnectionsString() const {
+    // 예: "clients:2/3 [0]driver mtu:247 [1]observer mtu:185 rejected:0"
+    String info = "clients:";
+    info += connectionCount;
+    info += "/";
+    info += BLE_MAX_CONNECTIONS;
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (!connections[i].used) continue;
+        info += " [";
+        info += connections[i].connId;
+        info += "]";
+        info += connections[i].role == BLE_ROLE_DRIVER ? "driver" : "observer";
+        info += " mtu:";
+        info += connections[i].linkInfo.mtu;
+    }
+    info += " rejected:";
+    info += rejectedWrites;
+    info += " ";
+    info += getAdvertisingString();
+    return info;
+}
+
+bool BluetoothManager::startBenchmark(int count) {
+    if (!hasDriver()) {
+        LOG(LOG_BLE_BENCH_NO_DRIVER);
+        return false;
+    }
+    if (count <= 0 || count > BLE_BENCHMARK_MAX_COUNT) {
+        count = BLE_BENCHMARK_DEFAULT_COUNT;
+    }
+    
+    benchmarkTotal = count;
+    benchmarkIndex = 0;
+    benchmarkMin = 0xFFFFFFFF;
+    benchmarkMax = 0;
+    benchmarkSum = 0;
+    
+    LOG(LOG_BLE_BENCH_START, count);
+    sendBenchmarkProbe();
+    return true;
+}
+
+void BluetoothManager::sendBenchmarkProbe() {
+    // 운전자 클라이언트는 "rtt:<n>"을 그대로 write로 되돌려 보낸다
+    int driver = findDriver();
+    if (driver < 0) {
+        benchmarkTotal = 0;
+        return;
+    }
+    String probe = "rtt:" + String(benchmarkIndex);
+    benchmarkSentAt = micros();
+    notifyConnection(pCharacteristic, connections[driver].connId, (const uint8_t*)probe.c_str(), probe.length());
+}
+
+void BluetoothManager::handleBenchmarkEcho(const String& message) {
+    unsigned long rtt = micros() - benchmarkSentAt;
+    
+    if (benchmarkTotal == 0 || message.substring(4).toInt() != benchmarkIndex) {
+        LOG(LOG_BLE_BENCH_STALE);
+        return;
+    }
+    
+    if (rtt < benchmarkMin) benchmarkMin = rtt;
+    if (rtt > benchmarkMax) benchmarkMax = rtt;
+    benchmarkSum += rtt;
+    benchmarkIndex++;
+    
+    if (benchmarkIndex < benchmarkTotal) {
+        sendBenchmarkProbe();
+        return;
+    }
+    
+    // 결과: "bench:latency n:20 min:9012us avg:14230us max:22110us"
+    String result = "bench:";
+    result += LINK_PROFILES[linkProfile].name;
+    result += " n:";
+    result += benchmarkTotal;
+    result += " min:";
+    result += benchmarkMin;
+    result += "us avg:";
+    result += benchmarkSum / benchmarkTotal;
+    result += "us max:";
+    result += benchmarkMax;
+    result += "us";
+    benchmarkTotal = 0;
+    sendMessage(result);
+}
+
+void BluetoothManager::applyLinkProfile(int slot) {
+    // 관찰자는 텔레메트리만 받으므로 운전자 연결의 에어타임을 뺏지 않도록 balanced 고정
+    // 스택 요청은 잠금 밖에서 하므로 필요한 값만 잠금 안에서 복사
+    esp_bd_addr_t address;
+    portENTER_CRITICAL(&connectionLock);
+    if (!connections[slot].used) {
+        portEXIT_CRITICAL(&connectionLock);
+        return;
+    }
+    BleLinkProfile profile = connections[slot].role == BLE_ROLE_DRIVER ? linkProfile : LINK_PROFILE_BALANCED;
+    uint16_t connId = connections[slot].connId;
+    memcpy(address, connections[slot].address, sizeof(esp_bd_addr_t));
+    pendingDataLengthSlot = slot;
+    portEXIT_CRITICAL(&connectionLock);
+    const LinkProfileParams& params = LINK_PROFILES[profile];
+    
+    LOG_TEXT(LOG_BLE_LINK_PROFILE_APPLY, params.name, connId);
+    
+    // 연결 간격 요청 (최종 값은 central이 결정)
+    pServer->updateConnParams(address, params.minInterval, params.maxInterval,
+                              params.slaveLatency, BLE_SUPERVISION_TIMEOUT);
+                              
+    // LE 2M PHY 요청 (지원하지 않는 central은 1M 유지)
+    esp_ble_gap_phy_mask_t phyMask = params.prefer2MPhy
+        ? ESP_BLE_GAP_PHY_2M_PREF_MASK
+        : (ESP_BLE_GAP_PHY_1M_PREF_MASK | ESP_BLE_GAP_PHY_2M_PREF_MASK);
+    if (esp_ble_gap_set_preferred_phy(address, 0, phyMask, phyMask, ESP_BLE_GAP_PHY_OPTIONS_NO_PREF) != ESP_OK) {
+        LOG(LOG_BLE_PHY_UNSUPPORTED);
+    }
+    
+    // Data Length Extension 요청 (완료 이벤트는 pendingDataLengthSlot에 반영)
+    if (esp_ble_gap_set_pkt_data_len(address, BLE_PREFERRED_DATA_LEN) != ESP_OK) {
+        LOG(LOG_BLE_DLE_UNSUPPORTED);
+    }
+}
+
+void BluetoothManager::onConnect(esp_ble_gatts_cb_param_t* param) {
+    // 빈 슬롯에 등록 (운전자가 없으면 새 연결이 운전자)
+    bool driver = false;
+    portENTER_CRITICAL(&connectionLock);
+    int slot = -1;
+    for (int i = 0; i < BLE_MAX_CONNECTIONS; i++) {
+        if (!connections[i].used) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot >= 0) {
+        BleConnection& connection = connections[slot];
+        connection.role = findDriver() < 0 ? BLE_ROLE_DRIVER : BLE_ROLE_OBSERVER;
+        connection.subscriptions = 0;
+        connection.connId = param->connect.conn_id;
+        memcpy(connection.address, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+        connection.addressType = connectAddressType(param);
+        memset(&connection.linkInfo, 0, sizeof(connection.linkInfo));
+        connection.linkInfo.mtu = 23;
+        connection.linkInfo.txPhy = ESP_BLE_GAP_PHY_1M;
+        connection.linkInfo.rxPhy = ESP_BLE_GAP_PHY_1M;
+        connection.linkInfo.txDataLength = 27;
+        connection.linkInfo.rxDataLength = 27;
+        connection.used = true;
+        connectionCount++;
+        driver = connection.role == BLE_ROLE_DRIVER;
+    }
+    portEXIT_CRITICAL(&connectionLock);
+    
+    if (slot < 0) {
+        // 스택 연결 수가 테이블보다 큰 경우 - 받아들이지 않음
+        LOG(LOG_BLE_TABLE_FULL);
+        pServer->disconnect(param->connect.conn_id);
+        connectPending = true;
+        return;
+    }
+    
+    if (ledEffects) {
+        ledEffects->setBaseLevel(true);
+    }
+    if (driver) {
+        // 누적 ACK는 운전자 연결마다 새로 시작
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+    }
+    LOG_TEXT(LOG_BLE_CONNECTED, driver ? "driver" : "observer", param->connect.conn_id);
+    
+    applyLinkProfile(slot);
+    
+    // 운전자 재연결 시간 측정 (광고 단계는 아직 바뀌기 전이므로 어느 단계에서 붙었는지 기록)
+    if (driver && reconnectPending) {
+        reconnectPending = false;
+        lastReconnectMs = millis() - disconnectedAt;
+        lastReconnectPhase = advertisingPhase;
+        reconnectCount++;
+        LOG_TEXT(LOG_BLE_RECONNECTED, phaseToString(lastReconnectPhase), lastReconnectMs);
+    }
+    
+    // 연결이 생기면 스택이 광고를 멈추므로 통신 태스크에서 다음 단계 결정
+    // (연결 성공 메시지는 클라이언트가 응답 알림을 구독할 때 onCccdWritten()에서 전송)
+    connectPending = true;
+}
+
+void BluetoothManager::onDisconnect(uint16_t connId) {
+    portENTER_CRITICAL(&connectionLock);
+    int slot = findConnection(connId);
+    bool wasDriver = false;
+    if (slot >= 0) {
+        wasDriver = connections[slot].role == BLE_ROLE_DRIVER;
+        if (wasDriver) {
+            memcpy(lastDriverAddress, connections[slot].address, sizeof(esp_bd_addr_t));
+            lastDriverAddressType = connections[slot].addressType;
+            hasLastDriver = true;
+        }
+        connections[slot].used = false;
+        connectionCount--;
+        if (pendingDataLengthSlot == slot) pendingDataLengthSlot = -1;
+    }
+    portEXIT_CRITICAL(&connectionLock);
+    
+    if (wasDriver) {
+        // 관찰자를 자동 승격하지 않음 - 모니터링 노트북이 갑자기 조종권을 갖지 않도록
+        benchmarkTotal = 0;
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        disconnectedAt = millis();
+        reconnectPending = true;
+        LOG(LOG_BLE_DRIVER_LEFT);
+    }
+    disconnectPending = true;
+    LOG(LOG_BLE_DISCONNECTED, connId);
+}
+
+void BluetoothManager::onMtuChanged(uint16_t connId, uint16_t mtu) {
+    portENTER_CRITICAL(&connectionLock);
+    int slot = findConnection(connId);
+    if (slot >= 0) {
+        connections[slot].linkInfo.mtu = mtu;
+    }
+    portEXIT_CRITICAL(&connectionLock);
+    LOG(LOG_BLE_MTU, mtu, connId);
+}
+
+void BluetoothManager::handleRoleCommand(const String& message, uint16_t connId) {
+    // "role" - 조회, "role:driver" - 비어 있는 운전자 자리 요청, "role:observer" - 운전자 자리 반납
+    // 역할 확인과 변경은 한 임계 구역에서 수행 (다른 연결의 요청/연결 해제와 경합 방지)
+    bool taken = false;
+    bool released = false;
+    bool occupied = false;
+    BleConnectionRole role = BLE_ROLE_OBSERVER;
+    
+    portENTER_CRITICAL(&connectionLock);
+    int slot = findConnection(connId);
+    if (slot >= 0) {
+        BleConnection& connection = connections[slot];
+        if (message == "role:driver") {
+            int driver = findDriver();
+            if (driver < 0) {
+                connection.role = BLE_ROLE_DRIVER;
+                taken = true;
+            } else {
+                occupied = driver != slot;
+            }
+        } else if (message == "role:observer" && connection.role == BLE_ROLE_DRIVER) {
+            connection.role = BLE_ROLE_OBSERVER;
+            released = true;
+        }
+        role = connection.role;
+    }
+    portEXIT_CRITICAL(&connectionLock);
+    
+    if (slot < 0) return;
+    
+    if (taken) {
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        LOG(LOG_BLE_ROLE_TAKEN, connId);
+        applyLinkProfile(slot);
+    } else if (occupied) {
+        LOG(LOG_BLE_ROLE_OCCUPIED);
+    } else if (released) {
+        benchmarkTotal = 0;
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        LOG(LOG_BLE_ROLE_RELEASED, connId);
+        applyLinkProfile(slot);
+    }
     
-    // 명령 처리기에 메시지 전달
-    if (commandProcessor) {
-        Serial.println("Processing command...");
-        commandProcessor->processCommand(message);
+    String reply = "role:";
+    reply += role == BLE_ROLE_DRIVER ? "driver " : "observer ";
+    reply += getConnectionsString();
+    notifyConnection(pCharacteristic, connId, (const uint8_t*)reply.c_str(), reply.length());
+}
+
+void BluetoothManager::onCccdWritten(uint16_t connId, uint16_t handle, const uint8_t* value, uint16_t length) {
+    // BLE2902는 값을 하나만 저장하므로 연결별 구독 상태는 쓰기 이벤트에서 직접 기록
+    uint8_t bit;
+    if (responseCccd && handle == responseCccd->getHandle()) {
+        bit = BLE_SUBSCRIBE_RESPONSE;
+    } else if (telemetryCccd && handle == telemetryCccd->getHandle()) {
+        bit = BLE_SUBSCRIBE_TELEMETRY;
     } else {
-        Serial.println("Warning: No command processor set!");
+        return;
+    }
+    if (length != 2) return;
+    bool enable = (value[0] & 0x01) != 0;  // 비트0: notify (indicate는 사용하지 않음)
+    
+    portENTER_CRITICAL(&connectionLock);
+    int slot = findConnection(connId);
+    bool greet = false;
+    bool driver = false;
+    if (slot >= 0) {
+        BleConnection& connection = connections[slot];
+        greet = enable && bit == BLE_SUBSCRIBE_RESPONSE && !(connection.subscriptions & bit);
+        driver = connection.role == BLE_ROLE_DRIVER;
+        if (enable) {
+            connection.subscriptions |= bit;
+        } else {
+            connection.subscriptions &= ~bit;
+        }
     }
+    portEXIT_CRITICAL(&connectionLock);
     
-    // 응답 전송
-    String response = "Received: " + message;
-    sendMessage(response);
+    // 연결 성공 메시지는 응답 알림을 처음 구독한 연결에만 전송
+    if (greet) {
+        String greeting = driver ? "Connected to Mecanum Robot (driver)" : "Connected to Mecanum Robot (observer)";
+        notifyConnection(pCharacteristic, connId, (const uint8_t*)greeting.c_str(), greeting.length());
+    }
+}
+
+void BluetoothManager::gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf,
+                                         esp_ble_gatts_cb_param_t* param) {
+    // 라이브러리 디스크립터 처리보다 먼저 호출됨 - CCCD 쓰기만 확인
+    if (!instance || event != ESP_GATTS_WRITE_EVT || param->write.is_prep) return;
+    instance->onCccdWritten(param->write.conn_id, param->write.handle, param->write.value, param->write.len);
+}
+
+void BluetoothManager::gapEventHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t* param) {
+    if (!instance) return;
+    // BLE 태스크에서 호출되므로 연결 테이블 갱신은 조회 태스크와 같은 임계 구역에서 수행
+    BleConnection* connections = instance->connections;
+    portMUX_TYPE* lock = &instance->connectionLock;
+    int slot;
+    
+    switch (event) {
+        case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+            if (param->update_conn_params.status != ESP_BT_STATUS_SUCCESS) break;
+            portENTER_CRITICAL(lock);
+            slot = instance->findConnectionByAddress(param->update_conn_params.bda);
+            if (slot >= 0) {
+                BleLinkInfo& info = connections[slot].linkInfo;
+                info.connInterval = param->update_conn_params.conn_int;
+                info.slaveLatency = param->update_conn_params.latency;
+                info.supervisionTimeout = param->update_conn_params.timeout;
+            }
+            portEXIT_CRITICAL(lock);
+            break;
+        case ESP_GAP_BLE_PHY_UPDATE_COMPLETE_EVT:
+            if (param->phy_update.status != ESP_BT_STATUS_SUCCESS) break;
+            portENTER_CRITICAL(lock);
+            slot = instance->findConnectionByAddress(param->phy_update.bda);
+            if (slot >= 0) {
+                BleLinkInfo& info = connections[slot].linkInfo;
+                info.txPhy = param->phy_update.tx_phy;
+                info.rxPhy = param->phy_update.rx_phy;
+            }
+            portEXIT_CRITICAL(lock);
+            break;
+        case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT:
+            if (param->pkt_data_length_cmpl.status != ESP_BT_STATUS_SUCCESS) break;
+            portENTER_CRITICAL(lock);
+            slot = instance->pendingDataLengthSlot;
+            if (slot >= 0 && connections[slot].used) {
+                BleLinkInfo& info = connections[slot].linkInfo;
+                info.txDataLength = param->pkt_data_length_cmpl.params.tx_len;
+                info.rxDataLength = param->pkt_data_length_cmpl.params.rx_len;
+            }
+            portEXIT_CRITICAL(lock);
+            break;
+        default:
+            break;
+    }
+}
+
+void BluetoothManager::onMessageReceived(const String& message, uint32_t rxCycles, uint16_t connId) {
+    receivedMessage = message;
+    LOG_TEXT(LOG_BLE_RECEIVED, message.c_str(), connId);
+    
+    // 역할 요청은 연결별 상태이므로 큐를 거치지 않고 여기서 처리
+    if (message == "role" || message.startsWith("role:")) {
+        handleRoleCommand(message, connId);
+        return;
+    }
+    
+    // 관찰자는 텔레메트리 수신 전용 - 명령은 폐기
+    if (!isDriver(connId)) {
+        rejectedWrites++;
+        const char* reply = "role:observer read-only";
+        notifyConnection(pCharacteristic, connId, (const uint8_t*)reply, strlen(reply));
+        return;
+    }
+    
+    // 벤치마크 에코는 명령 처리/디스플레이를 거치지 않고 즉시 처리
+    if (message.startsWith("rtt:")) {
+        handleBenchmarkEcho(message);
+        return;
+    }
+    
+    // BLE 콜백에서는 큐에 넣기만 하고 처리는 통신 태스크에서 수행
+    if (!commandQueue) {
+        LOG(LOG_BLE_NO_QUEUE);
+        return;
+    }
+    if (!commandQueue->push(COMMAND_SOURCE_BLE, this, message.c_str(), message.length(), rxCycles)) {
+        LOG(LOG_BLE_QUEUE_FULL);
+    }
+}
+
+void BluetoothManager::onStreamCommandReceived(CommandMessage& message, uint16_t connId) {
+    // 응답 없는 쓰기라 거부 응답 없이 폐기 (연결 상태는 "role" 조회로 확인)
+    if (!isDriver(connId)) {
+        rejectedWrites++;
+        return;
+    }
+    if (!commandQueue || !commandQueue->push(message)) {
+        LOG(LOG_BLE_STREAM_QUEUE_FULL);
+    }
 }
 
 // ServerCallbacks 구현
 ServerCallbacks::ServerCallbacks(BluetoothManager* manager) : btManager(manager) {
-    Serial.println("ServerCallbacks constructor called");
+    LOG_TEXT(LOG_BLE_SETUP, "ServerCallbacks constructor called");
 }
 
-void ServerCallbacks::onConnect(BLEServer* pServer) {
-    Serial.println("ServerCallbacks::onConnect called");
+void ServerCallbacks::onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+    LOG_TEXT(LOG_BLE_SERVER_EVENT, "onConnect");
     if (btManager) {
-        btManager->onConnect();
+        btManager->onConnect(param);
     } else {
-        Serial.println("Warning: btManager is null in onConnect!");
+        LOG_TEXT(LOG_BLE_NULL_MANAGER, "onConnect");
     }
 }
 
-void ServerCallbacks::onDisconnect(BLEServer* pServer) {
-    Serial.println("ServerCallbacks::onDisconnect called");
+void ServerCallbacks::onDisconnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+    LOG_TEXT(LOG_BLE_SERVER_EVENT, "onDisconnect");
     if (btManager) {
-        btManager->onDisconnect();
+        btManager->onDisconnect(param->disconnect.conn_id);
     } else {
-        Serial.println("Warning: btManager is null in onDisconnect!");
+        LOG_TEXT(LOG_BLE_NULL_MANAGER, "onDisconnect");
+    }
+}
+
+void ServerCallbacks::onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+    if (btManager) {
+        btManager->onMtuChanged(param->mtu.conn_id, param->mtu.mtu);
     }
 }
 
 // CharacteristicCallbacks 구현
 CharacteristicCallbacks::CharacteristicCallbacks(BluetoothManager* manager) : btManager(manager) {
-    Serial.println("CharacteristicCallbacks constructor called");
+    LOG_TEXT(LOG_BLE_SETUP, "CharacteristicCallbacks constructor called");
 }
 
-void CharacteristicCallbacks::onWrite(BLECharacteristic* pCharacteristic) {
-    Serial.println("CharacteristicCallbacks::onWrite called");
+void CharacteristicCallbacks::onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) {
+    PROFILE_SCOPE(PROFILE_BLE_WRITE);
+    uint32_t rxCycles = LatencyTracker::now();
+    LOG(LOG_BLE_WRITE);
     std::string value = pCharacteristic->getValue();
     
     if (value.length() > 0) {
@@ -196,13 +994,51 @@ void CharacteristicCallbacks::onWrite(BLECharacteristic* pCharacteristic) {
             for (int i = 0; i < value.length(); i++) {
                 message += value[i];
             }
-            Serial.print("Received value: ");
-            Serial.println(message);
-            btManager->onMessageReceived(message);
+            LOG_TEXT(LOG_BLE_WRITE_VALUE, message.c_str());
+            btManager->onMessageReceived(message, rxCycles, param->write.conn_id);
         } else {
-            Serial.println("Warning: btManager is null in onWrite!");
+            LOG(LOG_BLE_NO_MANAGER);
         }
     } else {
-        Serial.println("Warning: Received empty value in onWrite!");
+        LOG(LOG_BLE_WRITE_EMPTY);
+    }
+}
+
+// CommandStreamCallbacks 구현
+CommandStreamCallbacks::CommandStreamCallbacks(BluetoothManager* manager) : btManager(manager) {
+    LOG_TEXT(LOG_BLE_SETUP, "CommandStreamCallbacks constructor called");
+}
+
+void CommandStreamCallbacks::onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) {
+    PROFILE_SCOPE(PROFILE_BLE_STREAM_WRITE);
+    uint32_t rxCycles = LatencyTracker::now();
+    std::string value = pCharacteristic->getValue();
+    
+    // 시퀀스 번호(2바이트) + 클라이언트 시각(4바이트) + 최소 1바이트 명령
+    const size_t headerSize = 6;
+    if (value.length() <= headerSize) {
+        LOG(LOG_BLE_STREAM_INVALID);
+        return;
+    }
+    
+    if (btManager) {
+        const uint8_t* data = (const uint8_t*)value.data();
+        CommandMessage message;
+        message.source = COMMAND_SOURCE_BLE_STREAM;
+        message.transport = btManager;
+        message.sequence = data[0] | (data[1] << 8);
+        message.hasSequence = message.sequence != COMMAND_SEQUENCE_NONE;
+        message.clientTime = (uint32_t)data[2] | ((uint32_t)data[3] << 8) |
+                             ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+        message.rxCycles = rxCycles;
+        
+        size_t length = value.length() - headerSize;
+        message.overLength = length > COMMAND_MAX_LENGTH;
+        if (message.overLength) length = COMMAND_MAX_LENGTH;
+        memcpy(message.text, data + headerSize, length);
+        message.text[length] = '\0';
+        message.length = length;
+        
+        btManager->onStreamCommandReceived(message, param->write.conn_id);
     }
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "BootSequencer.h"
+
+BootSequencer::BootSequencer()
+    : backgroundTask(nullptr), backgroundFunction(nullptr), backgroundArg(nullptr) {
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        stageUs[i] = 0;
+    }
+}
+
+void BootSequencer::mark(BootStage stage) {
+    if (stage >= BOOT_STAGE_COUNT || stageUs[stage] != 0) return;
+    
+    uint32_t nowUs = micros();
+    stageUs[stage] = nowUs > 0 ? nowUs : 1;
+    
+    Serial.print("[boot] ");
+    Serial.print(stageToString(stage));
+    Serial.print(" at ");
+    Serial.print(nowUs / 1000);
+    Serial.println("ms");
+}
+
+bool BootSequencer::isReached(BootStage stage) const {
+    return stage < BOOT_STAGE_COUNT && stageUs[stage] != 0;
+}
+
+uint32_t BootSequencer::getStageUs(BootStage stage) const {
+    return stage < BOOT_STAGE_COUNT ? stageUs[stage] : 0;
+}
+
+bool BootSequencer::runInBackground(BootStageFunction function, void* arg) {
+    if (!function || backgroundTask) return false;
+    
+    backgroundFunction = function;
+    backgroundArg = arg;
+    if (xTaskCreate(backgroundTaskEntry, "boot", BOOT_TASK_STACK_SIZE, this, BOOT_TASK_PRIORITY, &backgroundTask) != pdPASS) {
+        Serial.println("Failed to create boot task, running background stage inline");
+        backgroundTask = nullptr;
+        function(arg);
+        mark(BOOT_STAGE_BACKGROUND_DONE);
+        return false;
+    }
+    return true;
+}
+
+void BootSequencer::backgroundTaskEntry(void* arg) {
+    BootSequencer* sequencer = static_cast<BootSequencer*>(arg);
+    sequencer->backgroundFunction(sequencer->backgroundArg);
+    sequencer->mark(BOOT_STAGE_BACKGROUND_DONE);
+    
+    // 한 번만 실행되는 태스크 (핸들은 실행 여부 확인용으로 남겨 둠)
+    vTaskDelete(nullptr);
+}
+
+void BootSequencer::printSummary() const {
+    Serial.print("Boot: advertising at ");
+    Serial.print(stageUs[BOOT_STAGE_ADVERTISING] / 1000);
+    Serial.print("ms, accepting commands at ");
+    Serial.print(stageUs[BOOT_STAGE_SETUP_DONE] / 1000);
+    Serial.println("ms (display/LED continue in background)");
+}
+
+String BootSequencer::getStatusString() const {
+    // 예: "boot: serial:31ms i2c:38ms motors:41ms queue:43ms adv:212ms setup:265ms background:1390ms first_cmd:4120ms"
+    String status = "boot:";
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        status += " ";
+        status += stageToString(static_cast<BootStage>(i));
+        status += ":";
+        if (stageUs[i] == 0) {
+            status += "-";
+        } else {
+            status += stageUs[i] / 1000;
+            status += "ms";
+        }
+    }
+    return status;
+}
+
+const char* BootSequencer::stageToString(BootStage stage) {
+    switch (stage) {
+        case BOOT_STAGE_SERIAL: return "serial";
+        case BOOT_STAGE_I2C: return "i2c";
+        case BOOT_STAGE_MOTORS_SAFE: return "motors";
+        case BOOT_STAGE_COMMAND_PATH: return "queue";
+        case BOOT_STAGE_ADVERTISING: return "adv";
+        case BOOT_STAGE_SETUP_DONE: return "setup";
+        case BOOT_STAGE_BACKGROUND_DONE: return "background";
+        case BOOT_STAGE_FIRST_COMMAND: return "first_cmd";
+        default: return "unknown";
+    }
+}
\ No newline at end of file
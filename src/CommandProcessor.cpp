@@ -2,12 +2,30 @@
 #include "MotorController.h"
 #include "EncoderManager.h"
 #include "DisplayManager.h"
+#include "TelemetryManager.h"
+#include "BluetoothManager.h"
+#include "MacroManager.h"
+#include "TransportManager.h"
+#include "EspNowTransport.h"
+#include "FleetReceiver.h"
+#include "KeepaliveMonitor.h"
+#include "ParameterRegistry.h"
+#include "LedEffectEngine.h"
+#include "I2cBusScheduler.h"
+#include "I2cWorker.h"
+#include "I2cHealthMonitor.h"
+#include "BootSequencer.h"
+#include "TaskMonitor.h"
+#include "ControlLoop.h"
+#include "Logger.h"
+#include "Profiler.h"
 
 CommandProcessor::CommandProcessor() 
-    : motorController(nullptr), encoderManager(nullptr), displayManager(nullptr), isAutoMode(false) {
-}
-
-CommandProcessor::~CommandProcessor() {
+    : motorController(nullptr), encoderManager(nullptr), displayManager(nullptr), telemetryManager(nullptr),
+      bluetoothManager(nullptr), latencyTracker(nullptr), commandScheduler(nullptr), macroManager(nullptr), transportManager(nullptr),
+      espNowTransport(nullptr), fleetReceiver(nullptr), keepaliveMonitor(nullptr), parameterRegistry(nullptr), ledEffects(nullptr), i2cBus(nullptr), i2cWorker(nullptr), i2cHealth(nullptr),
+      bootSequencer(nullptr), taskMonitor(nullptr), controlLoop(nullptr), isAutoMode(false), commandRejected(false) {
+    memset(&currentTrace, 0, sizeof(currentTrace));
 }
 
 void CommandProcessor::setMotorController(MotorController* controller) {
@@ -22,19 +40,259 @@ void CommandProcessor::setDisplayManager(DisplayManager* display) {
     displayManager = display;
 }
 
+void CommandProcessor::setTelemetryManager(TelemetryManager* manager) {
+    telemetryManager = manager;
+}
+
+void CommandProcessor::setBluetoothManager(BluetoothManager* manager) {
+    bluetoothManager = manager;
+}
+
+void CommandProcessor::setLatencyTracker(LatencyTracker* tracker) {
+    latencyTracker = tracker;
+}
+
+void CommandProcessor::setCommandScheduler(CommandScheduler* scheduler) {
+    commandScheduler = scheduler;
+}
+
+void CommandProcessor::setMacroManager(MacroManager* manager) {
+    macroManager = manager;
+}
+
+void CommandProcessor::setTransportManager(TransportManager* manager) {
+    transportManager = manager;
+}
+
+void CommandProcessor::setEspNowTransport(EspNowTransport* transport) {
+    espNowTransport = transport;
+}
+
+void CommandProcessor::setFleetReceiver(FleetReceiver* receiver) {
+    fleetReceiver = receiver;
+}
+
+void CommandProcessor::setKeepaliveMonitor(KeepaliveMonitor* monitor) {
+    keepaliveMonitor = monitor;
+}
+
+void CommandProcessor::setParameterRegistry(ParameterRegistry* registry) {
+    parameterRegistry = registry;
+}
+
+void CommandProcessor::setLedEffectEngine(LedEffectEngine* engine) {
+    ledEffects = engine;
+}
+
+void CommandProcessor::setI2cBusScheduler(I2cBusScheduler* scheduler) {
+    i2cBus = scheduler;
+}
+
+void CommandProcessor::setI2cWorker(I2cWorker* worker) {
+    i2cWorker = worker;
+}
+
+void CommandProcessor::setI2cHealthMonitor(I2cHealthMonitor* monitor) {
+    i2cHealth = monitor;
+}
+
+void CommandProcessor::setBootSequencer(BootSequencer* sequencer) {
+    bootSequencer = sequencer;
+}
+
+void CommandProcessor::setTaskMonitor(TaskMonitor* monitor) {
+    taskMonitor = monitor;
+}
+
+void CommandProcessor::setControlLoop(ControlLoop* loop) {
+    controlLoop = loop;
+}
+
+void CommandProcessor::processMessage(const CommandMessage& message) {
+    memset(&currentTrace, 0, sizeof(currentTrace));
+    commandRejected = false;
+    currentTrace.dequeueCycles = LatencyTracker::now();
+    currentTrace.rxCycles = message.rxCycles;
+    currentTrace.hasSequence = message.hasSequence;
+    currentTrace.sequence = message.sequence;
+    currentTrace.clientTime = message.clientTime;
+    
+    String command = message.text;
+    
+    // 시계 오프셋 추정용 ping은 디스플레이 등을 거치지 않고 즉시 응답
+    // "ping:<client_ms>" → "pong:<client_ms>:<robot_us>"
+    uint8_t first = (uint8_t)message.text[0];
+    if (message.overLength) {
+        // 잘린 명령을 실행하면 다른 의미가 될 수 있으므로 거부
+        commandRejected = true;
+        sendResponse("command:too_long max:" + String(COMMAND_MAX_LENGTH));
+    } else if (message.length == 1 && first >= MACRO_TRIGGER_BASE && first < MACRO_TRIGGER_BASE + MACRO_MAX_COUNT) {
+        // 1바이트 매크로 트리거 (0x01 → 매크로 0)
+        runMacro(first - MACRO_TRIGGER_BASE);
+    } else if (command.startsWith("ping:")) {
+        sendResponse("pong:" + command.substring(5) + ":" + String(micros()));
+    } else if (command.startsWith("at:") || command == "schedule" || command.startsWith("schedule:")) {
+        // 예약 명령은 지금 실행하지 않고 제어 틱에 맡김
+        processScheduleCommand(command, message);
+    } else {
+        uint32_t framesBefore = motorController ? motorController->getOutputFrameCount() : 0;
+        if (first == COMMAND_BINARY_MARKER) {
+            processBinaryCommand(message);
+        } else if (first == PARAM_BINARY_MARKER) {
+            processParameterBinary(message);
+        } else {
+            processCommand(command);
+        }
+        
+        // 이 명령이 모터 출력을 바꿨으면 I2C 구간 기록 (제어 태스크가 적용을 마친 뒤 돌아오므로 바로 읽을 수 있음)
+        if (motorController && motorController->getOutputFrameCount() != framesBefore) {
+            currentTrace.i2cStartCycles = motorController->getLastOutputStartCycles();
+            currentTrace.i2cDoneCycles = motorController->getLastOutputEndCycles();
+        }
+    }
+    
+    if (latencyTracker) {
+        latencyTracker->record(currentTrace);
+    }
+    
+    // 부팅 지표: 처음 처리한 명령 시각 (이후 호출은 바로 반환)
+    if (bootSequencer) {
+        bootSequencer->mark(BOOT_STAGE_FIRST_COMMAND);
+    }
+    
+    // 시퀀스가 있는 명령은 적용된 경우에만 받은 경로의 누적 ACK 갱신 (예약 명령은 큐에 들어간 시점)
+    // 거부/알 수 없는 명령은 ACK가 그대로 남으므로 클라이언트는 해당 시퀀스를 적용되지 않은 것으로 본다.
+    if (message.hasSequence && message.transport && !commandRejected) {
+        message.transport->acknowledgeSequence(message.sequence);
+    }
+}
+
+void CommandProcessor::applyIntent(const MotionIntent& intent) {
+    if (!motorController) return;
+    
+    switch (intent.type) {
+        case MOTION_INTENT_BATCH:
+            applyMotionBatch(intent.batch, intent.receivedUs);
+            return;
+        case MOTION_INTENT_MACRO_STOP:
+            if (macroManager) {
+                macroManager->stopMacro();
+            }
+            break;
+        case MOTION_INTENT_KEEPALIVE_ON:
+            if (keepaliveMonitor) {
+                keepaliveMonitor->configure(intent.value0, intent.value1);
+            }
+            return;
+        case MOTION_INTENT_KEEPALIVE_OFF:
+            if (keepaliveMonitor) {
+                keepaliveMonitor->disable();
+            }
+            break;
+        case MOTION_INTENT_OUTPUT_MODE:
+            motorController->setAsyncOutput(intent.value0 != 0);
+            return;
+        case MOTION_INTENT_PWM_FREQUENCY:
+            motorController->applyPwmFrequency();
+            return;
+        case MOTION_INTENT_BENCHMARK:
+            motorController->startBenchmark(intent.value0);
+            return;
+        case MOTION_INTENT_RESYNC_BEGIN:
+            motorController->beginResync();
+            return;
+        case MOTION_INTENT_RESYNC_FINISH:
+            // 매크로/설정값 스트림이 다음 틱에 이전 출력을 되살리지 않도록 함께 해제
+            if (macroManager) {
+                macroManager->cancel();
+            }
+            if (keepaliveMonitor) {
+                keepaliveMonitor->cancel();
+            }
+            motorController->resyncOutput();
+            break;
+        default:
+            return;
+    }
+    
+    // 정지로 끝나는 의도만 여기까지 옴
+    if (displayManager) {
+        displayManager->updateMotorStatus();
+    }
+}
+
+void CommandProcessor::executeScheduled(const ScheduledCommand& command) {
+    memset(&currentTrace, 0, sizeof(currentTrace));
+    
+    // 예약 시점에 해석해 둔 배치를 적용 (수신 메시지 줄은 바꾸지 않음)
+    applyMotionBatch(command.batch, micros());
+}
+
+void CommandProcessor::updateMacros(uint32_t nowUs) {
+    if (!macroManager || !macroManager->isRunning()) return;
+    
+    if (macroManager->update(nowUs) && displayManager) {
+        displayManager->updateMotorStatus();
+    }
+}
+
+void CommandProcessor::updateKeepalive(uint32_t nowUs) {
+    if (!keepaliveMonitor || !keepaliveMonitor->isActive()) return;
+    
+    if (keepaliveMonitor->update(nowUs) && displayManager) {
+        // 설정값 누락으로 정지 완료
+        displayManager->updateMotorStatus();
+    }
+}
+
+void CommandProcessor::updateBenchmark(uint32_t nowUs) {
+    if (motorController && motorController->isBenchmarkRunning()) {
+        motorController->updateBenchmark(nowUs);
+    }
+}
+
+void CommandProcessor::beginMotorResync() {
+    if (!motorController) return;
+    
+    // 발진기 안정화 대기가 레지스터 재설정 뒤부터 시작되도록 적용을 기다림
+    MotionIntent intent;
+    memset(&intent, 0, sizeof(intent));
+    intent.type = MOTION_INTENT_RESYNC_BEGIN;
+    submitIntent(intent);
+}
+
+void CommandProcessor::finishMotorResync() {
+    if (!motorController) return;
+    
+    // 정지 프레임은 제어 태스크가 출력하므로 다른 출력과 섞이지 않음
+    MotionIntent intent;
+    memset(&intent, 0, sizeof(intent));
+    intent.type = MOTION_INTENT_RESYNC_FINISH;
+    submitIntent(intent);
+}
+
 void CommandProcessor::processCommand(const String& command) {
+    PROFILE_SCOPE(PROFILE_PROCESS_COMMAND);
     String cmd = command;  // 복사본 생성
     cmd.trim();           // 복사본 수정
     cmd = toLowerCase(cmd);
     
-    Serial.print("Processing command: ");
-    Serial.println(cmd);
+    LOG_TEXT(LOG_COMMAND_PROCESSING, cmd.c_str());
     
-    // 디스플레이에 수신된 메시지 표시
+    // 디스플레이에 수신된 메시지 표시 (모델만 갱신, 화면 전송은 디스플레이 태스크)
     if (displayManager) {
         displayManager->updateReceivedMessage(command);
     }
     
+    // 해석 완료 시점 기록 (이후는 명령 분기 및 실행)
+    currentTrace.parseCycles = LatencyTracker::now();
+    
+    // 배치 명령 처리 (모든 부분을 해석한 뒤 한 번의 모터 출력으로 적용)
+    if (cmd.indexOf(';') >= 0) {
+        processBatchCommand(cmd);
+        return;
+    }
+    
     // 시스템 명령 처리
     if (processSystemCommand(cmd)) {
         return;
@@ -46,19 +304,18 @@ void CommandProcessor::processCommand(const String& command) {
         return;
     }
     
-    // 이동 명령 처리
-    processMovementCommand(cmd);
-    
-    // 디스플레이 업데이트
-    if (displayManager) {
-        displayManager->updateMotorStatus();
+    // 차체 속도 명령 처리
+    if (cmd.startsWith("vel:")) {
+        processVelocityCommand(cmd);
+    } else {
+        // 이동 명령 처리
+        processMovementCommand(cmd);
     }
 }
 
 void CommandProcessor::setAutoMode(bool autoMode) {
     isAutoMode = autoMode;
-    Serial.print("Auto mode: ");
-    Serial.println(isAutoMode ? "ON" : "OFF");
+    LOG_TEXT(LOG_AUTO_MODE, isAutoMode ? "ON" : "OFF");
 }
 
 bool CommandProcessor::isInAutoMode() const {
@@ -80,6 +337,68 @@ bool CommandProcessor::processSystemCommand(const String& command) {
         }
         return true;
     }
+    else if (command == "display") {
+        if (displayManager) {
+            sendResponse(displayManager->getStatusString());
+        }
+        return true;
+    }
+    else if (command == "tasks" || command == "tasks:reset") {
+        // 태스크별 우선순위/CPU 사용률/스택 여유 ("tasks:reset"은 CPU 집계 구간을 새로 시작)
+        if (taskMonitor) {
+            if (command == "tasks:reset") {
+                taskMonitor->resetStats();
+                sendResponse("tasks:reset");
+            } else {
+                sendResponse(taskMonitor->getStatusString());
+            }
+        }
+        return true;
+    }
+    else if (command == "log" || command.startsWith("log:")) {
+        // "log:text" / "log:bin" - 출력 형식 전환, "log:reset" - 통계 초기화
+        if (command == "log:text") {
+            Logger::setTextOutput(true);
+        } else if (command == "log:bin") {
+            Logger::setTextOutput(false);
+        } else if (command == "log:reset") {
+            Logger::resetStats();
+        }
+        sendResponse(Logger::getStatusString());
+        return true;
+    }
+    else if (command == "profile" || command == "profile:reset" || command == "profile reset") {
+        // 핫패스 구간별 사이클 히스토그램 (BLE 알림 크기를 고려해 구간마다 한 줄씩)
+#if PROFILER_ENABLED
+        if (command != "profile") {
+            Profiler::reset();
+            sendResponse("profile reset");
+        } else {
+            for (int i = 0; i < PROFILE_PROBE_COUNT; i++) {
+                sendResponse(Profiler::getProbeString(static_cast<ProfileProbe>(i)));
+            }
+        }
+#else
+        sendResponse("profile: disabled (PROFILER_ENABLED 0)");
+#endif
+        return true;
+    }
+    else if (command == "boot") {
+        if (bootSequencer) {
+            sendResponse(bootSequencer->getStatusString());
+        }
+        return true;
+    }
+    else if (command == "led") {
+        if (ledEffects) {
+            sendResponse(ledEffects->getStatusString());
+        }
+        return true;
+    }
+    else if (command == "i2c" || command.startsWith("i2c:")) {
+        processI2cCommand(command);
+        return true;
+    }
     else if (command == "reset") {
         if (encoderManager) {
             encoderManager->resetAllEncoders();
@@ -89,69 +408,766 @@ bool CommandProcessor::processSystemCommand(const String& command) {
         }
         return true;
     }
+    else if (command == "telemetry" || command.startsWith("telemetry:")) {
+        processTelemetryCommand(command);
+        return true;
+    }
+    else if (command == "latency" || command.startsWith("latency:")) {
+        processLatencyCommand(command);
+        return true;
+    }
+    else if (command == "transport" || command == "espnow" || command.startsWith("espnow:")) {
+        processTransportCommand(command);
+        return true;
+    }
+    else if (command == "fleet" || command.startsWith("fleet:")) {
+        processFleetCommand(command);
+        return true;
+    }
+    else if (command == "macro" || command.startsWith("macro:")) {
+        processMacroCommand(command);
+        return true;
+    }
+    else if (command == "keepalive" || command.startsWith("keepalive:")) {
+        processKeepaliveCommand(command);
+        return true;
+    }
+    else if (command == "param" || command.startsWith("param:")) {
+        processParameterCommand(command);
+        return true;
+    }
+    else if (command == "link" || command.startsWith("link:") || command == "clients" ||
+             command == "bench" || command.startsWith("bench:")) {
+        processLinkCommand(command);
+        return true;
+    }
     
     return false; // 시스템 명령이 아님
 }
 
 void CommandProcessor::processMovementCommand(const String& command) {
     if (!motorController) {
+        commandRejected = true;
+        Serial.println("Motor controller not available");
+        return;
+    }
+    
+    // 알 수 없는 문자열은 DIR_STOP으로 변환되므로 "stop"은 따로 확인
+    Direction direction = motorController->stringToDirection(command);
+    if (direction == DIR_STOP && command != "stop") {
+        commandRejected = true;
+        LOG_TEXT(LOG_COMMAND_UNKNOWN_MOVE, command.c_str());
+        return;
+    }
+    
+    // 수동 이동 명령은 실행 중인 매크로보다 우선 (설정값 스트림 감시도 해제, applyMotionBatch()에서)
+    MotionBatch batch;
+    CommandCodec::clear(batch);
+    CommandCodec::setDirection(batch, (uint8_t)direction);
+    submitMotion(batch);
+}
+
+void CommandProcessor::processSpeedCommand(const String& command) {
+    if (!motorController) {
+        commandRejected = true;
         Serial.println("Motor controller not available");
         return;
     }
     
-    if (command == "forward") {
-        motorController->moveForward();
+    int speed = extractSpeedValue(command);
+    if (speed < 0) {
+        commandRejected = true;
+        Serial.println("Invalid speed value");
+        return;
     }
-    else if (command == "backward") {
-        motorController->moveBackward();
+    
+    // 작동 중이면 제어 태스크가 현재 방향으로 다시 출력 (속도만 있는 배치와 같음)
+    MotionBatch batch;
+    CommandCodec::clear(batch);
+    CommandCodec::setSpeed(batch, (uint8_t)constrain(speed, 0, 100));
+    submitMotion(batch);
+}
+
+void CommandProcessor::processVelocityCommand(const String& command) {
+    if (!motorController) {
+        commandRejected = true;
+        Serial.println("Motor controller not available");
+        return;
     }
-    else if (command == "left") {
-        motorController->moveLeft();
+    
+    // "vel:<vx>,<vy>,<omega>" (각 -100~100%)
+    int vx, vy, omega;
+    if (sscanf(command.c_str() + 4, "%d,%d,%d", &vx, &vy, &omega) != 3) {
+        commandRejected = true;
+        Serial.println("Invalid velocity command");
+        return;
     }
-    else if (command == "right") {
-        motorController->moveRight();
+    
+    MotionBatch batch;
+    CommandCodec::clear(batch);
+    CommandCodec::setVelocity(batch, constrain(vx, -100, 100), constrain(vy, -100, 100), constrain(omega, -100, 100));
+    submitMotion(batch);
+}
+
+void CommandProcessor::processKeepaliveCommand(const String& command) {
+    if (!keepaliveMonitor) {
+        commandRejected = true;
+        Serial.println("Keepalive monitor not available");
+        return;
     }
-    else if (command == "rotate_left") {
-        motorController->rotateLeft();
+    
+    // "keepalive:<period_ms>[,<misses>]" - 설정값 주기 선언, "keepalive:off" - 해제
+    MotionIntent intent;
+    memset(&intent, 0, sizeof(intent));
+    if (command == "keepalive:off") {
+        intent.type = MOTION_INTENT_KEEPALIVE_OFF;
+        if (!submitIntent(intent)) {
+            commandRejected = true;
+        }
+    } else if (command.startsWith("keepalive:")) {
+        int period = 0;
+        int misses = KEEPALIVE_DEFAULT_MISSES;
+        if (sscanf(command.c_str() + 10, "%d,%d", &period, &misses) < 1 ||
+            !KeepaliveMonitor::isValidConfig(period, misses)) {
+            // int로 범위 검사 (uint16_t로 좁히면 65586 → 50처럼 통과함)
+            commandRejected = true;
+            Serial.println("Invalid keepalive settings");
+        } else {
+            intent.type = MOTION_INTENT_KEEPALIVE_ON;
+            intent.value0 = period;
+            intent.value1 = misses;
+            if (!submitIntent(intent)) {
+                commandRejected = true;
+            }
+        }
     }
-    else if (command == "rotate_right") {
-        motorController->rotateRight();
+    
+    sendResponse(keepaliveMonitor->getStatusString());
+}
+
+void CommandProcessor::processTelemetryCommand(const String& command) {
+    if (!telemetryManager) {
+        Serial.println("Telemetry manager not available");
+        return;
     }
-    else if (command == "diagonal_fl") {
-        motorController->moveDiagonalFL();
+    
+    // "telemetry" - 상태 출력, "telemetry:off" - 중지, "telemetry:50" - 50Hz로 전송
+    if (command == "telemetry:off") {
+        telemetryManager->setRate(0);
+    } else if (command.startsWith("telemetry:")) {
+        int rate = extractSpeedValue(command);
+        if (!telemetryManager->setRate(rate)) {
+            Serial.println("Invalid telemetry rate");
+        }
     }
-    else if (command == "diagonal_fr") {
-        motorController->moveDiagonalFR();
+    
+    sendResponse(telemetryManager->getStatusString());
+}
+
+void CommandProcessor::processLinkCommand(const String& command) {
+    if (!bluetoothManager) {
+        Serial.println("Bluetooth manager not available");
+        return;
     }
-    else if (command == "stop") {
-        motorController->stop();
+    
+    // "bench" / "bench:50" - 현재 프로파일로 왕복 지연 측정 (결과는 완료 시 알림)
+    if (command.startsWith("bench")) {
+        bluetoothManager->startBenchmark(command.startsWith("bench:") ? extractSpeedValue(command) : 0);
+        return;
+    }
+    
+    // "clients" - BLE 연결 테이블 (역할, MTU) 조회
+    if (command == "clients") {
+        sendResponse(bluetoothManager->getConnectionsString());
+        return;
     }
-    else {
-        Serial.print("Unknown movement command: ");
+    
+    // "link" - 협상 결과 조회, "link:latency|balanced|power" - 프로파일 변경
+    if (command == "link:latency") {
+        bluetoothManager->setLinkProfile(LINK_PROFILE_LATENCY);
+    } else if (command == "link:balanced") {
+        bluetoothManager->setLinkProfile(LINK_PROFILE_BALANCED);
+    } else if (command == "link:power") {
+        bluetoothManager->setLinkProfile(LINK_PROFILE_POWER);
+    } else if (command != "link") {
+        Serial.print("Unknown link profile: ");
         Serial.println(command);
     }
+    
+    sendResponse(bluetoothManager->getLinkInfoString());
 }
 
-void CommandProcessor::processSpeedCommand(const String& command) {
-    if (!motorController) {
-        Serial.println("Motor controller not available");
+void CommandProcessor::processTransportCommand(const String& command) {
+    // "espnow:pair" - 페어링 창 열기, "espnow:unpair" - 페어링 해제
+    if (command.startsWith("espnow")) {
+        if (!espNowTransport) {
+            Serial.println("ESP-NOW transport not available");
+            return;
+        }
+        if (command == "espnow:pair") {
+            espNowTransport->startPairing();
+        } else if (command == "espnow:unpair") {
+            espNowTransport->unpair();
+        }
+        sendResponse(espNowTransport->getStatusString());
         return;
     }
     
-    int speed = extractSpeedValue(command);
-    if (speed >= 0) {
-        motorController->setSpeed(speed);
+    // "transport" - 등록된 경로와 활성 상태
+    if (transportManager) {
+        sendResponse(transportManager->getStatusString());
+    }
+}
+
+void CommandProcessor::processFleetCommand(const String& command) {
+    if (!fleetReceiver) {
+        Serial.println("Fleet receiver not available");
+        return;
+    }
+    
+    // "fleet:on|off" - 브로드캐스트 스캔, "fleet:id:<0-31>" - 그룹 마스크의 비트 번호
+    if (command == "fleet:on") {
+        fleetReceiver->setEnabled(true);
+    } else if (command == "fleet:off") {
+        fleetReceiver->setEnabled(false);
+    } else if (command.startsWith("fleet:id:")) {
+        if (!fleetReceiver->setRobotId(command.substring(9).toInt())) {
+            Serial.println("Invalid fleet robot id");
+        }
+    }
+    
+    sendResponse(fleetReceiver->getStatusString());
+}
+
+void CommandProcessor::processLatencyCommand(const String& command) {
+    if (!latencyTracker) {
+        Serial.println("Latency tracker not available");
+        return;
+    }
+    
+    // "latency:reset" - 히스토그램 초기화
+    if (command == "latency:reset") {
+        latencyTracker->reset();
+        sendResponse("latency reset");
+        return;
+    }
+    
+    // "latency" - 단계별 p50/p99/max (BLE 알림 크기를 고려해 단계마다 한 줄씩)
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        sendResponse(latencyTracker->getStageString(static_cast<LatencyStage>(i)));
+    }
+    sendResponse(latencyTracker->getLastTraceString());
+}
+
+void CommandProcessor::processI2cCommand(const String& command) {
+    // "i2c:async" / "i2c:sync" - 모터 프레임 출력 방식
+    if (command == "i2c:async" || command == "i2c:sync") {
+        if (motorController) {
+            // 프레임 도중에 방식이 바뀌지 않도록 제어 태스크에서 전환
+            MotionIntent intent;
+            memset(&intent, 0, sizeof(intent));
+            intent.type = MOTION_INTENT_OUTPUT_MODE;
+            intent.value0 = command == "i2c:async" ? 1 : 0;
+            if (!submitIntent(intent)) {
+                commandRejected = true;
+            }
+            sendResponse(motorController->isAsyncOutput() ? "i2c:async" : "i2c:sync");
+        }
+        return;
+    }
+    
+    // "i2c:bench[:<frames>]" - 모터 프레임당 호출 측 점유 시간 (동기 vs 비동기)
+    if (command == "i2c:bench" || command.startsWith("i2c:bench:")) {
+        if (!motorController) return;
+        int frames = command.length() > 10 ? command.substring(10).toInt() : I2C_BENCHMARK_DEFAULT_FRAMES;
+        if (frames <= 0 || frames > I2C_BENCHMARK_MAX_FRAMES) {
+            sendResponse("i2c:invalid frame count");
+            return;
+        }
         
-        // 현재 모터가 작동 중이면 새 속도로 적용
-        if (motorController->isMotorRunning()) {
-            Direction currentDir = motorController->getCurrentDirection();
-            String dirStr = motorController->directionToString(currentDir);
-            dirStr.toLowerCase();
-            processMovementCommand(dirStr);
+        // 제어 태스크가 틱마다 한 프레임씩 진행 (이 태스크만 결과를 기다리고 제어 틱은 멈추지 않음)
+        MotionIntent intent;
+        memset(&intent, 0, sizeof(intent));
+        intent.type = MOTION_INTENT_BENCHMARK;
+        intent.value0 = frames;
+        if (!submitIntent(intent)) {
+            commandRejected = true;
+            sendResponse("i2c:bench busy");
+            return;
+        }
+        uint32_t timeoutMs = frames * (I2C_BENCHMARK_FRAME_TIMEOUT_US / 1000 + 3) + 100;
+        unsigned long start = millis();
+        while (motorController->isBenchmarkRunning() && millis() - start < timeoutMs) {
+            vTaskDelay(1);
+        }
+        sendResponse(motorController->getBenchmarkResult());
+        return;
+    }
+    
+    // "i2c:recover" - 버스 복구 요청 (loop()에서 단계별로 진행)
+    if (command == "i2c:recover") {
+        if (i2cHealth) {
+            i2cHealth->requestRecovery();
+            sendResponse("i2c:recovering");
+        }
+        return;
+    }
+    
+    // "i2c:reset" - 통계 초기화
+    if (command == "i2c:reset") {
+        if (i2cBus) {
+            i2cBus->resetStats();
+        }
+        if (i2cWorker) {
+            i2cWorker->resetStats();
+        }
+    }
+    
+    // "i2c" - 버스 점유 통계, 비동기 워커 통계, 장치 상태
+    if (i2cBus) {
+        sendResponse(i2cBus->getStatusString());
+    }
+    if (i2cWorker) {
+        sendResponse(i2cWorker->getStatusString());
+    }
+    if (i2cHealth) {
+        sendResponse(i2cHealth->getStatusString());
+    }
+}
+
+void CommandProcessor::processParameterCommand(const String& command) {
+    if (!parameterRegistry) {
+        Serial.println("Parameter registry not available");
+        return;
+    }
+    
+    // "param:save" - NVS 저장 (값을 복사해 두고 UI 루프에서 기록), "param:reset" - 기본값 복원
+    if (command == "param:save") {
+        if (parameterRegistry->save()) {
+            sendResponse("param:saved");
+        } else {
+            commandRejected = true;
+            sendResponse("param:save_failed");
+        }
+        return;
+    }
+    if (command == "param:reset") {
+        parameterRegistry->resetToDefaults();
+        applyParameterChanges();
+        sendResponse("param:reset");
+        return;
+    }
+    
+    // "param:<name>=<value>" - 값 변경
+    int equals = command.indexOf('=');
+    if (command.startsWith("param:") && equals > 6) {
+        const ParameterInfo* info = ParameterRegistry::findByName(command.substring(6, equals));
+        if (!info) {
+            commandRejected = true;
+            sendResponse("param:unknown " + command.substring(6, equals));
+            return;
+        }
+        if (parameterRegistry->set(*info, command.substring(equals + 1).toInt()) != PARAM_STATUS_OK) {
+            commandRejected = true;
+            sendResponse("param:out_of_range " + parameterRegistry->getParameterString(*info));
+            return;
         }
+        applyParameterChanges();
+        sendResponse(parameterRegistry->getParameterString(*info));
+        return;
+    }
+    
+    // "param" / "param:<name>" - 조회 (BLE 알림 크기를 고려해 한 줄씩)
+    for (uint8_t i = 0; i < ParameterRegistry::getCount(); i++) {
+        const ParameterInfo* info = ParameterRegistry::getInfo(i);
+        if (command == "param" || command.substring(6) == info->name) {
+            sendResponse(parameterRegistry->getParameterString(*info));
+        }
+    }
+}
+
+void CommandProcessor::processParameterBinary(const CommandMessage& message) {
+    if (!parameterRegistry) {
+        Serial.println("Parameter registry not available");
+        return;
+    }
+    
+    uint8_t response[PARAM_RESPONSE_MAX_SIZE];
+    size_t length = parameterRegistry->handleBinary((const uint8_t*)message.text, message.length,
+                                                    response, sizeof(response));
+    currentTrace.parseCycles = LatencyTracker::now();
+    if (length == 0 || response[2] != PARAM_STATUS_OK) {
+        commandRejected = true;
+    }
+    
+    uint8_t op = message.length >= 2 ? (uint8_t)message.text[1] : 0;
+    if (op == PARAM_OP_SET || op == PARAM_OP_RESET) {
+        applyParameterChanges();
+    }
+    if (length > 0) {
+        sendBinaryResponse(response, length);
+    }
+}
+
+void CommandProcessor::applyParameterChanges() {
+    // 핫 패스 값은 다음 읽기부터 반영되고, 하드웨어 재설정이 필요한 항목만 제어 태스크에서 적용
+    if (motorController) {
+        MotionIntent intent;
+        memset(&intent, 0, sizeof(intent));
+        intent.type = MOTION_INTENT_PWM_FREQUENCY;
+        submitIntent(intent);
+    }
+}
+
+void CommandProcessor::processScheduleCommand(const String& command, const CommandMessage& message) {
+    if (!commandScheduler) {
+        Serial.println("Command scheduler not available");
+        return;
+    }
+    
+    // "schedule" - 큐 상태, "schedule:clear" - 예약 취소
+    if (command == "schedule:clear") {
+        commandScheduler->clear();
+        sendResponse(commandScheduler->getStatusString());
+        return;
+    }
+    if (!command.startsWith("at:")) {
+        sendResponse(commandScheduler->getStatusString());
+        return;
+    }
+    
+    // "at:<robot_us>:<command>" - robot_us는 ping/pong으로 맞춘 로봇 시계(micros())
+    int separator = command.indexOf(':', 3);
+    if (separator < 0 || separator == command.length() - 1) {
+        commandRejected = true;
+        sendResponse("at:invalid");
+        return;
+    }
+    uint32_t dueUs = strtoul(command.substring(3, separator).c_str(), nullptr, 10);
+    String text = command.substring(separator + 1);
+    text.trim();
+    text = toLowerCase(text);
+    
+    // 예약은 동작 명령만 (지금 해석해 두고 제어 틱은 배치만 적용)
+    MotionBatch batch;
+    String invalidPart;
+    if (!parseBatch(text, batch, invalidPart) || batch.fields == 0) {
+        commandRejected = true;
+        sendResponse("at:invalid");
+        return;
+    }
+    
+    ScheduleResult result = commandScheduler->schedule(dueUs, batch, message.hasSequence, message.sequence);
+    if (result == SCHEDULE_OK) {
+        // 클라이언트가 선행 시간을 조절할 수 있도록 채움 정도 회신
+        String response = "at:ok ";
+        response += commandScheduler->getCount();
+        response += "/";
+        response += commandScheduler->getCapacity();
+        sendResponse(response);
     } else {
-        Serial.println("Invalid speed value");
+        commandRejected = true;
+        if (result == SCHEDULE_FULL) {
+            sendResponse("at:full");
+        } else {
+            sendResponse("at:too_far");
+        }
+    }
+}
+
+void CommandProcessor::processMacroCommand(const String& command) {
+    if (!macroManager) {
+        Serial.println("Macro manager not available");
+        return;
     }
+    
+    if (command.startsWith("macro:def:")) {
+        defineMacro(command.substring(10));
+    } else if (command.startsWith("macro:del:")) {
+        String name = command.substring(10);
+        if (macroManager->deleteMacro(name)) {
+            sendResponse("macro:deleted " + name);
+        } else {
+            commandRejected = true;
+            sendResponse("macro:not_found " + name);
+        }
+    } else if (command.startsWith("macro:run:")) {
+        int index = macroManager->findMacro(command.substring(10));
+        if (index < 0) {
+            commandRejected = true;
+            sendResponse("macro:not_found " + command.substring(10));
+        } else {
+            runMacro(index);
+        }
+    } else if (command == "macro:stop") {
+        MotionIntent intent;
+        memset(&intent, 0, sizeof(intent));
+        intent.type = MOTION_INTENT_MACRO_STOP;
+        if (!submitIntent(intent)) {
+            commandRejected = true;
+        }
+        sendResponse(macroManager->getStatusString());
+    } else {
+        // "macro" / "macro:list" - 정의된 매크로 목록 (BLE 알림 크기를 고려해 한 줄씩)
+        for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+            if (macroManager->isDefined(i)) {
+                sendResponse(macroManager->getMacroString(i));
+            }
+        }
+        sendResponse(macroManager->getStatusString());
+    }
+}
+
+void CommandProcessor::defineMacro(const String& definition) {
+    // "<name>:<vx>,<vy>,<omega>,<ms>/<vx>,<vy>,<omega>,<ms>/..."
+    int colonIndex = definition.indexOf(':');
+    if (colonIndex <= 0) {
+        commandRejected = true;
+        sendResponse("macro:invalid");
+        return;
+    }
+    String name = definition.substring(0, colonIndex);
+    String body = definition.substring(colonIndex + 1);
+    
+    MacroStep steps[MACRO_MAX_STEPS];
+    uint8_t stepCount = 0;
+    int start = 0;
+    while (start < body.length()) {
+        int end = body.indexOf('/', start);
+        if (end < 0) end = body.length();
+        
+        int vx, vy, omega, durationMs;
+        if (stepCount >= MACRO_MAX_STEPS ||
+            sscanf(body.substring(start, end).c_str(), "%d,%d,%d,%d", &vx, &vy, &omega, &durationMs) != 4 ||
+            vx < -100 || vx > 100 || vy < -100 || vy > 100 || omega < -100 || omega > 100 ||
+            durationMs <= 0 || durationMs > 0xFFFF) {
+            commandRejected = true;
+            sendResponse("macro:invalid step " + String(stepCount + 1));
+            return;
+        }
+        
+        steps[stepCount].vx = (int8_t)vx;
+        steps[stepCount].vy = (int8_t)vy;
+        steps[stepCount].omega = (int8_t)omega;
+        steps[stepCount].durationMs = (uint16_t)durationMs;
+        stepCount++;
+        start = end + 1;
+    }
+    
+    int index = macroManager->defineMacro(name, steps, stepCount);
+    if (index < 0) {
+        commandRejected = true;
+        sendResponse("macro:rejected " + name);
+    } else {
+        sendResponse(macroManager->getMacroString(index));
+    }
+}
+
+void CommandProcessor::runMacro(int index) {
+    if (!macroManager || !macroManager->isDefined(index)) {
+        commandRejected = true;
+        sendResponse("macro:not_found " + String(index));
+        return;
+    }
+    
+    MotionBatch batch;
+    CommandCodec::clear(batch);
+    CommandCodec::setMacro(batch, (uint8_t)index);
+    submitMotion(batch);
+}
+
+void CommandProcessor::processBatchCommand(const String& command) {
+    // 하나라도 잘못되면 아무것도 적용하지 않음
+    MotionBatch batch;
+    String invalidPart;
+    if (!parseBatch(command, batch, invalidPart)) {
+        commandRejected = true;
+        sendResponse("batch:invalid " + invalidPart);
+        return;
+    }
+    
+    submitMotion(batch);
+}
+
+void CommandProcessor::processBinaryCommand(const CommandMessage& message) {
+    MotionBatch batch;
+    if (!CommandCodec::decodeBatch((const uint8_t*)message.text, message.length, batch)) {
+        commandRejected = true;
+        sendResponse("batch:invalid binary");
+        return;
+    }
+    
+    currentTrace.parseCycles = LatencyTracker::now();
+    submitMotion(batch);
+}
+
+bool CommandProcessor::parseBatch(const String& command, MotionBatch& batch, String& invalidPart) {
+    CommandCodec::clear(batch);
+    
+    int start = 0;
+    while (start <= (int)command.length()) {
+        int end = command.indexOf(';', start);
+        if (end < 0) end = command.length();
+        
+        String part = command.substring(start, end);
+        part.trim();
+        if (part.length() > 0 && !parseBatchPart(part, batch)) {
+            invalidPart = part;
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+bool CommandProcessor::parseBatchPart(const String& part, MotionBatch& batch) {
+    if (part.startsWith("speed:")) {
+        int speed = extractSpeedValue(part);
+        if (speed < 0 || speed > 100) return false;
+        CommandCodec::setSpeed(batch, (uint8_t)speed);
+        return true;
+    }
+    
+    if (part.startsWith("vel:")) {
+        int vx, vy, omega;
+        if (sscanf(part.c_str() + 4, "%d,%d,%d", &vx, &vy, &omega) != 3) return false;
+        CommandCodec::setVelocity(batch, constrain(vx, -100, 100), constrain(vy, -100, 100), constrain(omega, -100, 100));
+        return true;
+    }
+    
+    if (part.startsWith("macro:run:")) {
+        int index = macroManager ? macroManager->findMacro(part.substring(10)) : -1;
+        if (index < 0) return false;
+        CommandCodec::setMacro(batch, (uint8_t)index);
+        return true;
+    }
+    
+    // 이동 명령 (알 수 없는 문자열은 DIR_STOP으로 변환되므로 "stop"은 따로 확인)
+    if (!motorController) return false;
+    Direction direction = motorController->stringToDirection(part);
+    if (direction == DIR_STOP && part != "stop") return false;
+    CommandCodec::setDirection(batch, (uint8_t)direction);
+    return true;
+}
+
+bool CommandProcessor::submitIntent(MotionIntent& intent) {
+    // 제어 태스크가 우선순위가 높아 보통 submit() 안에서 이미 적용되고,
+    // 버스를 기다리는 등으로 늦어질 때만 잠시 기다려 응답/ACK가 적용 결과를 반영하도록 함
+    intent.receivedUs = micros();
+    uint32_t ticket = controlLoop ? controlLoop->submit(intent) : 0;
+    if (ticket == 0) {
+        LOG(LOG_MOTION_INTENT_DROPPED, intent.type);
+        return false;
+    }
+    if (!controlLoop->waitApplied(ticket, MOTION_INTENT_WAIT_MS)) {
+        // 큐에 들어갔으므로 곧 적용됨 (거부하지 않음)
+        LOG(LOG_MOTION_INTENT_LATE, intent.type, MOTION_INTENT_WAIT_MS);
+    }
+    return true;
+}
+
+bool CommandProcessor::submitMotion(const MotionBatch& batch) {
+    if (!motorController) {
+        commandRejected = true;
+        Serial.println("Motor controller not available");
+        return false;
+    }
+    
+    MotionIntent intent;
+    memset(&intent, 0, sizeof(intent));
+    intent.type = MOTION_INTENT_BATCH;
+    intent.batch = batch;
+    if (!submitIntent(intent)) {
+        commandRejected = true;
+        return false;
+    }
+    return true;
+}
+
+void CommandProcessor::applyMotionBatch(const MotionBatch& batch, uint32_t receivedUs) {
+    if (!motorController) return;
+    
+    // 속도는 출력 없이 설정만 하고, 이동은 마지막에 한 번만 출력
+    if (batch.fields & MOTION_FIELD_SPEED) {
+        motorController->setSpeed(batch.speed);
+    }
+    if ((batch.fields & MOTION_FIELD_MOTION) && macroManager) {
+        macroManager->cancel();
+    }
+    
+    if (batch.fields & MOTION_FIELD_MACRO) {
+        // 해석 뒤에 매크로가 삭제되었으면 시작하지 않음
+        if (macroManager && macroManager->startMacro(batch.macroIndex, micros()) && keepaliveMonitor) {
+            keepaliveMonitor->cancel();
+        }
+    } else if (batch.fields & MOTION_FIELD_VELOCITY) {
+        applyVelocity(batch.vx, batch.vy, batch.omega, receivedUs);
+    } else if (batch.fields & MOTION_FIELD_DIRECTION) {
+        if (keepaliveMonitor) {
+            keepaliveMonitor->cancel();
+        }
+        applyDirection(static_cast<Direction>(batch.direction));
+    } else if (motorController->isMotorRunning() && motorController->getCurrentDirection() != DIR_VELOCITY &&
+               (macroManager == nullptr || !macroManager->isRunning())) {
+        // 속도만 바뀐 경우 현재 방향으로 다시 출력
+        applyDirection(motorController->getCurrentDirection());
+    }
+    
+    if (displayManager) {
+        displayManager->updateMotorStatus();
+    }
+}
+
+void CommandProcessor::applyDirection(Direction direction) {
+    switch (direction) {
+        case DIR_FORWARD: motorController->moveForward(); break;
+        case DIR_BACKWARD: motorController->moveBackward(); break;
+        case DIR_LEFT: motorController->moveLeft(); break;
+        case DIR_RIGHT: motorController->moveRight(); break;
+        case DIR_ROTATE_LEFT: motorController->rotateLeft(); break;
+        case DIR_ROTATE_RIGHT: motorController->rotateRight(); break;
+        case DIR_DIAGONAL_FL: motorController->moveDiagonalFL(); break;
+        case DIR_DIAGONAL_FR: motorController->moveDiagonalFR(); break;
+        default: motorController->stop(); break;
+    }
+}
+
+void CommandProcessor::applyVelocity(int8_t vx, int8_t vy, int8_t omega, uint32_t receivedUs) {
+    // keepalive가 켜져 있으면 설정값으로 넘겨 제어 틱에서 보간 (간격은 받은 시각 기준), 아니면 바로 출력
+    if (keepaliveMonitor && keepaliveMonitor->isEnabled()) {
+        keepaliveMonitor->setSetpoint(vx, vy, omega, receivedUs);
+    } else {
+        motorController->setBodyVelocity(vx, vy, omega);
+    }
+}
+
+void CommandProcessor::sendResponse(const String& response) {
+    // 응답은 디버그 로그가 아니라 각 전송 경로로 (시리얼 텍스트 사용자는 SerialTransport가 줄로 출력)
+    if (transportManager) {
+        transportManager->sendResponse(response);
+    }
+}
+
+void CommandProcessor::sendBinaryResponse(const uint8_t* data, size_t length) {
+    if (!transportManager) return;
+    
+    // 가장 작은 경로 크기에 맞춰 레코드 단위로 나누어 전송 (각 조각은 같은 헤더 형식)
+    size_t maxPayload = transportManager->getMinPayload();
+    size_t chunkBytes = length - PARAM_RESPONSE_HEADER_SIZE;
+    if (maxPayload >= PARAM_RESPONSE_HEADER_SIZE + PARAM_RECORD_SIZE && maxPayload < length) {
+        chunkBytes = (maxPayload - PARAM_RESPONSE_HEADER_SIZE) / PARAM_RECORD_SIZE * PARAM_RECORD_SIZE;
+    }
+    
+    size_t pos = PARAM_RESPONSE_HEADER_SIZE;
+    do {
+        size_t chunk = min(chunkBytes, length - pos);
+        uint8_t buffer[PARAM_RESPONSE_MAX_SIZE];
+        memcpy(buffer, data, PARAM_RESPONSE_HEADER_SIZE);
+        buffer[3] = chunk / PARAM_RECORD_SIZE;
+        memcpy(buffer + PARAM_RESPONSE_HEADER_SIZE, data + pos, chunk);
+        transportManager->sendResponse(buffer, PARAM_RESPONSE_HEADER_SIZE + chunk);
+        pos += chunk;
+    } while (pos < length);
 }
 
 String CommandProcessor::toLowerCase(const String& str) const {
@@ -0,0 +1,66 @@
+#include "CommandQueue.h"
+
+CommandQueue::CommandQueue() : queue(nullptr), droppedCount(0) {
+}
+
+CommandQueue::~CommandQueue() {
+    if (queue) {
+        vQueueDelete(queue);
+    }
+}
+
+bool CommandQueue::initialize() {
+    queue = xQueueCreate(COMMAND_QUEUE_LENGTH, sizeof(CommandMessage));
+    if (!queue) {
+        Serial.println("Failed to create command queue!");
+        return false;
+    }
+    
+    Serial.println("Command queue initialized successfully");
+    return true;
+}
+
+bool CommandQueue::push(const CommandMessage& message) {
+    if (!queue || xQueueSend(queue, &message, 0) != pdTRUE) {
+        droppedCount++;
+        return false;
+    }
+    return true;
+}
+
+bool CommandQueue::push(CommandSource source, CommandTransport* transport, const char* text, size_t length, uint32_t rxCycles) {
+    CommandMessage message;
+    message.source = source;
+    message.transport = transport;
+    message.hasSequence = false;
+    message.sequence = 0;
+    message.clientTime = 0;
+    message.rxCycles = rxCycles;
+    message.overLength = length > COMMAND_MAX_LENGTH;
+    
+    if (message.overLength) {
+        length = COMMAND_MAX_LENGTH;
+    }
+    memcpy(message.text, text, length);
+    message.text[length] = '\0';
+    message.length = length;
+    
+    return push(message);
+}
+
+bool CommandQueue::pop(CommandMessage& message) {
+    return queue && xQueueReceive(queue, &message, 0) == pdTRUE;
+}
+
+bool CommandQueue::waitForCommand(uint32_t timeoutMs) {
+    CommandMessage peeked;
+    return queue && xQueuePeek(queue, &peeked, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+size_t CommandQueue::getDepth() const {
+    return queue ? uxQueueMessagesWaiting(queue) : 0;
+}
+
+unsigned long CommandQueue::getDroppedCount() const {
+    return droppedCount;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "CommandScheduler.h"
+
+CommandScheduler::CommandScheduler()
+    : count(0), nextOrder(0), executedCount(0), lateCount(0), rejectedCount(0), maxLatenessUs(0) {
+    lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+ScheduleResult CommandScheduler::schedule(uint32_t dueUs, const MotionBatch& batch, bool hasSequence, uint16_t sequence) {
+    // 선행 버퍼 제한: 너무 먼 미래의 명령은 받지 않는다 (이미 지난 시각은 즉시 실행 대상)
+    int32_t ahead = (int32_t)(dueUs - micros());
+    if (ahead > (int32_t)SCHEDULER_MAX_LOOKAHEAD_MS * 1000) {
+        rejectedCount++;
+        return SCHEDULE_TOO_FAR;
+    }
+    
+    portENTER_CRITICAL(&lock);
+    if (count >= SCHEDULER_CAPACITY) {
+        portEXIT_CRITICAL(&lock);
+        rejectedCount++;
+        return SCHEDULE_FULL;
+    }
+    
+    ScheduledCommand& slot = heap[count];
+    slot.dueUs = dueUs;
+    slot.order = nextOrder++;
+    slot.hasSequence = hasSequence;
+    slot.sequence = sequence;
+    slot.batch = batch;
+    siftUp(count);
+    count++;
+    portEXIT_CRITICAL(&lock);
+    
+    return SCHEDULE_OK;
+}
+
+bool CommandScheduler::popDue(uint32_t nowUs, ScheduledCommand& command) {
+    portENTER_CRITICAL(&lock);
+    if (count == 0 || isEarlier(nowUs, heap[0].dueUs)) {
+        portEXIT_CRITICAL(&lock);
+        return false;
+    }
+    
+    command = heap[0];
+    count--;
+    if (count > 0) {
+        heap[0] = heap[count];
+        siftDown(0);
+    }
+    portEXIT_CRITICAL(&lock);
+    return true;
+}
+
+bool CommandScheduler::getTimeUntilNext(uint32_t nowUs, int32_t& remainingUs) {
+    portENTER_CRITICAL(&lock);
+    bool available = count > 0;
+    if (available) {
+        remainingUs = (int32_t)(heap[0].dueUs - nowUs);
+    }
+    portEXIT_CRITICAL(&lock);
+    return available;
+}
+
+void CommandScheduler::recordExecution(uint32_t latenessUs) {
+    executedCount++;
+    if (latenessUs > SCHEDULER_LATE_THRESHOLD_US) {
+        lateCount++;
+    }
+    if (latenessUs > maxLatenessUs) {
+        maxLatenessUs = latenessUs;
+    }
+}
+
+void CommandScheduler::clear() {
+    portENTER_CRITICAL(&lock);
+    count = 0;
+    portEXIT_CRITICAL(&lock);
+}
+
+uint8_t CommandScheduler::getCount() const {
+    return count;
+}
+
+uint8_t CommandScheduler::getCapacity() const {
+    return SCHEDULER_CAPACITY;
+}
+
+String CommandScheduler::getStatusString() {
+    // 예: "schedule:3/32 next:+120ms exec:40 late:2 rejected:0 maxlate:850us"
+    String status = "schedule:";
+    status += count;
+    status += "/";
+    status += SCHEDULER_CAPACITY;
+    
+    int32_t remainingUs;
+    if (getTimeUntilNext(micros(), remainingUs)) {
+        status += " next:";
+        status += remainingUs >= 0 ? "+" : "";
+        status += remainingUs / 1000;
+        status += "ms";
+    }
+    
+    status += " exec:";
+    status += executedCount;
+    status += " late:";
+    status += lateCount;
+    status += " rejected:";
+    status += rejectedCount;
+    status += " maxlate:";
+    status += maxLatenessUs;
+    status += "us";
+    return status;
+}
+
+bool CommandScheduler::isEarlier(uint32_t a, uint32_t b) {
+    // micros() 랩어라운드(약 71분)를 고려한 비교
+    return (int32_t)(a - b) < 0;
+}
+
+bool CommandScheduler::comesBefore(const ScheduledCommand& a, const ScheduledCommand& b) {
+    if (a.dueUs != b.dueUs) {
+        return isEarlier(a.dueUs, b.dueUs);
+    }
+    return isEarlier(a.order, b.order);
+}
+
+void CommandScheduler::siftUp(uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!comesBefore(heap[index], heap[parent])) break;
+        ScheduledCommand tmp = heap[index];
+        heap[index] = heap[parent];
+        heap[parent] = tmp;
+        index = parent;
+    }
+}
+
+void CommandScheduler::siftDown(uint8_t index) {
+    while (true) {
+        uint8_t left = index * 2 + 1;
+        uint8_t right = left + 1;
+        uint8_t smallest = index;
+        
+        if (left < count && comesBefore(heap[left], heap[smallest])) smallest = left;
+        if (right < count && comesBefore(heap[right], heap[smallest])) smallest = right;
+        if (smallest == index) break;
+        
+        ScheduledCommand tmp = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = tmp;
+        index = smallest;
+    }
+}
\ No newline at end of file
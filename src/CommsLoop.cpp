@@ -0,0 +1,106 @@
+#include "CommsLoop.h"
+#include "BluetoothManager.h"
+#include "TransportManager.h"
+#include "FleetReceiver.h"
+#include "CommandQueue.h"
+#include "CommandProcessor.h"
+#include "TelemetryManager.h"
+#include "TaskMonitor.h"
+
+CommsLoop::CommsLoop()
+    : bluetoothManager(nullptr), transportManager(nullptr), fleetReceiver(nullptr), commandQueue(nullptr),
+      commandProcessor(nullptr), telemetryManager(nullptr), taskMonitor(nullptr), taskHandle(nullptr), monitorId(-1) {
+}
+
+CommsLoop::~CommsLoop() {
+    if (taskHandle) {
+        vTaskDelete(taskHandle);
+    }
+}
+
+bool CommsLoop::initialize() {
+    if (taskHandle) {
+        Serial.println("Comms loop already initialized");
+        return true;
+    }
+    
+    if (!bluetoothManager || !transportManager || !fleetReceiver || !commandQueue || !commandProcessor || !telemetryManager) {
+        Serial.println("Comms loop dependencies not set!");
+        return false;
+    }
+    
+    if (xTaskCreate(taskEntry, "comms", COMMS_TASK_STACK_SIZE, this, COMMS_TASK_PRIORITY, &taskHandle) != pdPASS) {
+        Serial.println("Failed to create comms task!");
+        taskHandle = nullptr;
+        return false;
+    }
+    
+    if (taskMonitor) {
+        monitorId = taskMonitor->registerTask(taskHandle, "comms");
+    }
+    
+    Serial.println("Comms loop initialized successfully");
+    return true;
+}
+
+void CommsLoop::setBluetoothManager(BluetoothManager* manager) {
+    bluetoothManager = manager;
+}
+
+void CommsLoop::setTransportManager(TransportManager* manager) {
+    transportManager = manager;
+}
+
+void CommsLoop::setFleetReceiver(FleetReceiver* receiver) {
+    fleetReceiver = receiver;
+}
+
+void CommsLoop::setCommandQueue(CommandQueue* queue) {
+    commandQueue = queue;
+}
+
+void CommsLoop::setCommandProcessor(CommandProcessor* processor) {
+    commandProcessor = processor;
+}
+
+void CommsLoop::setTelemetryManager(TelemetryManager* manager) {
+    telemetryManager = manager;
+}
+
+void CommsLoop::setTaskMonitor(TaskMonitor* monitor) {
+    taskMonitor = monitor;
+}
+
+void CommsLoop::taskEntry(void* arg) {
+    CommsLoop* commsLoop = static_cast<CommsLoop*>(arg);
+    while (true) {
+        commsLoop->runOnce();
+        
+        // 명령이 도착하면 즉시 깨어나고, 없으면 텔레메트리/연결 관리 주기마다 깨어남
+        commsLoop->commandQueue->waitForCommand(COMMS_IDLE_WAIT_MS);
+    }
+}
+
+void CommsLoop::runOnce() {
+    unsigned long start = micros();
+    
+    // 블루투스 연결 상태 변경 처리
+    bluetoothManager->handleConnectionChange();
+    
+    // 수신된 명령 처리 (BLE 콜백/시리얼 → 큐 → 여기)
+    transportManager->update();
+    fleetReceiver->update();
+    CommandMessage message;
+    while (commandQueue->pop(message)) {
+        commandProcessor->processMessage(message);
+    }
+    
+    // 텔레메트리 프레임 전송
+    telemetryManager->update();
+    
+    unsigned long elapsed = micros() - start;
+    telemetryManager->recordLoopTime(elapsed);
+    if (taskMonitor) {
+        taskMonitor->addBusyTime(monitorId, elapsed);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "ControlLoop.h"
+#include "CommandScheduler.h"
+#include "CommandProcessor.h"
+#include "TaskMonitor.h"
+
+ControlLoop::ControlLoop()
+    : commandScheduler(nullptr), commandProcessor(nullptr), taskMonitor(nullptr), monitorId(-1), tickTimer(nullptr), preciseTimer(nullptr),
+      taskHandle(nullptr), preciseArmed(false), intentQueue(nullptr), nextTicket(0), appliedTicket(0), tickCount(0), maxTickUs(0) {
+}
+
+ControlLoop::~ControlLoop() {
+    if (tickTimer) {
+        esp_timer_stop(tickTimer);
+        esp_timer_delete(tickTimer);
+    }
+    if (preciseTimer) {
+        esp_timer_stop(preciseTimer);
+        esp_timer_delete(preciseTimer);
+    }
+}
+
+bool ControlLoop::initialize() {
+    intentQueue = xQueueCreate(MOTION_INTENT_QUEUE_LENGTH, sizeof(MotionIntent));
+    if (!intentQueue) {
+        Serial.println("Failed to create motion intent queue!");
+        return false;
+    }
+    
+    // 제어 태스크 (loop()보다 높은 우선순위)
+    if (xTaskCreate(taskEntry, "control", CONTROL_TASK_STACK_SIZE, this, CONTROL_TASK_PRIORITY, &taskHandle) != pdPASS) {
+        Serial.println("Failed to create control task!");
+        return false;
+    }
+    if (taskMonitor) {
+        monitorId = taskMonitor->registerTask(taskHandle, "control");
+    }
+    
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &ControlLoop::timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "control_tick";
+    if (esp_timer_create(&timerArgs, &tickTimer) != ESP_OK) {
+        Serial.println("Failed to create control tick timer!");
+        return false;
+    }
+    
+    timerArgs.callback = &ControlLoop::preciseTimerCallback;
+    timerArgs.name = "control_precise";
+    if (esp_timer_create(&timerArgs, &preciseTimer) != ESP_OK) {
+        Serial.println("Failed to create control precise timer!");
+        return false;
+    }
+    
+    esp_timer_start_periodic(tickTimer, CONTROL_TICK_PERIOD_US);
+    
+    Serial.println("Control loop initialized successfully");
+    return true;
+}
+
+void ControlLoop::setCommandScheduler(CommandScheduler* scheduler) {
+    commandScheduler = scheduler;
+}
+
+void ControlLoop::setCommandProcessor(CommandProcessor* processor) {
+    commandProcessor = processor;
+}
+
+void ControlLoop::setTaskMonitor(TaskMonitor* monitor) {
+    taskMonitor = monitor;
+}
+
+uint32_t ControlLoop::submit(MotionIntent& intent) {
+    if (!intentQueue || !taskHandle) return 0;
+    
+    // 번호 순서와 큐 순서가 같도록 번호 발급과 넣기 사이에 다른 태스크가 끼어들지 않게 함
+    vTaskSuspendAll();
+    if (++nextTicket == 0) nextTicket = 1;  // 0은 실패 표시
+    intent.ticket = nextTicket;
+    bool queued = xQueueSend(intentQueue, &intent, 0) == pdTRUE;
+    xTaskResumeAll();
+    
+    if (!queued) return 0;
+    xTaskNotifyGive(taskHandle);
+    return intent.ticket;
+}
+
+bool ControlLoop::waitApplied(uint32_t ticket, uint32_t timeoutMs) {
+    // 제어 태스크가 버스를 기다리는 등으로 늦어질 때만 실제로 대기
+    unsigned long start = millis();
+    while ((int32_t)(appliedTicket - ticket) < 0) {
+        if (millis() - start >= timeoutMs) return false;
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+String ControlLoop::getStatusString() const {
+    String status = "control: ticks:";
+    status += tickCount;
+    status += " maxtick:";
+    status += maxTickUs;
+    status += "us";
+    return status;
+}
+
+void ControlLoop::timerCallback(void* arg) {
+    ControlLoop* controlLoop = static_cast<ControlLoop*>(arg);
+    xTaskNotifyGive(controlLoop->taskHandle);
+}
+
+void ControlLoop::preciseTimerCallback(void* arg) {
+    ControlLoop* controlLoop = static_cast<ControlLoop*>(arg);
+    controlLoop->preciseArmed = false;
+    xTaskNotifyGive(controlLoop->taskHandle);
+}
+
+void ControlLoop::taskEntry(void* arg) {
+    ControlLoop* controlLoop = static_cast<ControlLoop*>(arg);
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        controlLoop->tick();
+    }
+}
+
+void ControlLoop::applyIntents() {
+    // 다른 태스크가 넘긴 순서대로 적용 (기다리지 않고 큐에 있는 것만)
+    MotionIntent intent;
+    while (xQueueReceive(intentQueue, &intent, 0) == pdTRUE) {
+        if (commandProcessor) {
+            commandProcessor->applyIntent(intent);
+        }
+        if ((int32_t)(intent.ticket - appliedTicket) > 0) {
+            appliedTicket = intent.ticket;
+        }
+    }
+}
+
+void ControlLoop::tick() {
+    uint32_t start = micros();
+    tickCount++;
+    
+    applyIntents();
+    
+    if (commandProcessor) {
+        // 진행 중인 I2C 벤치마크 프레임 (틱마다 하나)
+        commandProcessor->updateBenchmark(micros());
+    }
+    
+    if (commandScheduler && commandProcessor) {
+        // 실행 시각이 된 예약 명령 처리
+        ScheduledCommand command;
+        while (commandScheduler->popDue(micros(), command)) {
+            commandProcessor->executeScheduled(command);
+            commandScheduler->recordExecution(micros() - command.dueUs);
+        }
+        
+        // 실행 중인 매크로 단계 진행
+        commandProcessor->updateMacros(micros());
+        
+        // 설정값 보간 및 데드맨 시간 초과 확인 (반응 시간은 틱 주기 이내)
+        commandProcessor->updateKeepalive(micros());
+        
+        // 다음 명령이 다음 틱 전에 예정되어 있으면 정확한 시각에 깨어나도록 예약
+        int32_t remainingUs;
+        if (!preciseArmed && commandScheduler->getTimeUntilNext(micros(), remainingUs) &&
+            remainingUs > 0 && remainingUs < CONTROL_TICK_PERIOD_US) {
+            preciseArmed = true;
+            esp_timer_start_once(preciseTimer, remainingUs);
+        }
+    }
+    
+    uint32_t elapsed = micros() - start;
+    if (elapsed > maxTickUs) {
+        maxTickUs = elapsed;
+    }
+    if (taskMonitor) {
+        taskMonitor->addBusyTime(monitorId, elapsed);
+    }
+}
\ No newline at end of file
@@ -1,13 +1,25 @@
 #include "DisplayManager.h"
 #include "MotorController.h"
 #include "EncoderManager.h"
-#include <Wire.h>
+#include "LedEffectEngine.h"
+#include "I2cBusScheduler.h"
+#include "TaskMonitor.h"
+#include "Logger.h"
+#include "Profiler.h"
 
 DisplayManager::DisplayManager() 
-    : display(nullptr), motorController(nullptr), encoderManager(nullptr), showEncoderInfo(false), isInitialized(false) {
+    : display(nullptr), motorController(nullptr), encoderManager(nullptr), ledEffects(nullptr), i2cBus(nullptr), taskMonitor(nullptr), showEncoderInfo(false), isInitialized(false), connectionState(-1),
+      frameDirty(false), motorStatusDirty(false), panelOnline(true), resyncPending(false), refreshTask(nullptr), monitorId(-1), modelUpdateCount(0),
+      flushCount(0), lastFlushBytes(0), lastLegacyBytes(0), pendingLegacyBytes(0), totalFlushBytes(0), totalLegacyBytes(0) {
+    modelLock = portMUX_INITIALIZER_UNLOCKED;
+    memset(shadow, ' ', sizeof(shadow));
+    memset(shown, ' ', sizeof(shown));
 }
 
 DisplayManager::~DisplayManager() {
+    if (refreshTask) {
+        vTaskDelete(refreshTask);
+    }
     if (display) {
         delete display;
     }
@@ -21,11 +33,7 @@ bool DisplayManager::initialize() {
 
     Serial.println("Initializing Display Manager...");
     
-    // Wire 초기화 확인
-    Wire.begin();
-    Wire.setClock(400000);  // 400kHz로 설정
-    delay(100);  // I2C 버스 안정화를 위한 지연
-    
+    // Wire 초기화와 속도 선택은 main/I2cBusScheduler가 담당
     // OLED 디스플레이 초기화
     if (display) {
         delete display;
@@ -37,14 +45,19 @@ bool DisplayManager::initialize() {
         return false;
     }
     
+    // U8x8은 전송마다 Wire.setClock()을 다시 하므로 probe로 정한 속도를 알려줌 (기본값은 400kHz)
+    display->setBusClock(i2cBus ? i2cBus->getClockHz() : I2C_BUS_CLOCK_HZ);
+    
     // 디스플레이 초기화 시도 (최대 3번)
     bool initSuccess = false;
     for (int i = 0; i < 3 && !initSuccess; i++) {
         Serial.print("Display initialization attempt ");
         Serial.println(i + 1);
         
-        if (display->begin()) {
-            initSuccess = true;
+        acquireBus();
+        initSuccess = display->begin();
+        releaseBus();
+        if (initSuccess) {
             break;
         }
         
@@ -60,7 +73,9 @@ bool DisplayManager::initialize() {
         return false;
     }
     
+    acquireBus();
     display->setFlipMode(1);  // 화면 회전
+    releaseBus();
     display->setFont(u8x8_font_chroma48medium8_r);
     
     // 초기 상태 설정
@@ -72,14 +87,11 @@ bool DisplayManager::initialize() {
     
     // 시작 화면 표시
     clearScreen();
-    display->setCursor(0, 0);
-    display->print("ESP32C3 4Motor");
-    display->setCursor(0, 1);
-    display->print("Mecanum Robot");
-    display->setCursor(0, 2);
-    display->print("BLE: Starting");
-    display->setCursor(0, 3);
-    display->print("Status: Init");
+    writeLine(0, "ESP32C3 4Motor");
+    writeLine(1, "Mecanum Robot");
+    writeLine(2, "BLE: Starting");
+    writeLine(3, "Status: Init");
+    flush();
     
     Serial.println("Display manager initialized successfully");
     return true;
@@ -93,73 +105,157 @@ void DisplayManager::setEncoderManager(EncoderManager* manager) {
     encoderManager = manager;
 }
 
+void DisplayManager::setLedEffectEngine(LedEffectEngine* engine) {
+    ledEffects = engine;
+}
+
+void DisplayManager::setI2cBusScheduler(I2cBusScheduler* scheduler) {
+    i2cBus = scheduler;
+}
+
+void DisplayManager::setTaskMonitor(TaskMonitor* monitor) {
+    taskMonitor = monitor;
+}
+
+void DisplayManager::acquireBus() {
+    if (i2cBus) {
+        i2cBus->acquire(I2C_CLIENT_DISPLAY);
+    }
+}
+
+void DisplayManager::releaseBus() {
+    if (i2cBus) {
+        i2cBus->release();
+    }
+}
+
+bool DisplayManager::startRefreshTask() {
+    if (refreshTask) return true;
+    if (!isInitialized || !display) return false;
+    
+    if (xTaskCreate(refreshTaskEntry, "display", DISPLAY_TASK_STACK_SIZE, this, DISPLAY_TASK_PRIORITY, &refreshTask) != pdPASS) {
+        Serial.println("Failed to create display refresh task!");
+        refreshTask = nullptr;
+        return false;
+    }
+    if (taskMonitor) {
+        monitorId = taskMonitor->registerTask(refreshTask, "display");
+    }
+    
+    Serial.print("Display refresh task started: ");
+    Serial.print(DISPLAY_REFRESH_PERIOD_MS);
+    Serial.println("ms");
+    return true;
+}
+
+void DisplayManager::setPanelOnline(bool online) {
+    panelOnline = online;
+    // 부팅 태스크가 아직 패널을 만드는 중이면 (실패 시 delete) 건드리지 않음
+    if (!online || !isInitialized) return;
+    
+    // 패널이 리셋되었을 수 있으므로 다시 설정하고 전체를 다시 그림 (갱신 태스크가 있으면 거기서)
+    if (refreshTask) {
+        resyncPending = true;
+    } else {
+        resyncPanel();
+        flush();
+    }
+}
+
+void DisplayManager::resyncPanel() {
+    if (!isInitialized || !display) return;
+    
+    // begin()의 화면 지우기(1KB)는 건너뛰고, shown을 무효화해 flush()가 조각 단위로 전부 다시 보내게 함
+    acquireBus();
+    display->initDisplay();
+    display->setFlipMode(1);
+    display->setPowerSave(0);
+    releaseBus();
+    memset(shown, 0, sizeof(shown));
+    frameDirty = true;
+}
+
+void DisplayManager::refreshTaskEntry(void* arg) {
+    DisplayManager* manager = static_cast<DisplayManager*>(arg);
+    TickType_t lastWake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(DISPLAY_REFRESH_PERIOD_MS));
+        uint32_t wakeUs = micros();
+        
+        if (manager->resyncPending) {
+            manager->resyncPending = false;
+            manager->resyncPanel();
+        }
+        
+        // 주기 사이에 여러 번 바뀌었어도 마지막 상태만 한 번 그림
+        if (manager->motorStatusDirty) {
+            manager->motorStatusDirty = false;
+            manager->renderMotorStatus();
+        }
+        if (manager->frameDirty) {
+            manager->flush();
+        }
+        
+        if (manager->taskMonitor) {
+            manager->taskMonitor->addBusyTime(manager->monitorId, micros() - wakeUs);
+        }
+    }
+}
+
 void DisplayManager::updateConnectionStatus(bool connected) {
+    PROFILE_SCOPE(PROFILE_DISPLAY_UPDATE);
+    // 준비 전에 온 갱신도 상태는 기억해 두고 시작 화면을 그린 뒤 다시 반영
+    connectionState = connected ? 1 : 0;
     if (!isInitialized || !display) {
-        Serial.println("Display not ready for connection update");
+        LOG_TEXT(LOG_DISPLAY_NOT_READY, "connection");
         return;
     }
     
-    Serial.print("Updating BLE connection status: ");
-    Serial.println(connected ? "Connected" : "Disconnected");
+    LOG_TEXT(LOG_DISPLAY_CONNECTION, connected ? "Connected" : "Disconnected");
+    renderConnectionStatus(connected);
     
-    // BLE 연결 상태 표시 (1번째 줄)
-    display->clearLine(0);
-    display->setCursor(0, 0);
+    // LED 효과로 연결 알림
     if (connected) {
-        display->print("BLE: Connected");
-        // 연결 시 통신 상태 초기화
-        display->clearLine(2);
-        display->setCursor(0, 2);
-        display->print("Waiting for cmd");
-        
-        display->clearLine(3);
-        display->setCursor(0, 3);
-        display->print("Status: Active");
-        
-        // LED 효과로 연결 알림
         showMessageReceivedEffect();
-    } else {
-        display->print("BLE: Disconnected");
-        // 연결 해제 시 통신 상태 초기화
-        display->clearLine(2);
-        display->setCursor(0, 2);
-        display->print("No Connection");
-        
-        display->clearLine(3);
-        display->setCursor(0, 3);
-        display->print("Status: Offline");
     }
     
     // 상태 업데이트 시간 기록
     lastUpdateTime = millis();
 }
 
+void DisplayManager::renderConnectionStatus(bool connected) {
+    // BLE 연결 상태 표시 (1번째 줄)
+    if (connected) {
+        writeLine(0, "BLE: Connected");
+        // 연결 시 통신 상태 초기화
+        writeLine(2, "Waiting for cmd");
+        writeLine(3, "Status: Active");
+    } else {
+        writeLine(0, "BLE: Disconnected");
+        // 연결 해제 시 통신 상태 초기화
+        writeLine(2, "No Connection");
+        writeLine(3, "Status: Offline");
+    }
+    requestFlush();
+}
+
 void DisplayManager::updateReceivedMessage(const String& message) {
+    PROFILE_SCOPE(PROFILE_DISPLAY_UPDATE);
     if (!isInitialized || !display) {
-        Serial.println("Display not ready for message update");
+        LOG_TEXT(LOG_DISPLAY_NOT_READY, "message");
         return;
     }
     
-    Serial.print("Received message: ");
-    Serial.println(message);
-    
-    // 수신된 메시지 표시 (2번째 줄)
-    display->clearLine(2);
-    display->setCursor(0, 2);
-    display->print("RX: ");
-    
-    // 메시지가 너무 길 경우 처리
-    if (message.length() <= 16) {
-        display->print(message);
-    } else {
-        display->print(message.substring(0, 13));
-        display->print("...");
-    }
+    // 명령 지연 경로이므로 I2C 전송 없이 모델만 갱신 (로그는 CommandProcessor에서 출력)
+    // 수신된 메시지 표시 (2번째 줄), 메시지가 너무 길 경우 처리
+    writeLine(2, "RX: " + abbreviate(message));
     
     // 수신 상태 표시 (3번째 줄)
-    display->clearLine(3);
-    display->setCursor(0, 3);
-    display->print("Status: Received");
+    writeLine(3, "Status: Received");
+    portENTER_CRITICAL(&modelLock);
+    modelUpdateCount++;
+    portEXIT_CRITICAL(&modelLock);
+    requestFlush();
     
     // LED 효과 표시
     showMessageReceivedEffect();
@@ -170,6 +266,7 @@ void DisplayManager::updateReceivedMessage(const String& message) {
 }
 
 void DisplayManager::updateCommunicationStatus(bool isSending, const String& status) {
+    PROFILE_SCOPE(PROFILE_DISPLAY_UPDATE);
     if (!isInitialized || !display) return;
     
     this->isSending = isSending;
@@ -177,43 +274,19 @@ void DisplayManager::updateCommunicationStatus(bool isSending, const String& sta
     this->lastUpdateTime = millis();
     
     // 통신 상태 표시 (2번째 줄)
-    display->clearLine(2);
-    display->setCursor(0, 2);
     if (isSending) {
-        display->print("TX: ");
-        if (status.length() > 0) {
-            if (status.length() <= 16) {
-                display->print(status);
-            } else {
-                display->print(status.substring(0, 13));
-                display->print("...");
-            }
-        }
+        writeLine(2, "TX: " + abbreviate(status));
     } else {
-        display->print("RX: ");
-        if (lastResponse.length() > 0) {
-            if (lastResponse.length() <= 16) {
-                display->print(lastResponse);
-            } else {
-                display->print(lastResponse.substring(0, 13));
-                display->print("...");
-            }
-        } else {
-            display->print("Waiting");
-        }
+        writeLine(2, "RX: " + (lastResponse.length() > 0 ? abbreviate(lastResponse) : String("Waiting")));
     }
     
     // 상태 업데이트 (3번째 줄)
-    display->clearLine(3);
-    display->setCursor(0, 3);
-    if (isSending) {
-        display->print("Status: Sending");
-    } else {
-        display->print("Status: Active");
-    }
+    writeLine(3, isSending ? "Status: Sending" : "Status: Active");
+    requestFlush();
 }
 
 void DisplayManager::updateResponseStatus(const String& response) {
+    PROFILE_SCOPE(PROFILE_DISPLAY_UPDATE);
     if (!isInitialized || !display) return;
     
     this->lastResponse = response;
@@ -221,39 +294,37 @@ void DisplayManager::updateResponseStatus(const String& response) {
     this->lastUpdateTime = millis();
     
     // 응답 표시 (2번째 줄)
-    display->clearLine(2);
-    display->setCursor(0, 2);
-    display->print("RX: ");
-    if (response.length() > 0) {
-        if (response.length() <= 16) {
-            display->print(response);
-        } else {
-            display->print(response.substring(0, 13));
-            display->print("...");
-        }
-    } else {
-        display->print("Waiting");
-    }
+    writeLine(2, "RX: " + (response.length() > 0 ? abbreviate(response) : String("Waiting")));
     
     // 상태 업데이트 (3번째 줄)
-    display->clearLine(3);
-    display->setCursor(0, 3);
-    display->print("Status: Received");
+    writeLine(3, "Status: Received");
+    requestFlush();
 }
 
 void DisplayManager::updateMotorStatus() {
+    PROFILE_SCOPE(PROFILE_DISPLAY_UPDATE);
+    // 부팅 중에는 초기화가 백그라운드 태스크에서 진행되므로 begin() 전의 패널에는 쓰지 않음
+    if (!motorController || !isInitialized || !display) return;
+    
+    // 제어 태스크에서도 호출되므로 표시만 예약하고, 문자열은 갱신 태스크에서 최신 값으로 만듦
+    portENTER_CRITICAL(&modelLock);
+    motorStatusDirty = true;
+    modelUpdateCount++;
+    portEXIT_CRITICAL(&modelLock);
+    
+    if (!refreshTask) {
+        motorStatusDirty = false;
+        renderMotorStatus();
+        flush();
+    }
+}
+
+void DisplayManager::renderMotorStatus() {
     if (!motorController) return;
     
-    display->clearLine(5);
-    display->setCursor(0, 5);
-    display->print("Dir: ");
-    display->print(motorController->directionToString(motorController->getCurrentDirection()));
-    
-    display->clearLine(6);
-    display->setCursor(0, 6);
-    display->print("Speed: ");
-    display->print(motorController->getSpeed());
-    display->print("%");
+    // 내용이 같은 줄은 flush()에서 전송되지 않음
+    writeLine(5, "Dir: " + motorController->directionToString(motorController->getCurrentDirection()));
+    writeLine(6, "Speed: " + String(motorController->getSpeed()) + "%");
     
     // 인코더 정보 또는 모터 상태 표시
     if (showEncoderInfo) {
@@ -276,24 +347,24 @@ void DisplayManager::updateStartupScreen() {
         return;
     }
     
-    display->setCursor(0, 0);
-    display->print("ESP32C3 4Motor");  // 첫 번째 줄: 장비 이름만
-    display->setCursor(0, 1);
-    display->print("Ver: ");
-    display->print(VersionInfo::getVersionString());  // 두 번째 줄: 버전 정보
-    display->setCursor(0, 2);
-    display->print("Mecanum Robot");
-    display->setCursor(0, 3);
-    display->print("BLE: Starting");
+    writeLine(0, "ESP32C3 4Motor");  // 첫 번째 줄: 장비 이름만
+    writeLine(1, "Ver: " + String(VersionInfo::getVersionString()));  // 두 번째 줄: 버전 정보
+    writeLine(2, "Mecanum Robot");
+    writeLine(3, "BLE: Starting");
     
     // 초기 통신 상태 표시
-    display->clearLine(4);
-    display->setCursor(0, 4);
-    display->print("Status: Init");
+    writeLine(4, "Status: Init");
     
     // 모터 상태 초기화
-    display->clearLine(6);
-    display->clearLine(7);
+    writeLine(6, "");
+    writeLine(7, "");
+    requestFlush();
+    
+    // 준비 전에 바뀐 연결 상태는 버려지지 않도록 다시 그림 ("BLE: Starting"으로 남지 않게)
+    int8_t state = connectionState;
+    if (state >= 0) {
+        renderConnectionStatus(state == 1);
+    }
     
     // 상태 초기화
     isSending = false;
@@ -312,13 +383,10 @@ bool DisplayManager::isShowingEncoderInfo() const {
 }
 
 void DisplayManager::resetI2CBus() {
-    Serial.println("Resetting I2C bus...");
-    Wire.end();
-    delay(100);  // I2C 버스 안정화를 위한 지연
-    Wire.begin();
-    Wire.setClock(400000);  // 400kHz로 설정
-    delay(100);  // I2C 버스 안정화를 위한 지연
-    Serial.println("I2C bus reset completed");
+    // Wire 재시작은 스케줄러만 함 (버스를 점유한 상태에서, 선택된 속도로)
+    if (i2cBus) {
+        i2cBus->resetBus(I2C_CLIENT_DISPLAY);
+    }
 }
 
 void DisplayManager::clearScreen() {
@@ -327,73 +395,155 @@ void DisplayManager::clearScreen() {
         return;
     }
     
-    Serial.println("Attempting to clear display...");
-    
-    // I2C 버스 상태 확인
-    Wire.beginTransmission(0x3C);  // OLED 디스플레이의 I2C 주소
-    byte error = Wire.endTransmission();
-    
-    if (error != 0) {
-        Serial.print("I2C error before clear: ");
-        Serial.println(error);
-        Serial.println("Attempting to reset I2C bus...");
-        resetI2CBus();
-        
-        // 디스플레이 재초기화 시도
-        if (!display->begin()) {
-            Serial.println("Failed to reinitialize display after I2C reset!");
-            return;
+    // 갱신 태스크가 패널을 맡은 뒤에는 섀도만 비우고 diff 전송으로 지움
+    if (refreshTask) {
+        for (int row = 0; row < TEXT_ROWS; row++) {
+            writeLine(row, "");
         }
-        display->setFlipMode(1);
-        display->setFont(u8x8_font_chroma48medium8_r);
+        return;
     }
     
-    // 디스플레이 클리어 시도
+    Serial.println("Attempting to clear display...");
+    
+    // 디스플레이 클리어 (패널과 섀도 버퍼 모두 공백 상태, 부팅 중에만 한 번에 1KB 전송)
+    // 버스/패널 오류 감지와 복구는 I2cHealthMonitor가 백그라운드에서 처리
+    acquireBus();
     display->clear();
+    releaseBus();
+    memset(shadow, ' ', sizeof(shadow));
+    memset(shown, ' ', sizeof(shown));
     Serial.println("Display clear operation completed");
 }
 
 void DisplayManager::clearLine(int line) {
-    display->clearLine(line);
+    writeLine(line, "");
+    requestFlush();
+}
+
+void DisplayManager::writeLine(int row, const String& text) {
+    if (row < 0 || row >= TEXT_ROWS) return;
+    
+    // 섀도 버퍼만 갱신 (16자를 넘으면 잘라내고 나머지는 공백으로 채움)
+    int length = min((int)text.length(), TEXT_COLUMNS);
+    portENTER_CRITICAL(&modelLock);
+    char* line = shadow[row];
+    memcpy(line, text.c_str(), length);
+    memset(line + length, ' ', TEXT_COLUMNS - length);
+    frameDirty = true;
+    
+    // 비교용: 이전 방식(clearLine 후 글자마다 drawGlyph)이었다면 보냈을 바이트
+    pendingLegacyBytes += DISPLAY_I2C_TRANSFER_OVERHEAD + TEXT_COLUMNS * 8;
+    pendingLegacyBytes += (unsigned long)length * (DISPLAY_I2C_TRANSFER_OVERHEAD + 8);
+    portEXIT_CRITICAL(&modelLock);
+}
+
+void DisplayManager::requestFlush() {
+    // 갱신 태스크가 있으면 다음 프레임에 그려지고, 태스크 시작 전(부팅 중)에는 바로 전송
+    if (!refreshTask) {
+        flush();
+    }
+}
+
+void DisplayManager::flush() {
+    PROFILE_SCOPE(PROFILE_DISPLAY_FLUSH);
+    if (!isInitialized || !display || !panelOnline) return;
+    
+    // 모델 스냅샷을 잡은 뒤에는 잠금 없이 전송 (그 사이의 변경은 다음 프레임에 반영)
+    char frame[TEXT_ROWS][TEXT_COLUMNS];
+    portENTER_CRITICAL(&modelLock);
+    memcpy(frame, shadow, sizeof(frame));
+    unsigned long legacyBytes = pendingLegacyBytes;
+    pendingLegacyBytes = 0;
+    frameDirty = false;
+    portEXIT_CRITICAL(&modelLock);
+    
+    // 바뀐 8x8 타일이 연속된 구간마다 drawTile로 전송하되, 한 번에 DISPLAY_I2C_CHUNK_TILES까지만 보내고
+    // 조각 사이에서 기다리는 모터 쓰기가 있으면 버스를 넘김
+    uint8_t tiles[DISPLAY_I2C_CHUNK_TILES * 8];
+    unsigned long bytes = 0;
+    acquireBus();
+    for (int row = 0; row < TEXT_ROWS; row++) {
+        int column = 0;
+        while (column < TEXT_COLUMNS) {
+            if (frame[row][column] == shown[row][column]) {
+                column++;
+                continue;
+            }
+            
+            if (i2cBus && bytes > 0) {
+                i2cBus->yieldIfContended(I2C_CLIENT_DISPLAY);
+            }
+            
+            int start = column;
+            while (column < TEXT_COLUMNS && column - start < DISPLAY_I2C_CHUNK_TILES &&
+                   frame[row][column] != shown[row][column]) {
+                u8x8_get_glyph_data(display->getU8x8(), (uint8_t)frame[row][column],
+                                    tiles + (column - start) * 8, 0);
+                shown[row][column] = frame[row][column];
+                column++;
+            }
+            display->drawTile(start, row, column - start, tiles);
+            bytes += DISPLAY_I2C_TRANSFER_OVERHEAD + (column - start) * 8;
+        }
+    }
+    releaseBus();
+    
+    flushCount++;
+    lastFlushBytes = bytes;
+    lastLegacyBytes = legacyBytes;
+    totalFlushBytes += bytes;
+    totalLegacyBytes += legacyBytes;
+}
+
+String DisplayManager::abbreviate(const String& text) const {
+    // "RX: " 뒤에 남는 폭에 맞춰 긴 메시지는 "..."로 줄임
+    if (text.length() <= 16) {
+        return text;
+    }
+    return text.substring(0, 13) + "...";
+}
+
+String DisplayManager::getStatusString() const {
+    // 예: "display: updates:120 flushes:42 last:30/412B total:1260/17304B" (diff/이전 방식, I2C 추정치)
+    String status = "display: updates:";
+    status += modelUpdateCount;
+    status += " flushes:";
+    status += flushCount;
+    status += " last:";
+    status += lastFlushBytes;
+    status += "/";
+    status += lastLegacyBytes;
+    status += "B total:";
+    status += totalFlushBytes;
+    status += "/";
+    status += totalLegacyBytes;
+    status += "B";
+    return status;
 }
 
 void DisplayManager::showMessageReceivedEffect() {
-    // LED 깜빡임 효과
-    digitalWrite(LED_PIN, HIGH);
-    delay(100);
-    digitalWrite(LED_PIN, LOW);
-    delay(100);
-    digitalWrite(LED_PIN, HIGH);
-    delay(100);
-    digitalWrite(LED_PIN, LOW);
+    // LED 깜빡임 효과 (타이머로 진행되므로 바로 반환)
+    if (ledEffects) {
+        ledEffects->trigger(LED_PATTERN_MESSAGE);
+    }
 }
 
 void DisplayManager::showStartupEffect() {
     // 시작 신호로 LED 3번 깜빡임
-    for (int i = 0; i < 3; i++) {
-        digitalWrite(LED_PIN, HIGH);
-        delay(200);
-        digitalWrite(LED_PIN, LOW);
-        delay(200);
+    if (ledEffects) {
+        ledEffects->trigger(LED_PATTERN_STARTUP);
     }
 }
 
 void DisplayManager::displayEncoderInfo() {
     if (!encoderManager) return;
     
-    display->clearLine(7);
-    display->setCursor(0, 7);
-    display->print("FL:");
-    display->print(encoderManager->getEncoderCount(MOTOR_FRONT_LEFT) / 100);
-    display->print(" FR:");
-    display->print(encoderManager->getEncoderCount(MOTOR_FRONT_RIGHT) / 100);
+    writeLine(7, "FL:" + String(encoderManager->getEncoderCount(MOTOR_FRONT_LEFT) / 100) +
+                 " FR:" + String(encoderManager->getEncoderCount(MOTOR_FRONT_RIGHT) / 100));
 }
 
 void DisplayManager::displayMotorStatus() {
     if (!motorController) return;
     
-    display->clearLine(7);
-    display->setCursor(0, 7);
-    display->print("Status: ");
-    display->print(motorController->isMotorRunning() ? "RUNNING" : "STOPPED");
+    writeLine(7, motorController->isMotorRunning() ? "Status: RUNNING" : "Status: STOPPED");
 }
\ No newline at end of file
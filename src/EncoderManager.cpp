@@ -1,4 +1,6 @@
 #include "EncoderManager.h"
+#include "ParameterRegistry.h"
+#include "Profiler.h"
 
 // 싱글톤 인스턴스 초기화
 EncoderManager* EncoderManager::instance = nullptr;
@@ -90,7 +92,7 @@ void EncoderManager::printEncoderInfo() {
 }
 
 void EncoderManager::periodicPrint() {
-    if (millis() - lastPrintTime >= ENCODER_PRINT_INTERVAL) {
+    if (millis() - lastPrintTime >= ParameterRegistry::values().encoderPrintMs) {
         printEncoderInfo();
         lastPrintTime = millis();
     }
@@ -98,6 +100,7 @@ void EncoderManager::periodicPrint() {
 
 // 정적 ISR 함수들
 void IRAM_ATTR EncoderManager::encoderFL_ISR() {
+    PROFILE_SCOPE(PROFILE_ENCODER_ISR);
     if (instance) {
         bool direction = digitalRead(ENCODER_FL_B) == HIGH;
         instance->updateEncoderFL(direction);
@@ -105,6 +108,7 @@ void IRAM_ATTR EncoderManager::encoderFL_ISR() {
 }
 
 void IRAM_ATTR EncoderManager::encoderFR_ISR() {
+    PROFILE_SCOPE(PROFILE_ENCODER_ISR);
     if (instance) {
         bool direction = digitalRead(ENCODER_FR_B) == HIGH;
         instance->updateEncoderFR(direction);
@@ -112,6 +116,7 @@ void IRAM_ATTR EncoderManager::encoderFR_ISR() {
 }
 
 void IRAM_ATTR EncoderManager::encoderRL_ISR() {
+    PROFILE_SCOPE(PROFILE_ENCODER_ISR);
     if (instance) {
         bool direction = digitalRead(ENCODER_RL_B) == HIGH;
         instance->updateEncoderRL(direction);
@@ -119,6 +124,7 @@ void IRAM_ATTR EncoderManager::encoderRL_ISR() {
 }
 
 void IRAM_ATTR EncoderManager::encoderRR_ISR() {
+    PROFILE_SCOPE(PROFILE_ENCODER_ISR);
     if (instance) {
         bool direction = digitalRead(ENCODER_RR_B) == HIGH;
         instance->updateEncoderRR(direction);
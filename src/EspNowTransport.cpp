@@ -0,0 +1,274 @@
+#include "EspNowTransport.h"
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include "LatencyTracker.h"
+#include "SerialFrameCodec.h"
+
+EspNowTransport* EspNowTransport::instance = nullptr;
+
+EspNowTransport::EspNowTransport()
+    : commandQueue(nullptr), initialized(false), paired(false), pairing(false), pairingStartTime(0),
+      pairingPending(false), lastReceiveTime(0), lastAppliedSequence(COMMAND_SEQUENCE_NONE),
+      packetsReceived(0), packetsRejected(0), queueDrops(0), reportedQueueDrops(0), sendFailures(0) {
+    stateLock = portMUX_INITIALIZER_UNLOCKED;
+    memset(peerAddress, 0, sizeof(peerAddress));
+    memset(pendingAddress, 0, sizeof(pendingAddress));
+    instance = this;
+}
+
+EspNowTransport::~EspNowTransport() {
+    if (initialized) {
+        esp_now_deinit();
+    }
+    preferences.end();
+    instance = nullptr;
+}
+
+bool EspNowTransport::initialize() {
+    // ESP-NOW는 WiFi STA 인터페이스 위에서 동작 (AP 연결 없이 고정 채널 사용)
+    WiFi.mode(WIFI_STA);
+    esp_wifi_set_channel(ESPNOW_CHANNEL, WIFI_SECOND_CHAN_NONE);
+    
+    if (esp_now_init() != ESP_OK) {
+        Serial.println("Failed to initialize ESP-NOW!");
+        return false;
+    }
+    esp_now_register_recv_cb(&EspNowTransport::receiveCallback);
+    initialized = true;
+    
+    // 저장된 컨트롤러 복원
+    if (preferences.begin(ESPNOW_NVS_NAMESPACE, false) &&
+        preferences.getBytes("peer", peerAddress, sizeof(peerAddress)) == sizeof(peerAddress)) {
+        paired = addPeer(peerAddress);
+    }
+    
+    Serial.print("ESP-NOW initialized on channel ");
+    Serial.print(ESPNOW_CHANNEL);
+    Serial.print(", MAC: ");
+    Serial.println(WiFi.macAddress());
+    return true;
+}
+
+void EspNowTransport::setCommandQueue(CommandQueue* queue) {
+    commandQueue = queue;
+}
+
+void EspNowTransport::startPairing() {
+    portENTER_CRITICAL(&stateLock);
+    pairingStartTime = millis();
+    pairing = true;
+    portEXIT_CRITICAL(&stateLock);
+    Serial.println("ESP-NOW pairing window opened");
+}
+
+void EspNowTransport::unpair() {
+    uint8_t address[6];
+    portENTER_CRITICAL(&stateLock);
+    bool wasPaired = paired;
+    memcpy(address, peerAddress, sizeof(address));
+    paired = false;
+    lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+    memset(peerAddress, 0, sizeof(peerAddress));
+    portEXIT_CRITICAL(&stateLock);
+    
+    if (wasPaired) {
+        esp_now_del_peer(address);
+    }
+    preferences.remove("peer");
+    Serial.println("ESP-NOW controller unpaired");
+}
+
+bool EspNowTransport::isPaired() const {
+    return paired;
+}
+
+const char* EspNowTransport::getName() const {
+    return "espnow";
+}
+
+bool EspNowTransport::isActive() const {
+    return paired && lastReceiveTime != 0 && millis() - lastReceiveTime < ESPNOW_LINK_TIMEOUT_MS;
+}
+
+void EspNowTransport::update() {
+    uint8_t newAddress[6];
+    uint8_t oldAddress[6];
+    portENTER_CRITICAL(&stateLock);
+    bool windowClosed = pairing && millis() - pairingStartTime > ESPNOW_PAIRING_WINDOW_MS;
+    if (windowClosed) {
+        pairing = false;
+    }
+    bool newPeer = pairingPending;
+    bool wasPaired = paired;
+    memcpy(newAddress, pendingAddress, sizeof(newAddress));
+    memcpy(oldAddress, peerAddress, sizeof(oldAddress));
+    portEXIT_CRITICAL(&stateLock);
+    
+    if (windowClosed) {
+        Serial.println("ESP-NOW pairing window closed");
+    }
+    
+    // 콜백에서 받은 새 컨트롤러를 피어로 등록하고 NVS에 저장 (스택 호출은 잠금 밖에서)
+    if (newPeer) {
+        if (wasPaired) {
+            esp_now_del_peer(oldAddress);
+        }
+        bool added = addPeer(newAddress);
+        
+        portENTER_CRITICAL(&stateLock);
+        memcpy(peerAddress, newAddress, sizeof(peerAddress));
+        paired = added;
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        pairingPending = false;
+        portEXIT_CRITICAL(&stateLock);
+        
+        if (added) {
+            preferences.putBytes("peer", newAddress, sizeof(newAddress));
+            Serial.println("ESP-NOW controller paired");
+        }
+    }
+    
+    unsigned long drops = queueDrops;
+    if (drops != reportedQueueDrops) {
+        Serial.print("Warning: Command queue full, ESP-NOW commands dropped: ");
+        Serial.println(drops - reportedQueueDrops);
+        reportedQueueDrops = drops;
+    }
+}
+
+bool EspNowTransport::sendResponse(const char* text, size_t length) {
+    return sendPacket(SERIAL_FRAME_RESPONSE, (const uint8_t*)text, length);
+}
+
+bool EspNowTransport::sendTelemetry(const uint8_t* data, size_t length) {
+    return sendPacket(SERIAL_FRAME_TELEMETRY, data, length);
+}
+
+size_t EspNowTransport::getMaxPayload() const {
+    return ESP_NOW_MAX_DATA_LEN - SERIAL_FRAME_HEADER_SIZE;
+}
+
+uint16_t EspNowTransport::getLastAppliedSequence() const {
+    return lastAppliedSequence;
+}
+
+void EspNowTransport::acknowledgeSequence(uint16_t sequence) {
+    lastAppliedSequence = sequence;
+}
+
+String EspNowTransport::getStatusString() const {
+    String status = "espnow:";
+    status += paired ? (isActive() ? "active" : "paired") : (pairing ? "pairing" : "unpaired");
+    status += " rx:";
+    status += packetsReceived;
+    status += " rejected:";
+    status += packetsRejected;
+    status += " qdrop:";
+    status += queueDrops;
+    status += " txfail:";
+    status += sendFailures;
+    return status;
+}
+
+void EspNowTransport::receiveCallback(const uint8_t* mac, const uint8_t* data, int length) {
+    if (instance) {
+        instance->onReceive(mac, data, length);
+    }
+}
+
+void EspNowTransport::onReceive(const uint8_t* mac, const uint8_t* data, int length) {
+    uint32_t rxCycles = LatencyTracker::now();
+    
+    if (length <= SERIAL_FRAME_HEADER_SIZE || data[0] != SERIAL_FRAME_COMMAND) {
+        packetsRejected++;
+        return;
+    }
+    
+    // 페어링된 컨트롤러만 허용 (페어링 창에서는 처음 보낸 컨트롤러를 받아들임)
+    unsigned long now = millis();
+    portENTER_CRITICAL(&stateLock);
+    bool accepted = paired && memcmp(mac, peerAddress, sizeof(peerAddress)) == 0;
+    if (!accepted) {
+        if (pairingPending && memcmp(mac, pendingAddress, sizeof(pendingAddress)) == 0) {
+            // 저장 대기 중인 새 컨트롤러
+            accepted = true;
+        } else if (pairing && !pairingPending) {
+            memcpy(pendingAddress, mac, sizeof(pendingAddress));
+            pairing = false;
+            pairingPending = true;
+            accepted = true;
+        }
+    }
+    if (accepted) {
+        // 링크가 끊겼다가 다시 들어온 첫 패킷이면 ACK를 새로 시작
+        if (lastReceiveTime == 0 || now - lastReceiveTime >= ESPNOW_LINK_TIMEOUT_MS) {
+            lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        }
+        lastReceiveTime = now;
+    }
+    portEXIT_CRITICAL(&stateLock);
+    
+    if (!accepted) {
+        packetsRejected++;
+        return;
+    }
+    packetsReceived++;
+    
+    CommandMessage message;
+    message.source = COMMAND_SOURCE_ESPNOW;
+    message.transport = this;
+    message.sequence = data[1] | (data[2] << 8);
+    message.hasSequence = message.sequence != COMMAND_SEQUENCE_NONE;
+    message.clientTime = (uint32_t)data[3] | ((uint32_t)data[4] << 8) |
+                         ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 24);
+    message.rxCycles = rxCycles;
+    
+    size_t textLength = length - SERIAL_FRAME_HEADER_SIZE;
+    message.overLength = textLength > COMMAND_MAX_LENGTH;
+    if (message.overLength) textLength = COMMAND_MAX_LENGTH;
+    memcpy(message.text, data + SERIAL_FRAME_HEADER_SIZE, textLength);
+    message.text[textLength] = '\0';
+    message.length = textLength;
+    
+    if (!commandQueue || !commandQueue->push(message)) {
+        queueDrops++;
+    }
+}
+
+bool EspNowTransport::addPeer(const uint8_t* address) {
+    esp_now_peer_info_t peer = {};
+    memcpy(peer.peer_addr, address, sizeof(peer.peer_addr));
+    peer.channel = ESPNOW_CHANNEL;
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    
+    if (esp_now_is_peer_exist(address)) {
+        return true;
+    }
+    if (esp_now_add_peer(&peer) != ESP_OK) {
+        Serial.println("Failed to add ESP-NOW peer!");
+        return false;
+    }
+    return true;
+}
+
+bool EspNowTransport::sendPacket(uint8_t type, const uint8_t* payload, size_t length) {
+    if (!paired || length > getMaxPayload()) return false;
+    
+    uint8_t packet[ESP_NOW_MAX_DATA_LEN];
+    uint32_t now = micros();
+    packet[0] = type;
+    packet[1] = (uint8_t)(lastAppliedSequence & 0xFF);
+    packet[2] = (uint8_t)(lastAppliedSequence >> 8);
+    packet[3] = (uint8_t)(now & 0xFF);
+    packet[4] = (uint8_t)((now >> 8) & 0xFF);
+    packet[5] = (uint8_t)((now >> 16) & 0xFF);
+    packet[6] = (uint8_t)(now >> 24);
+    memcpy(packet + SERIAL_FRAME_HEADER_SIZE, payload, length);
+    
+    if (esp_now_send(peerAddress, packet, SERIAL_FRAME_HEADER_SIZE + length) != ESP_OK) {
+        sendFailures++;
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "FleetReceiver.h"
+#include "CommandCodec.h"
+#include "LatencyTracker.h"
+
+FleetReceiver::FleetReceiver()
+    : pScan(nullptr), commandQueue(nullptr), robotId(0), enabled(false), storagePending(false),
+      haveSequence(false), lastSequence(0), lastPacketTime(0), driving(false),
+      packetsApplied(0), packetsIgnored(0), timeoutStops(0) {
+}
+
+FleetReceiver::~FleetReceiver() {
+    if (pScan && enabled) {
+        pScan->stop();
+    }
+    preferences.end();
+}
+
+bool FleetReceiver::initialize() {
+    pScan = BLEDevice::getScan();
+    if (!pScan) {
+        Serial.println("Failed to get BLE scanner!");
+        return false;
+    }
+    
+    // 같은 송신기의 반복 광고도 모두 받아야 하므로 중복 허용, 응답 요청 없는 수동 스캔
+    pScan->setAdvertisedDeviceCallbacks(new FleetScanCallbacks(this), true);
+    pScan->setActiveScan(false);
+    pScan->setInterval(FLEET_SCAN_INTERVAL_MS);
+    pScan->setWindow(FLEET_SCAN_WINDOW_MS);
+    
+    if (preferences.begin(FLEET_NVS_NAMESPACE, false)) {
+        robotId = preferences.getUChar("id", 0);
+        enabled = preferences.getUChar("enabled", 0) != 0;
+    }
+    if (robotId > FLEET_MAX_ROBOT_ID) {
+        robotId = 0;
+    }
+    
+    if (enabled) {
+        startScan();
+    }
+    
+    Serial.print("Fleet receiver initialized: id ");
+    Serial.print(robotId);
+    Serial.println(enabled ? " (scanning)" : " (off)");
+    return true;
+}
+
+void FleetReceiver::setCommandQueue(CommandQueue* queue) {
+    commandQueue = queue;
+}
+
+void FleetReceiver::setEnabled(bool enable) {
+    if (enable == enabled || !pScan) return;
+    
+    enabled = enable;
+    storagePending = true;
+    
+    if (enabled) {
+        haveSequence = false;
+        startScan();
+    } else {
+        pScan->stop();
+        pScan->clearResults();
+        if (driving) {
+            pushStop();
+        }
+        Serial.println("Fleet scan stopped");
+    }
+}
+
+bool FleetReceiver::isEnabled() const {
+    return enabled;
+}
+
+bool FleetReceiver::setRobotId(int id) {
+    if (id < 0 || id > FLEET_MAX_ROBOT_ID) {
+        return false;
+    }
+    
+    robotId = (uint8_t)id;
+    storagePending = true;
+    return true;
+}
+
+void FleetReceiver::commitStorage() {
+    if (!storagePending) return;
+    
+    // 플래그를 먼저 내리고 현재 값을 기록 (그 사이의 변경은 다음 호출에서 다시 기록)
+    storagePending = false;
+    preferences.putUChar("id", robotId);
+    preferences.putUChar("enabled", enabled ? 1 : 0);
+}
+
+uint8_t FleetReceiver::getRobotId() const {
+    return robotId;
+}
+
+void FleetReceiver::update() {
+    if (!enabled) return;
+    
+    // 송신기가 사라지면 마지막 속도로 계속 달리지 않도록 정지
+    // 마지막 sequence는 기억해 두어 멈춘 송신기의 같은 패킷으로 다시 출발하지 않게 함
+    if (driving && millis() - lastPacketTime > FLEET_TIMEOUT_MS) {
+        timeoutStops++;
+        pushStop();
+        Serial.println("Fleet transmitter lost, stopping");
+    }
+}
+
+String FleetReceiver::getStatusString() const {
+    String status = "fleet:";
+    status += enabled ? "on" : "off";
+    status += " id:";
+    status += robotId;
+    status += " applied:";
+    status += packetsApplied;
+    status += " ignored:";
+    status += packetsIgnored;
+    status += " timeouts:";
+    status += timeoutStops;
+    return status;
+}
+
+void FleetReceiver::startScan() {
+    // duration 0 = 중지할 때까지 계속 스캔 (비차단)
+    pScan->start(0, nullptr, false);
+    Serial.println("Fleet scan started");
+}
+
+void FleetReceiver::onAdvertisement(BLEAdvertisedDevice& device) {
+    if (!device.haveManufacturerData()) return;
+    
+    std::string data = device.getManufacturerData();
+    FleetCommand command;
+    if (!FleetCodec::decode((const uint8_t*)data.data(), data.length(), command)) return;
+    
+    if (!FleetCodec::isAddressed(command, robotId)) {
+        packetsIgnored++;
+        return;
+    }
+    
+    // 같은 패킷의 반복 광고는 무시 (정지 시간 제한도 갱신하지 않음)
+    if (haveSequence && command.sequence == lastSequence) return;
+    haveSequence = true;
+    lastSequence = command.sequence;
+    lastPacketTime = millis();
+    
+    // CommandCodec 바이너리 배치로 변환해 다른 경로와 같은 방식으로 적용
+    uint8_t batch[8];
+    CommandCodec::BatchEncoder encoder;
+    encoder.begin(batch, sizeof(batch));
+    bool stop = (command.flags & FLEET_FLAG_STOP) || (command.vx == 0 && command.vy == 0 && command.omega == 0);
+    if (stop) {
+        encoder.stop();
+    } else {
+        encoder.velocity(command.vx, command.vy, command.omega);
+    }
+    driving = !stop;
+    
+    if (commandQueue && commandQueue->push(COMMAND_SOURCE_FLEET, nullptr, (const char*)batch, encoder.size(), LatencyTracker::now())) {
+        packetsApplied++;
+    }
+}
+
+void FleetReceiver::pushStop() {
+    driving = false;
+    
+    uint8_t batch[2];
+    CommandCodec::BatchEncoder encoder;
+    encoder.begin(batch, sizeof(batch));
+    encoder.stop();
+    if (commandQueue) {
+        commandQueue->push(COMMAND_SOURCE_FLEET, nullptr, (const char*)batch, encoder.size(), LatencyTracker::now());
+    }
+}
+
+// FleetScanCallbacks 구현
+FleetScanCallbacks::FleetScanCallbacks(FleetReceiver* fleetReceiver) : receiver(fleetReceiver) {
+}
+
+void FleetScanCallbacks::onResult(BLEAdvertisedDevice advertisedDevice) {
+    if (receiver) {
+        receiver->onAdvertisement(advertisedDevice);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "I2cBusScheduler.h"
+#include <Wire.h>
+
+I2cBusScheduler::I2cBusScheduler()
+    : owner(I2C_CLIENT_COUNT), acquiredUs(0), clockHz(I2C_BUS_CLOCK_HZ), resetCount(0) {
+    statsLock = portMUX_INITIALIZER_UNLOCKED;
+    busLock = xSemaphoreCreateMutex();
+    memset((void*)waiting, 0, sizeof(waiting));
+    memset(stats, 0, sizeof(stats));
+}
+
+I2cBusScheduler::~I2cBusScheduler() {
+    if (busLock) {
+        vSemaphoreDelete(busLock);
+    }
+}
+
+void I2cBusScheduler::acquire(I2cClient client) {
+    uint32_t requestUs = micros();
+    portENTER_CRITICAL(&statsLock);
+    waiting[client]++;
+    portEXIT_CRITICAL(&statsLock);
+    
+    xSemaphoreTake(busLock, portMAX_DELAY);
+    
+    // 같은 태스크 우선순위에서는 뮤텍스가 도착 순서로 넘어가므로, 더 급한 사용자가 기다리면 한 번 더 양보
+    while (isHigherPriorityWaiting(client)) {
+        xSemaphoreGive(busLock);
+        vTaskDelay(1);
+        xSemaphoreTake(busLock, portMAX_DELAY);
+    }
+    
+    uint32_t nowUs = micros();
+    uint32_t waitUs = nowUs - requestUs;
+    portENTER_CRITICAL(&statsLock);
+    waiting[client]--;
+    owner = client;
+    acquiredUs = nowUs;
+    ClientStats& clientStats = stats[client];
+    clientStats.transactions++;
+    clientStats.totalWaitUs += waitUs;
+    if (waitUs > clientStats.maxWaitUs) clientStats.maxWaitUs = waitUs;
+    portEXIT_CRITICAL(&statsLock);
+}
+
+void I2cBusScheduler::release() {
+    uint32_t holdUs = micros() - acquiredUs;
+    portENTER_CRITICAL(&statsLock);
+    if (owner < I2C_CLIENT_COUNT) {
+        ClientStats& clientStats = stats[owner];
+        clientStats.busTimeUs += holdUs;
+        if (holdUs > clientStats.maxHoldUs) clientStats.maxHoldUs = holdUs;
+    }
+    owner = I2C_CLIENT_COUNT;
+    portEXIT_CRITICAL(&statsLock);
+    
+    xSemaphoreGive(busLock);
+}
+
+bool I2cBusScheduler::yieldIfContended(I2cClient client) {
+    if (!isHigherPriorityWaiting(client)) return false;
+    
+    portENTER_CRITICAL(&statsLock);
+    stats[client].yields++;
+    portEXIT_CRITICAL(&statsLock);
+    
+    // 뮤텍스를 놓는 순간 대기 중인 (우선순위가 높은) 태스크가 먼저 실행됨
+    release();
+    acquire(client);
+    return true;
+}
+
+void I2cBusScheduler::resetBus(I2cClient client) {
+    Serial.println("Resetting I2C bus...");
+    acquire(client);
+    Wire.end();
+    Wire.begin();
+    Wire.setClock(clockHz);
+    release();
+    
+    portENTER_CRITICAL(&statsLock);
+    resetCount++;
+    portEXIT_CRITICAL(&statsLock);
+    
+    delay(100);  // I2C 버스 안정화를 위한 지연 (버스를 잡지 않은 채로 대기)
+    Serial.println("I2C bus reset completed");
+}
+
+uint32_t I2cBusScheduler::selectClock() {
+    static const uint32_t candidates[] = I2C_CLOCK_CANDIDATES;
+    const int candidateCount = sizeof(candidates) / sizeof(candidates[0]);
+    
+    acquire(I2C_CLIENT_MOTOR);
+    
+    // 가장 느린 속도에서 응답하는 장치만 검사 대상 (OLED가 없어도 모터 버스 속도는 정함)
+    Wire.setClock(candidates[candidateCount - 1]);
+    bool driverPresent = probeAddress(PCA9685_I2C_ADDRESS);
+    bool displayPresent = probeAddress(DISPLAY_I2C_ADDRESS);
+    
+    if (!driverPresent && !displayPresent) {
+        // 검증할 장치가 없으면 아무 속도나 통과하므로 시작 속도를 유지
+        clockHz = I2C_BUS_CLOCK_HZ;
+        Wire.setClock(clockHz);
+        release();
+        Serial.print("I2C clock probe skipped, no device responded - keeping ");
+        Serial.print(clockHz);
+        Serial.println("Hz");
+        return clockHz;
+    }
+    
+    clockHz = candidates[candidateCount - 1];
+    for (int i = 0; i < candidateCount; i++) {
+        Wire.setClock(candidates[i]);
+        bool passed = verifyClock(driverPresent, displayPresent);
+        Serial.print("I2C clock probe ");
+        Serial.print(candidates[i]);
+        Serial.println(passed ? "Hz: OK" : "Hz: failed");
+        if (passed) {
+            clockHz = candidates[i];
+            break;
+        }
+    }
+    Wire.setClock(clockHz);
+    release();
+    
+    Serial.print("I2C clock selected: ");
+    Serial.print(clockHz);
+    Serial.print("Hz (pca9685:");
+    Serial.print(driverPresent ? "yes" : "no");
+    Serial.print(" oled:");
+    Serial.print(displayPresent ? "yes" : "no");
+    Serial.println(")");
+    return clockHz;
+}
+
+uint32_t I2cBusScheduler::getClockHz() const {
+    return clockHz;
+}
+
+bool I2cBusScheduler::verifyClock(bool checkDriver, bool checkDisplay) {
+    bool passed = true;
+    for (int round = 0; round < I2C_CLOCK_PROBE_ROUNDS && passed; round++) {
+        if (checkDriver) {
+            // 매번 다른 값을 쓰고 다시 읽어 비트 오류까지 확인 (SUBADR의 최하위 비트는 읽기 전용 0)
+            uint8_t pattern = (uint8_t)(0xA4 ^ (round * 0x36)) & 0xFE;
+            Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+            Wire.write(PCA9685_SUBADR1);
+            Wire.write(pattern);
+            passed = Wire.endTransmission() == 0;
+            
+            if (passed) {
+                Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+                Wire.write(PCA9685_SUBADR1);
+                passed = Wire.endTransmission(false) == 0 &&
+                         Wire.requestFrom((uint8_t)PCA9685_I2C_ADDRESS, (uint8_t)1) == 1 &&
+                         Wire.read() == pattern;
+            }
+        }
+        if (passed && checkDisplay) {
+            // SSD1306은 읽기를 지원하지 않으므로 NOP 명령 쓰기로 확인
+            Wire.beginTransmission(DISPLAY_I2C_ADDRESS);
+            Wire.write(0x00);  // 명령 스트림
+            Wire.write(0xE3);  // NOP
+            passed = Wire.endTransmission() == 0;
+        }
+    }
+    
+    if (checkDriver) {
+        // 실패한 속도에서는 복원 쓰기도 실패할 수 있으므로 가장 느린 속도에서 기본값을 다시 씀
+        static const uint32_t candidates[] = I2C_CLOCK_CANDIDATES;
+        if (!passed) {
+            Wire.setClock(candidates[sizeof(candidates) / sizeof(candidates[0]) - 1]);
+        }
+        Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+        Wire.write(PCA9685_SUBADR1);
+        Wire.write(PCA9685_SUBADR1_DEFAULT);
+        Wire.endTransmission();
+    }
+    return passed;
+}
+
+bool I2cBusScheduler::probeAddress(uint8_t address) {
+    Wire.beginTransmission(address);
+    return Wire.endTransmission() == 0;
+}
+
+void I2cBusScheduler::resetStats() {
+    portENTER_CRITICAL(&statsLock);
+    memset(stats, 0, sizeof(stats));
+    resetCount = 0;
+    portEXIT_CRITICAL(&statsLock);
+}
+
+String I2cBusScheduler::getStatusString() {
+    ClientStats snapshot[I2C_CLIENT_COUNT];
+    portENTER_CRITICAL(&statsLock);
+    memcpy(snapshot, stats, sizeof(snapshot));
+    unsigned long resets = resetCount;
+    portEXIT_CRITICAL(&statsLock);
+    
+    // 예: "i2c: clock:1000000 resets:0 motor:n=120 bus=14400us hold<=130us wait<=820us/avg12us yields:0 ..."
+    String status = "i2c: clock:";
+    status += clockHz;
+    status += " resets:";
+    status += resets;
+    for (int i = 0; i < I2C_CLIENT_COUNT; i++) {
+        const ClientStats& clientStats = snapshot[i];
+        if (clientStats.transactions == 0) continue;
+        
+        status += " ";
+        status += clientToString(static_cast<I2cClient>(i));
+        status += ":n=";
+        status += clientStats.transactions;
+        status += " bus=";
+        status += (unsigned long)clientStats.busTimeUs;
+        status += "us hold<=";
+        status += clientStats.maxHoldUs;
+        status += "us wait<=";
+        status += clientStats.maxWaitUs;
+        status += "us/avg";
+        status += (unsigned long)(clientStats.totalWaitUs / clientStats.transactions);
+        status += "us yields:";
+        status += clientStats.yields;
+    }
+    return status;
+}
+
+bool I2cBusScheduler::isHigherPriorityWaiting(I2cClient client) {
+    for (int i = 0; i < client; i++) {
+        if (waiting[i] > 0) return true;
+    }
+    return false;
+}
+
+const char* I2cBusScheduler::clientToString(I2cClient client) {
+    switch (client) {
+        case I2C_CLIENT_MOTOR: return "motor";
+        case I2C_CLIENT_SENSOR: return "sensor";
+        case I2C_CLIENT_DISPLAY: return "display";
+        default: return "unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "I2cHealthMonitor.h"
+#include "I2cBusScheduler.h"
+#include "CommandProcessor.h"
+#include "DisplayManager.h"
+#include <Wire.h>
+
+// Wire.endTransmission 반환값: 2/3은 주소/데이터 NACK, 그 밖의 0이 아닌 값은 타임아웃/버스 오류
+static bool isNackError(uint8_t error) {
+    return error == 2 || error == 3;
+}
+
+I2cHealthMonitor::I2cHealthMonitor()
+    : i2cBus(nullptr), commandProcessor(nullptr), displayManager(nullptr),
+      state(I2C_HEALTH_OK), recoveryRequested(false), stateStartMs(0), lastProbeMs(0), recoveryAttempts(0),
+      recoveryCount(0), failedRecoveryCount(0), lastRecoveryStartMs(0), lastRecoveryMs(0), lastReleasePulses(0) {
+    statsLock = portMUX_INITIALIZER_UNLOCKED;
+    memset(devices, 0, sizeof(devices));
+    devices[I2C_DEVICE_MOTOR_DRIVER].address = PCA9685_I2C_ADDRESS;
+    devices[I2C_DEVICE_DISPLAY].address = DISPLAY_I2C_ADDRESS;
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        devices[i].online = true;
+    }
+}
+
+void I2cHealthMonitor::setI2cBusScheduler(I2cBusScheduler* scheduler) {
+    i2cBus = scheduler;
+}
+
+void I2cHealthMonitor::setCommandProcessor(CommandProcessor* processor) {
+    commandProcessor = processor;
+}
+
+void I2cHealthMonitor::setDisplayManager(DisplayManager* display) {
+    displayManager = display;
+}
+
+void I2cHealthMonitor::recordResult(uint8_t address, uint8_t error) {
+    int index = findDevice(address);
+    if (index < 0) return;
+    
+    portENTER_CRITICAL(&statsLock);
+    DeviceHealth& device = devices[index];
+    if (error == 0) {
+        device.ackCount++;
+        device.consecutiveFailures = 0;
+    } else {
+        if (isNackError(error)) {
+            device.nackCount++;
+        } else {
+            device.timeoutCount++;
+        }
+        if (device.consecutiveFailures < 255) {
+            device.consecutiveFailures++;
+        }
+        device.lastError = error;
+    }
+    portEXIT_CRITICAL(&statsLock);
+}
+
+void I2cHealthMonitor::update(unsigned long nowMs) {
+    switch (state) {
+        case I2C_HEALTH_OK:
+            if (nowMs - lastProbeMs >= I2C_HEALTH_PROBE_INTERVAL_MS) {
+                lastProbeMs = nowMs;
+                probeDevices();
+            }
+            if (recoveryRequested || needsRecovery()) {
+                recoveryRequested = false;
+                recoveryAttempts = 0;
+                lastRecoveryStartMs = nowMs;
+                Serial.println("I2C bus fault detected, starting recovery");
+                enterState(I2C_HEALTH_RECOVER, nowMs);
+            }
+            break;
+            
+        case I2C_HEALTH_RECOVER:
+            // 한 번의 update에서 끝나는 짧은 구간 (SCL 펄스 최대 9개, 약 100us)
+            recoveryAttempts++;
+            lastReleasePulses = releaseBus();
+            enterState(I2C_HEALTH_SETTLE, nowMs);
+            break;
+            
+        case I2C_HEALTH_SETTLE:
+            if (nowMs - stateStartMs >= I2C_RECOVERY_SETTLE_MS) {
+                enterState(I2C_HEALTH_RESYNC_MOTOR, nowMs);
+            }
+            break;
+            
+        case I2C_HEALTH_RESYNC_MOTOR:
+            // 모터 드라이버가 먼저: 레지스터를 다시 설정하고 발진기가 안정되면 정지 프레임 출력
+            if (probe(I2C_DEVICE_MOTOR_DRIVER) == 0) {
+                devices[I2C_DEVICE_MOTOR_DRIVER].online = true;
+                if (commandProcessor) {
+                    commandProcessor->beginMotorResync();
+                }
+                enterState(I2C_HEALTH_RESYNC_OUTPUT, nowMs);
+            } else if (recoveryAttempts < I2C_RECOVERY_MAX_ATTEMPTS) {
+                enterState(I2C_HEALTH_RECOVER, nowMs);
+            } else {
+                devices[I2C_DEVICE_MOTOR_DRIVER].online = false;
+                failedRecoveryCount++;
+                Serial.println("I2C recovery failed, retrying later");
+                enterState(I2C_HEALTH_FAILED, nowMs);
+            }
+            break;
+            
+        case I2C_HEALTH_RESYNC_OUTPUT:
+            if (nowMs - stateStartMs >= I2C_RESYNC_WAKE_MS) {
+                if (commandProcessor) {
+                    commandProcessor->finishMotorResync();
+                }
+                recoveryCount++;
+                lastRecoveryMs = nowMs - lastRecoveryStartMs;
+                Serial.print("I2C bus recovered in ");
+                Serial.print(lastRecoveryMs);
+                Serial.println("ms, motors stopped");
+                enterState(I2C_HEALTH_RESYNC_DISPLAY, nowMs);
+            }
+            break;
+            
+        case I2C_HEALTH_RESYNC_DISPLAY:
+            // 다시 그리기는 디스플레이 태스크가 조각 단위로 진행
+            devices[I2C_DEVICE_DISPLAY].online = probe(I2C_DEVICE_DISPLAY) == 0;
+            if (displayManager) {
+                displayManager->setPanelOnline(devices[I2C_DEVICE_DISPLAY].online);
+            }
+            lastProbeMs = nowMs;
+            enterState(I2C_HEALTH_OK, nowMs);
+            break;
+            
+        case I2C_HEALTH_FAILED:
+            if (nowMs - stateStartMs >= I2C_RECOVERY_RETRY_MS) {
+                recoveryAttempts = 0;
+                enterState(I2C_HEALTH_RECOVER, nowMs);
+            }
+            break;
+    }
+}
+
+void I2cHealthMonitor::requestRecovery() {
+    recoveryRequested = true;
+}
+
+bool I2cHealthMonitor::isDeviceOnline(I2cDevice device) const {
+    return devices[device].online;
+}
+
+I2cHealthState I2cHealthMonitor::getState() const {
+    return state;
+}
+
+String I2cHealthMonitor::getStatusString() {
+    DeviceHealth snapshot[I2C_DEVICE_COUNT];
+    portENTER_CRITICAL(&statsLock);
+    memcpy(snapshot, devices, sizeof(snapshot));
+    portEXIT_CRITICAL(&statsLock);
+    
+    // 예: "i2c health: state:ok recoveries:1/0 last:23ms pulses:9 pca9685:on ack:812 nack:0 to:3 oled:on ..."
+    String status = "i2c health: state:";
+    status += stateToString(state);
+    status += " recoveries:";
+    status += recoveryCount;
+    status += "/";
+    status += failedRecoveryCount;
+    status += " last:";
+    status += lastRecoveryMs;
+    status += "ms pulses:";
+    status += lastReleasePulses;
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        const DeviceHealth& device = snapshot[i];
+        status += " ";
+        status += deviceToString(static_cast<I2cDevice>(i));
+        status += device.online ? ":on" : ":off";
+        status += " ack:";
+        status += device.ackCount;
+        status += " nack:";
+        status += device.nackCount;
+        status += " to:";
+        status += device.timeoutCount;
+    }
+    return status;
+}
+
+void I2cHealthMonitor::probeDevices() {
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        I2cDevice device = static_cast<I2cDevice>(i);
+        probe(device);
+    }
+    
+    // 디스플레이는 NACK만으로는 버스 복구까지 가지 않고 오프라인 처리 (다시 응답하면 전체 다시 그리기)
+    DeviceHealth& display = devices[I2C_DEVICE_DISPLAY];
+    bool responding = display.consecutiveFailures == 0;
+    if (responding != display.online &&
+        (responding || display.consecutiveFailures >= I2C_HEALTH_FAILURE_THRESHOLD)) {
+        display.online = responding;
+        Serial.println(responding ? "OLED back online" : "OLED offline");
+        if (displayManager) {
+            displayManager->setPanelOnline(responding);
+        }
+    }
+}
+
+uint8_t I2cHealthMonitor::probe(I2cDevice device) {
+    // 주소만 보내는 빈 쓰기 (가장 낮은 우선순위로, 복구 중인 모터 확인은 모터 우선순위로)
+    I2cClient client = state == I2C_HEALTH_RESYNC_MOTOR ? I2C_CLIENT_MOTOR : I2C_CLIENT_DISPLAY;
+    if (i2cBus) {
+        i2cBus->acquire(client);
+    }
+    Wire.beginTransmission(devices[device].address);
+    uint8_t error = Wire.endTransmission();
+    if (i2cBus) {
+        i2cBus->release();
+    }
+    recordResult(devices[device].address, error);
+    return error;
+}
+
+bool I2cHealthMonitor::needsRecovery() {
+    // 모터 드라이버가 연속으로 실패하거나, 어느 장치든 타임아웃/버스 오류가 이어지면 (SDA가 잡힌 경우)
+    bool recover = false;
+    portENTER_CRITICAL(&statsLock);
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        const DeviceHealth& device = devices[i];
+        if (device.consecutiveFailures < I2C_HEALTH_FAILURE_THRESHOLD) continue;
+        if (i == I2C_DEVICE_MOTOR_DRIVER || !isNackError(device.lastError)) {
+            recover = true;
+        }
+    }
+    portEXIT_CRITICAL(&statsLock);
+    return recover;
+}
+
+void I2cHealthMonitor::enterState(I2cHealthState newState, unsigned long nowMs) {
+    state = newState;
+    stateStartMs = nowMs;
+}
+
+uint8_t I2cHealthMonitor::releaseBus() {
+    // 다른 사용자가 끼어들지 않도록 모터 우선순위로 버스를 잡고 Wire를 잠시 내림
+    if (i2cBus) {
+        i2cBus->acquire(I2C_CLIENT_MOTOR);
+    }
+    Wire.end();
+    
+    // 슬레이브가 SDA를 잡고 있으면 SCL을 최대 9번 클록해 남은 바이트를 끝내게 함 (100kHz 속도)
+    pinMode(I2C_SDA_PIN, INPUT_PULLUP);
+    pinMode(I2C_SCL_PIN, OUTPUT_OPEN_DRAIN);
+    digitalWrite(I2C_SCL_PIN, HIGH);
+    delayMicroseconds(5);
+    uint8_t pulses = 0;
+    while (digitalRead(I2C_SDA_PIN) == LOW && pulses < 9) {
+        digitalWrite(I2C_SCL_PIN, LOW);
+        delayMicroseconds(5);
+        digitalWrite(I2C_SCL_PIN, HIGH);
+        delayMicroseconds(5);
+        pulses++;
+    }
+    
+    // STOP 조건 (SCL high 상태에서 SDA low → high)
+    pinMode(I2C_SDA_PIN, OUTPUT_OPEN_DRAIN);
+    digitalWrite(I2C_SDA_PIN, LOW);
+    delayMicroseconds(5);
+    digitalWrite(I2C_SDA_PIN, HIGH);
+    delayMicroseconds(5);
+    
+    Wire.begin();
+    Wire.setClock(i2cBus ? i2cBus->getClockHz() : I2C_BUS_CLOCK_HZ);
+    if (i2cBus) {
+        i2cBus->release();
+    }
+    
+    portENTER_CRITICAL(&statsLock);
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        devices[i].consecutiveFailures = 0;
+    }
+    portEXIT_CRITICAL(&statsLock);
+    return pulses;
+}
+
+int I2cHealthMonitor::findDevice(uint8_t address) const {
+    for (int i = 0; i < I2C_DEVICE_COUNT; i++) {
+        if (devices[i].address == address) return i;
+    }
+    return -1;
+}
+
+const char* I2cHealthMonitor::stateToString(I2cHealthState state) {
+    switch (state) {
+        case I2C_HEALTH_OK: return "ok";
+        case I2C_HEALTH_RECOVER: return "recover";
+        case I2C_HEALTH_SETTLE: return "settle";
+        case I2C_HEALTH_RESYNC_MOTOR: return "resync_motor";
+        case I2C_HEALTH_RESYNC_OUTPUT: return "resync_output";
+        case I2C_HEALTH_RESYNC_DISPLAY: return "resync_display";
+        case I2C_HEALTH_FAILED: return "failed";
+        default: return "unknown";
+    }
+}
+
+const char* I2cHealthMonitor::deviceToString(I2cDevice device) {
+    switch (device) {
+        case I2C_DEVICE_MOTOR_DRIVER: return "pca9685";
+        case I2C_DEVICE_DISPLAY: return "oled";
+        default: return "unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "I2cWorker.h"
+#include "I2cHealthMonitor.h"
+#include "TaskMonitor.h"
+#include <Wire.h>
+
+I2cWorker::I2cWorker()
+    : i2cBus(nullptr), healthMonitor(nullptr), taskMonitor(nullptr), monitorId(-1), taskHandle(nullptr), queue(nullptr), latestPending(false),
+      submittedCount(0), completedCount(0), coalescedCount(0), droppedCount(0), errorCount(0) {
+    slotLock = portMUX_INITIALIZER_UNLOCKED;
+    memset(&latestSlot, 0, sizeof(latestSlot));
+}
+
+I2cWorker::~I2cWorker() {
+    if (taskHandle) {
+        vTaskDelete(taskHandle);
+    }
+    if (queue) {
+        vQueueDelete(queue);
+    }
+}
+
+bool I2cWorker::initialize() {
+    if (taskHandle) {
+        Serial.println("I2C worker already initialized");
+        return true;
+    }
+    
+    queue = xQueueCreate(I2C_WORKER_QUEUE_LENGTH, sizeof(I2cTransaction));
+    if (!queue) {
+        Serial.println("Failed to create I2C worker queue!");
+        return false;
+    }
+    
+    if (xTaskCreate(taskEntry, "i2c", I2C_WORKER_TASK_STACK_SIZE, this, I2C_WORKER_TASK_PRIORITY, &taskHandle) != pdPASS) {
+        Serial.println("Failed to create I2C worker task!");
+        taskHandle = nullptr;
+        return false;
+    }
+    if (taskMonitor) {
+        monitorId = taskMonitor->registerTask(taskHandle, "i2c");
+    }
+    
+    Serial.println("I2C worker initialized");
+    return true;
+}
+
+void I2cWorker::setI2cBusScheduler(I2cBusScheduler* scheduler) {
+    i2cBus = scheduler;
+}
+
+void I2cWorker::setHealthMonitor(I2cHealthMonitor* monitor) {
+    healthMonitor = monitor;
+}
+
+void I2cWorker::setTaskMonitor(TaskMonitor* monitor) {
+    taskMonitor = monitor;
+}
+
+bool I2cWorker::isRunning() const {
+    return taskHandle != nullptr;
+}
+
+bool I2cWorker::submit(const I2cTransaction& transaction) {
+    if (!queue) return false;
+    
+    I2cTransaction queued = transaction;
+    queued.submitUs = micros();
+    if (xQueueSend(queue, &queued, 0) != pdTRUE) {
+        droppedCount++;
+        return false;
+    }
+    submittedCount++;
+    xTaskNotifyGive(taskHandle);
+    return true;
+}
+
+void I2cWorker::submitLatest(const I2cTransaction& transaction) {
+    if (!taskHandle) return;
+    
+    portENTER_CRITICAL(&slotLock);
+    if (latestPending) {
+        coalescedCount++;
+    }
+    latestSlot = transaction;
+    latestSlot.submitUs = micros();
+    latestPending = true;
+    submittedCount++;
+    portEXIT_CRITICAL(&slotLock);
+    
+    xTaskNotifyGive(taskHandle);
+}
+
+bool I2cWorker::waitIdle(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    // 접수된 요청은 전송되거나 더 새로운 프레임으로 대체되어야 끝남
+    while (completedCount + coalescedCount != submittedCount) {
+        if (millis() - start >= timeoutMs) return false;
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+const LatencyHistogram& I2cWorker::getBusHistogram() const {
+    return busHistogram;
+}
+
+void I2cWorker::resetStats() {
+    submittedCount = 0;
+    completedCount = 0;
+    coalescedCount = 0;
+    droppedCount = 0;
+    errorCount = 0;
+    completionHistogram.reset();
+    busHistogram.reset();
+}
+
+String I2cWorker::getStatusString() const {
+    // 예: "i2cq: sub:120 done:118 merged:2 dropped:0 err:0 | done n:118 p50:1023us ... | bus n:118 ..."
+    String status = "i2cq: sub:";
+    status += submittedCount;
+    status += " done:";
+    status += completedCount;
+    status += " merged:";
+    status += coalescedCount;
+    status += " dropped:";
+    status += droppedCount;
+    status += " err:";
+    status += errorCount;
+    status += " | ";
+    status += completionHistogram.toString("done");
+    status += " | ";
+    status += busHistogram.toString("bus");
+    return status;
+}
+
+void I2cWorker::taskEntry(void* arg) {
+    I2cWorker* worker = static_cast<I2cWorker*>(arg);
+    I2cTransaction transaction;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t wakeUs = micros();
+        
+        // 최신 모터 프레임을 먼저, 그다음 큐를 비움
+        while (true) {
+            bool haveWork = false;
+            portENTER_CRITICAL(&worker->slotLock);
+            if (worker->latestPending) {
+                transaction = worker->latestSlot;
+                worker->latestPending = false;
+                haveWork = true;
+            }
+            portEXIT_CRITICAL(&worker->slotLock);
+            
+            if (!haveWork && xQueueReceive(worker->queue, &transaction, 0) == pdTRUE) {
+                haveWork = true;
+            }
+            if (!haveWork) break;
+            
+            worker->execute(transaction);
+        }
+        
+        // 전송 완료를 기다리며 잠든 시간도 포함됨 (버스 점유 시간은 통계의 bus 히스토그램 참고)
+        if (worker->taskMonitor) {
+            worker->taskMonitor->addBusyTime(worker->monitorId, micros() - wakeUs);
+        }
+    }
+}
+
+void I2cWorker::execute(I2cTransaction& transaction) {
+    if (i2cBus) {
+        i2cBus->acquire(transaction.client);
+    }
+    uint32_t startUs = micros();
+    Wire.beginTransmission(transaction.address);
+    Wire.write(transaction.data, transaction.length);
+    uint8_t error = Wire.endTransmission();
+    bool success = error == 0;
+    uint32_t doneUs = micros();
+    if (i2cBus) {
+        i2cBus->release();
+    }
+    if (healthMonitor) {
+        healthMonitor->recordResult(transaction.address, error);
+    }
+    
+    completedCount++;
+    if (!success) {
+        errorCount++;
+    }
+    busHistogram.record(doneUs - startUs);
+    completionHistogram.record(doneUs - transaction.submitUs);
+    
+    if (transaction.onComplete) {
+        transaction.onComplete(transaction.context, success);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "KeepaliveMonitor.h"
+#include "MotorController.h"
+#include "ParameterRegistry.h"
+
+KeepaliveMonitor::KeepaliveMonitor()
+    : motorController(nullptr), state(KEEPALIVE_OFF), periodMs(KEEPALIVE_DEFAULT_PERIOD_MS),
+      missLimit(KEEPALIVE_DEFAULT_MISSES), outputValid(false), setpointUs(0), rampStartUs(0),
+      setpointCount(0), timeoutCount(0), maxGapUs(0), lastReactionUs(0), maxReactionUs(0) {
+    memset(from, 0, sizeof(from));
+    memset(target, 0, sizeof(target));
+    memset(output, 0, sizeof(output));
+}
+
+void KeepaliveMonitor::setMotorController(MotorController* controller) {
+    motorController = controller;
+}
+
+bool KeepaliveMonitor::isValidConfig(int period, int misses) {
+    return period >= KEEPALIVE_MIN_PERIOD_MS && period <= KEEPALIVE_MAX_PERIOD_MS &&
+           misses >= 1 && misses <= KEEPALIVE_MAX_MISSES;
+}
+
+bool KeepaliveMonitor::configure(int period, int misses) {
+    if (!isValidConfig(period, misses)) {
+        return false;
+    }
+    
+    periodMs = (uint16_t)period;
+    missLimit = (uint8_t)misses;
+    if (state == KEEPALIVE_OFF) {
+        state = KEEPALIVE_WAITING;
+    }
+    maxGapUs = 0;
+    
+    Serial.print("Keepalive enabled, period: ");
+    Serial.print(periodMs);
+    Serial.print("ms, misses: ");
+    Serial.println(missLimit);
+    return true;
+}
+
+void KeepaliveMonitor::disable() {
+    // 감시 없이 마지막 출력으로 계속 달리지 않도록 스트리밍/감속 중에는 정지
+    if (isActive()) {
+        memset(output, 0, sizeof(output));
+        if (motorController) {
+            motorController->stop();
+        }
+        outputValid = false;
+        Serial.println("Keepalive disabled while active, motors stopped");
+    }
+    state = KEEPALIVE_OFF;
+    Serial.println("Keepalive disabled");
+}
+
+bool KeepaliveMonitor::isEnabled() const {
+    return state != KEEPALIVE_OFF;
+}
+
+bool KeepaliveMonitor::isActive() const {
+    return state == KEEPALIVE_STREAMING || state == KEEPALIVE_RAMPING;
+}
+
+void KeepaliveMonitor::setSetpoint(int8_t vx, int8_t vy, int8_t omega, uint32_t nowUs) {
+    if (state == KEEPALIVE_OFF) return;
+    
+    if (state == KEEPALIVE_STREAMING) {
+        uint32_t gap = nowUs - setpointUs;
+        if (gap > maxGapUs) maxGapUs = gap;
+    }
+    
+    target[0] = vx;
+    target[1] = vy;
+    target[2] = omega;
+    
+    if (state == KEEPALIVE_WAITING) {
+        // 스트림의 첫 설정값은 보간 없이 바로 출력 (현재 모터 출력을 알 수 없으므로)
+        memcpy(from, target, sizeof(from));
+        applyOutput(vx, vy, omega);
+    } else {
+        // 감속 중이거나 정지 후 재개하면 현재 출력에서 이어서 보간
+        memcpy(from, output, sizeof(from));
+    }
+    
+    setpointUs = nowUs;
+    state = KEEPALIVE_STREAMING;
+    setpointCount++;
+}
+
+void KeepaliveMonitor::cancel() {
+    // 이산 명령/매크로/복구가 모터를 가져감 - 다음 출력은 같은 값이어도 다시 씀
+    outputValid = false;
+    if (state != KEEPALIVE_OFF) {
+        state = KEEPALIVE_WAITING;
+    }
+}
+
+bool KeepaliveMonitor::update(uint32_t nowUs) {
+    if (state == KEEPALIVE_STREAMING) {
+        uint32_t elapsed = nowUs - setpointUs;
+        uint32_t periodUs = (uint32_t)periodMs * 1000;
+        uint32_t timeoutUs = periodUs * missLimit;
+        
+        if (elapsed < timeoutUs) {
+            // 다음 설정값이 올 때까지 한 주기에 걸쳐 선형 보간
+            uint32_t progress = elapsed < periodUs ? elapsed : periodUs;
+            int8_t next[3];
+            for (int i = 0; i < 3; i++) {
+                next[i] = from[i] + (int32_t)(target[i] - from[i]) * (int32_t)progress / (int32_t)periodUs;
+            }
+            applyOutput(next[0], next[1], next[2]);
+            return false;
+        }
+        
+        // 설정값 누락: 기한을 넘긴 만큼이 반응 시간 (틱 주기로 제한됨)
+        lastReactionUs = elapsed - timeoutUs;
+        if (lastReactionUs > maxReactionUs) maxReactionUs = lastReactionUs;
+        timeoutCount++;
+        memcpy(from, output, sizeof(from));
+        rampStartUs = nowUs;
+        state = KEEPALIVE_RAMPING;
+    }
+    
+    if (state == KEEPALIVE_RAMPING) {
+        uint32_t elapsed = nowUs - rampStartUs;
+        uint32_t rampUs = (uint32_t)ParameterRegistry::values().keepaliveRampMs * 1000;
+        
+        if (elapsed >= rampUs) {
+            memset(output, 0, sizeof(output));
+            if (motorController) {
+                motorController->stop();
+            }
+            outputValid = true;
+            state = KEEPALIVE_STOPPED;
+            return true;
+        }
+        
+        int8_t next[3];
+        for (int i = 0; i < 3; i++) {
+            next[i] = (int32_t)from[i] * (int32_t)(rampUs - elapsed) / (int32_t)rampUs;
+        }
+        applyOutput(next[0], next[1], next[2]);
+    }
+    return false;
+}
+
+void KeepaliveMonitor::applyOutput(int8_t vx, int8_t vy, int8_t omega) {
+    // 값이 바뀔 때만 I2C 출력 (매 틱 출력하지 않음)
+    // 0 출력이면 setBodyVelocity()가 DIR_STOP으로 바꾸므로 모터 방향이 아니라 자체 기록과 비교
+    if (outputValid && output[0] == vx && output[1] == vy && output[2] == omega) {
+        return;
+    }
+    
+    output[0] = vx;
+    output[1] = vy;
+    output[2] = omega;
+    outputValid = true;
+    if (motorController) {
+        motorController->setBodyVelocity(vx, vy, omega);
+    }
+}
+
+KeepaliveState KeepaliveMonitor::getState() const {
+    return state;
+}
+
+const char* KeepaliveMonitor::stateToString(KeepaliveState state) {
+    switch (state) {
+        case KEEPALIVE_WAITING: return "waiting";
+        case KEEPALIVE_STREAMING: return "streaming";
+        case KEEPALIVE_RAMPING: return "ramping";
+        case KEEPALIVE_STOPPED: return "stopped";
+        default: return "off";
+    }
+}
+
+String KeepaliveMonitor::getStatusString() const {
+    // 예: "keepalive:streaming period:50ms miss:3 setpoints:1200 gap:61ms timeouts:1 react:412us max:980us"
+    String status = "keepalive:";
+    status += stateToString(state);
+    if (state == KEEPALIVE_OFF) {
+        return status;
+    }
+    
+    status += " period:";
+    status += periodMs;
+    status += "ms miss:";
+    status += missLimit;
+    status += " setpoints:";
+    status += setpointCount;
+    status += " gap:";
+    status += maxGapUs / 1000;
+    status += "ms timeouts:";
+    status += timeoutCount;
+    status += " react:";
+    status += lastReactionUs;
+    status += "us max:";
+    status += maxReactionUs;
+    status += "us";
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint32_t us) {
+    int bucket = 0;
+    if (us > 0) {
+        bucket = 32 - __builtin_clz(us);
+        if (bucket >= BUCKET_COUNT) bucket = BUCKET_COUNT - 1;
+    }
+    
+    buckets[bucket]++;
+    count++;
+    sumUs += us;
+    if (us < minUs) minUs = us;
+    if (us > maxUs) maxUs = us;
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] = 0;
+    }
+    count = 0;
+    minUs = 0xFFFFFFFF;
+    maxUs = 0;
+    sumUs = 0;
+}
+
+uint32_t LatencyHistogram::getCount() const {
+    return count;
+}
+
+uint32_t LatencyHistogram::getMin() const {
+    return count > 0 ? minUs : 0;
+}
+
+uint32_t LatencyHistogram::getMax() const {
+    return maxUs;
+}
+
+uint32_t LatencyHistogram::getAverage() const {
+    return count > 0 ? (uint32_t)(sumUs / count) : 0;
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percent) const {
+    if (count == 0) return 0;
+    
+    // 누적 개수가 목표 순위에 도달하는 버킷을 찾는다
+    uint32_t target = ((uint64_t)count * percent + 99) / 100;
+    if (target == 0) target = 1;
+    
+    uint32_t cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            uint32_t upper = (i == 0) ? 0 : ((1UL << i) - 1);
+            return upper < maxUs ? upper : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+String LatencyHistogram::toString(const char* name) const {
+    String result = name;
+    result += " n:";
+    result += count;
+    result += " p50:";
+    result += getPercentile(50);
+    result += "us p99:";
+    result += getPercentile(99);
+    result += "us max:";
+    result += maxUs;
+    result += "us";
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "LatencyTracker.h"
+
+LatencyTracker::LatencyTracker() : cyclesPerUs(getCpuFrequencyMhz()) {
+    memset(&lastTrace, 0, sizeof(lastTrace));
+    if (cyclesPerUs == 0) cyclesPerUs = 160;
+}
+
+uint32_t LatencyTracker::now() {
+    return ESP.getCycleCount();
+}
+
+void LatencyTracker::record(const CommandTrace& trace) {
+    lastTrace = trace;
+    
+    // 사이클 카운터는 약 26초마다 랩어라운드되지만 단계 간 차이는 부호 없는 뺄셈으로 안전
+    if (trace.dequeueCycles) {
+        histograms[LATENCY_STAGE_QUEUE].record(cyclesToUs(trace.dequeueCycles - trace.rxCycles));
+    }
+    if (trace.parseCycles) {
+        histograms[LATENCY_STAGE_PARSE].record(cyclesToUs(trace.parseCycles - trace.dequeueCycles));
+    }
+    
+    // 모터 출력을 바꾼 명령만 이후 단계가 존재
+    if (trace.i2cStartCycles && trace.i2cDoneCycles) {
+        histograms[LATENCY_STAGE_DISPATCH].record(cyclesToUs(trace.i2cStartCycles - trace.parseCycles));
+        histograms[LATENCY_STAGE_I2C].record(cyclesToUs(trace.i2cDoneCycles - trace.i2cStartCycles));
+        histograms[LATENCY_STAGE_TOTAL].record(cyclesToUs(trace.i2cDoneCycles - trace.rxCycles));
+    }
+}
+
+void LatencyTracker::reset() {
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        histograms[i].reset();
+    }
+    memset(&lastTrace, 0, sizeof(lastTrace));
+}
+
+const LatencyHistogram& LatencyTracker::getHistogram(LatencyStage stage) const {
+    return histograms[stage];
+}
+
+String LatencyTracker::getStageString(LatencyStage stage) const {
+    return histograms[stage].toString(stageName(stage));
+}
+
+String LatencyTracker::getLastTraceString() const {
+    // 예: "trace seq:42 client:183201 queue:85us parse:40us dispatch:12us i2c:610us"
+    String result = "trace seq:";
+    result += lastTrace.hasSequence ? String(lastTrace.sequence) : String("-");
+    result += " client:";
+    result += lastTrace.clientTime;
+    result += " queue:";
+    result += cyclesToUs(lastTrace.dequeueCycles - lastTrace.rxCycles);
+    result += "us parse:";
+    result += cyclesToUs(lastTrace.parseCycles - lastTrace.dequeueCycles);
+    if (lastTrace.i2cStartCycles && lastTrace.i2cDoneCycles) {
+        result += "us dispatch:";
+        result += cyclesToUs(lastTrace.i2cStartCycles - lastTrace.parseCycles);
+        result += "us i2c:";
+        result += cyclesToUs(lastTrace.i2cDoneCycles - lastTrace.i2cStartCycles);
+    }
+    result += "us";
+    return result;
+}
+
+uint32_t LatencyTracker::cyclesToUs(uint32_t cycles) const {
+    return cycles / cyclesPerUs;
+}
+
+const char* LatencyTracker::stageName(LatencyStage stage) {
+    switch (stage) {
+        case LATENCY_STAGE_QUEUE: return "queue";
+        case LATENCY_STAGE_PARSE: return "parse";
+        case LATENCY_STAGE_DISPATCH: return "dispatch";
+        case LATENCY_STAGE_I2C: return "i2c";
+        case LATENCY_STAGE_TOTAL: return "total";
+        default: return "unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "LedEffectEngine.h"
+
+// 효과 정의
+struct LedPattern {
+    const LedStep* steps;
+    uint8_t stepCount;
+    LedPriority priority;
+    const char* name;
+};
+
+static const LedStep MESSAGE_STEPS[] = {
+    { true, 100 }, { false, 100 }, { true, 100 }, { false, 0 }
+};
+
+static const LedStep STARTUP_STEPS[] = {
+    { true, 200 }, { false, 200 }, { true, 200 }, { false, 200 }, { true, 200 }, { false, 200 }
+};
+
+static const LedPattern LED_PATTERNS[LED_PATTERN_COUNT] = {
+    { MESSAGE_STEPS, sizeof(MESSAGE_STEPS) / sizeof(LedStep), LED_PRIORITY_LOW, "message" },
+    { STARTUP_STEPS, sizeof(STARTUP_STEPS) / sizeof(LedStep), LED_PRIORITY_HIGH, "startup" }
+};
+
+LedEffectEngine::LedEffectEngine()
+    : stepTimer(nullptr), queueCount(0), activePattern(-1), activeStep(0), baseLevel(false),
+      triggerCount(0), coalescedCount(0), droppedCount(0), preemptedCount(0) {
+    lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+LedEffectEngine::~LedEffectEngine() {
+    if (stepTimer) {
+        esp_timer_stop(stepTimer);
+        esp_timer_delete(stepTimer);
+    }
+}
+
+bool LedEffectEngine::initialize() {
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &LedEffectEngine::timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "led_effect";
+    if (esp_timer_create(&timerArgs, &stepTimer) != ESP_OK) {
+        Serial.println("Failed to create LED effect timer!");
+        return false;
+    }
+    
+    Serial.println("LED effect engine initialized");
+    return true;
+}
+
+bool LedEffectEngine::trigger(LedPatternId pattern) {
+    if (!stepTimer || pattern >= LED_PATTERN_COUNT) return false;
+    
+    bool accepted = true;
+    portENTER_CRITICAL(&lock);
+    triggerCount++;
+    
+    bool pending = activePattern == pattern;
+    for (uint8_t i = 0; i < queueCount && !pending; i++) {
+        pending = queue[i] == pattern;
+    }
+    
+    if (pending) {
+        // 연속 수신 시 깜빡임이 쌓이지 않도록 합침
+        coalescedCount++;
+    } else if (activePattern < 0) {
+        startPattern(pattern);
+    } else if (LED_PATTERNS[pattern].priority > LED_PATTERNS[activePattern].priority) {
+        // 낮은 효과는 버리고 즉시 시작
+        esp_timer_stop(stepTimer);
+        preemptedCount++;
+        startPattern(pattern);
+    } else if (queueCount < LED_QUEUE_LENGTH) {
+        queue[queueCount++] = pattern;
+    } else {
+        droppedCount++;
+        accepted = false;
+    }
+    portEXIT_CRITICAL(&lock);
+    return accepted;
+}
+
+void LedEffectEngine::setBaseLevel(bool on) {
+    portENTER_CRITICAL(&lock);
+    baseLevel = on;
+    if (activePattern < 0) {
+        digitalWrite(LED_PIN, on ? HIGH : LOW);
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void LedEffectEngine::cancelAll() {
+    portENTER_CRITICAL(&lock);
+    if (stepTimer) {
+        esp_timer_stop(stepTimer);
+    }
+    queueCount = 0;
+    activePattern = -1;
+    digitalWrite(LED_PIN, baseLevel ? HIGH : LOW);
+    portEXIT_CRITICAL(&lock);
+}
+
+bool LedEffectEngine::isBusy() const {
+    return activePattern >= 0;
+}
+
+void LedEffectEngine::timerCallback(void* arg) {
+    LedEffectEngine* engine = static_cast<LedEffectEngine*>(arg);
+    engine->advance();
+}
+
+void LedEffectEngine::advance() {
+    portENTER_CRITICAL(&lock);
+    if (activePattern >= 0) {
+        activeStep++;
+        if (activeStep < LED_PATTERNS[activePattern].stepCount) {
+            applyStep();
+        } else {
+            // 효과 종료: 다음 효과 또는 기본 상태
+            int next = popNext();
+            if (next >= 0) {
+                startPattern(next);
+            } else {
+                activePattern = -1;
+                digitalWrite(LED_PIN, baseLevel ? HIGH : LOW);
+            }
+        }
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void LedEffectEngine::startPattern(int pattern) {
+    activePattern = pattern;
+    activeStep = 0;
+    applyStep();
+}
+
+int LedEffectEngine::popNext() {
+    if (queueCount == 0) return -1;
+    
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < queueCount; i++) {
+        if (LED_PATTERNS[queue[i]].priority > LED_PATTERNS[queue[best]].priority) {
+            best = i;
+        }
+    }
+    
+    int pattern = queue[best];
+    for (uint8_t i = best; i + 1 < queueCount; i++) {
+        queue[i] = queue[i + 1];
+    }
+    queueCount--;
+    return pattern;
+}
+
+void LedEffectEngine::applyStep() {
+    const LedStep& step = LED_PATTERNS[activePattern].steps[activeStep];
+    digitalWrite(LED_PIN, step.on ? HIGH : LOW);
+    
+    // 시간이 0인 마지막 단계는 다음 타이머 콜백에서 바로 종료 처리
+    esp_timer_start_once(stepTimer, step.durationMs > 0 ? (uint64_t)step.durationMs * 1000 : 1);
+}
+
+String LedEffectEngine::getStatusString() const {
+    // 예: "led:message queued:1 triggers:120 merged:98 dropped:0 preempted:1"
+    int pattern = activePattern;
+    String status = "led:";
+    status += pattern >= 0 ? LED_PATTERNS[pattern].name : (baseLevel ? "on" : "off");
+    status += " queued:";
+    status += queueCount;
+    status += " triggers:";
+    status += triggerCount;
+    status += " merged:";
+    status += coalescedCount;
+    status += " dropped:";
+    status += droppedCount;
+    status += " preempted:";
+    status += preemptedCount;
+    return status;
+}
\ No newline at end of file
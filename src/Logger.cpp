@@ -0,0 +1,157 @@
+#include "Logger.h"
+#include "SerialFrameCodec.h"
+
+uint8_t Logger::buffer[LOG_BUFFER_SIZE];
+volatile uint32_t Logger::head = 0;
+volatile uint32_t Logger::tail = 0;
+portMUX_TYPE Logger::lock = portMUX_INITIALIZER_UNLOCKED;
+bool Logger::textOutput = LOG_DEFAULT_TEXT_OUTPUT;
+uint16_t Logger::frameSequence = 0;
+unsigned long Logger::writtenCount = 0;
+volatile unsigned long Logger::droppedCount = 0;
+unsigned long Logger::reportedDropCount = 0;
+unsigned long Logger::framesSent = 0;
+uint32_t Logger::peakUsage = 0;
+
+void Logger::write(LogId id, const int32_t* args, uint8_t argCount, const char* text) {
+    // 인코딩은 잠금 밖에서, 링 버퍼 복사만 임계 구역에서
+    uint8_t record[LOG_MAX_RECORD_SIZE];
+    size_t length = LogCatalog::encodeRecord(id, micros(), args, argCount, text, record);
+    
+    portENTER_CRITICAL(&lock);
+    uint32_t used = head - tail;
+    if (used + length > LOG_BUFFER_SIZE) {
+        droppedCount++;
+        portEXIT_CRITICAL(&lock);
+        return;
+    }
+    for (size_t i = 0; i < length; i++) {
+        buffer[(head + i) & (LOG_BUFFER_SIZE - 1)] = record[i];
+    }
+    head += length;
+    writtenCount++;
+    if (used + length > peakUsage) {
+        peakUsage = used + length;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void Logger::drain() {
+    // 버퍼가 넘쳐 버린 레코드가 있으면 그 수를 로그로 남김 (다음 drain에서 출력)
+    unsigned long dropped = droppedCount;
+    if (dropped != reportedDropCount) {
+        unsigned long newlyDropped = dropped - reportedDropCount;
+        reportedDropCount = dropped;
+        LOG(LOG_DROPPED, newlyDropped);
+    }
+    
+    for (int i = 0; i < LOG_DRAIN_MAX_FRAMES; i++) {
+        bool sent = textOutput ? drainText() : drainBinary();
+        if (!sent) break;
+    }
+}
+
+void Logger::setTextOutput(bool enabled) {
+    textOutput = enabled;
+}
+
+bool Logger::isTextOutput() {
+    return textOutput;
+}
+
+void Logger::resetStats() {
+    portENTER_CRITICAL(&lock);
+    writtenCount = 0;
+    droppedCount = 0;
+    reportedDropCount = 0;
+    peakUsage = head - tail;
+    portEXIT_CRITICAL(&lock);
+    framesSent = 0;
+}
+
+String Logger::getStatusString() {
+    // 예: "log: mode:bin level:4 written:1203 dropped:0 frames:88 buf:0/4096 peak:512"
+    String status = "log: mode:";
+    status += textOutput ? "text" : "bin";
+    status += " level:";
+    status += LOG_COMPILE_LEVEL;
+    status += " written:";
+    status += writtenCount;
+    status += " dropped:";
+    status += (unsigned long)droppedCount;
+    status += " frames:";
+    status += framesSent;
+    status += " buf:";
+    status += usage();
+    status += "/";
+    status += LOG_BUFFER_SIZE;
+    status += " peak:";
+    status += peakUsage;
+    return status;
+}
+
+uint32_t Logger::usage() {
+    portENTER_CRITICAL(&lock);
+    uint32_t used = head - tail;
+    portEXIT_CRITICAL(&lock);
+    return used;
+}
+
+size_t Logger::peekRecord(uint32_t position, uint8_t* out) {
+    // head보다 앞의 바이트는 기록이 끝난 것이므로 잠금 없이 읽음 (tail은 drain만 옮김)
+    size_t length = buffer[position & (LOG_BUFFER_SIZE - 1)];
+    for (size_t i = 0; i < length; i++) {
+        out[i] = buffer[(position + i) & (LOG_BUFFER_SIZE - 1)];
+    }
+    return length;
+}
+
+bool Logger::drainBinary() {
+    // 레코드를 프레임 하나에 들어가는 만큼 이어 붙임
+    uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+    size_t payloadLength = 0;
+    uint32_t available = usage();
+    uint32_t position = tail;
+    while (position - tail < available) {
+        size_t length = buffer[position & (LOG_BUFFER_SIZE - 1)];
+        if (payloadLength + length > sizeof(payload)) break;
+        peekRecord(position, payload + payloadLength);
+        payloadLength += length;
+        position += length;
+    }
+    if (payloadLength == 0) return false;
+    
+    uint8_t encoded[SERIAL_FRAME_MAX_ENCODED];
+    size_t encodedLength = SerialFrameCodec::encodeFrame(SERIAL_FRAME_LOG, frameSequence, micros(),
+                                                         payload, payloadLength, encoded);
+    // 호스트가 읽지 않아 TX 버퍼가 차 있으면 레코드를 남겨 두고 다음에 다시 시도
+    if (encodedLength == 0 || Serial.availableForWrite() < (int)encodedLength) return false;
+    
+    Serial.write(encoded, encodedLength);
+    frameSequence++;
+    framesSent++;
+    portENTER_CRITICAL(&lock);
+    tail = position;
+    portEXIT_CRITICAL(&lock);
+    return true;
+}
+
+bool Logger::drainText() {
+    if (usage() == 0) return false;
+    
+    uint8_t record[LOG_MAX_RECORD_SIZE];
+    size_t length = peekRecord(tail, record);
+    
+    // 줄바꿈 자리 2바이트를 남기고 변환
+    char line[LOG_TEXT_LINE_SIZE];
+    size_t lineLength = LogCatalog::formatLine(record, length, line, sizeof(line) - 2);
+    line[lineLength++] = '\r';
+    line[lineLength++] = '\n';
+    if (Serial.availableForWrite() < (int)lineLength) return false;
+    
+    Serial.write((const uint8_t*)line, lineLength);
+    portENTER_CRITICAL(&lock);
+    tail += length;
+    portEXIT_CRITICAL(&lock);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "MacroManager.h"
+#include "MotorController.h"
+
+MacroManager::MacroManager()
+    : motorController(nullptr), dirtyMask(0), activeIndex(-1), activeStep(0), stepStartUs(0), runCount(0) {
+    storageLock = portMUX_INITIALIZER_UNLOCKED;
+    memset(macros, 0, sizeof(macros));
+    memset(&activeMacro, 0, sizeof(activeMacro));
+}
+
+MacroManager::~MacroManager() {
+    preferences.end();
+}
+
+bool MacroManager::initialize() {
+    if (!preferences.begin(MACRO_NVS_NAMESPACE, false)) {
+        Serial.println("Failed to open macro storage!");
+        return false;
+    }
+    
+    loadMacros();
+    
+    Serial.print("Macro manager initialized: ");
+    Serial.print(getCount());
+    Serial.println(" macros loaded");
+    return true;
+}
+
+void MacroManager::setMotorController(MotorController* controller) {
+    motorController = controller;
+}
+
+int MacroManager::defineMacro(const String& name, const MacroStep* steps, uint8_t stepCount) {
+    if (name.length() == 0 || name.length() > MACRO_NAME_MAX_LENGTH ||
+        stepCount == 0 || stepCount > MACRO_MAX_STEPS) {
+        return -1;
+    }
+    
+    // 같은 이름이 있으면 덮어쓰고, 없으면 빈 슬롯 사용
+    int index = findMacro(name);
+    if (index < 0) {
+        for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+            if (!macros[i].used) {
+                index = i;
+                break;
+            }
+        }
+    }
+    if (index < 0) {
+        return -1;
+    }
+    
+    portENTER_CRITICAL(&storageLock);
+    Macro& macro = macros[index];
+    macro.used = true;
+    strncpy(macro.name, name.c_str(), MACRO_NAME_MAX_LENGTH);
+    macro.name[MACRO_NAME_MAX_LENGTH] = '\0';
+    macro.stepCount = stepCount;
+    memcpy(macro.steps, steps, stepCount * sizeof(MacroStep));
+    dirtyMask |= 1 << index;
+    portEXIT_CRITICAL(&storageLock);
+    return index;
+}
+
+bool MacroManager::deleteMacro(const String& name) {
+    int index = findMacro(name);
+    if (index < 0) {
+        return false;
+    }
+    
+    portENTER_CRITICAL(&storageLock);
+    memset(&macros[index], 0, sizeof(Macro));
+    dirtyMask |= 1 << index;
+    portEXIT_CRITICAL(&storageLock);
+    return true;
+}
+
+void MacroManager::commitStorage() {
+    for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+        // 슬롯을 복사한 뒤 잠금 없이 기록 (그 사이에 다시 바뀌면 다음 호출에서 한 번 더 기록)
+        Macro macro;
+        portENTER_CRITICAL(&storageLock);
+        bool dirty = (dirtyMask & (1 << i)) != 0;
+        if (dirty) {
+            macro = macros[i];
+            dirtyMask &= ~(1 << i);
+        }
+        portEXIT_CRITICAL(&storageLock);
+        if (!dirty) continue;
+        
+        if (macro.used) {
+            if (!saveMacro(i, macro)) {
+                Serial.println("Failed to save macro to NVS");
+            }
+        } else {
+            char key[8];
+            makeKey(i, key);
+            preferences.remove(key);
+        }
+    }
+}
+
+int MacroManager::findMacro(const String& name) const {
+    for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+        if (macros[i].used && name == macros[i].name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool MacroManager::startMacro(int index, uint32_t nowUs) {
+    if (!isDefined(index) || !motorController) {
+        return false;
+    }
+    
+    portENTER_CRITICAL(&storageLock);
+    activeMacro = macros[index];
+    portEXIT_CRITICAL(&storageLock);
+    
+    activeIndex = index;
+    activeStep = 0;
+    stepStartUs = nowUs;
+    runCount++;
+    applyStep(activeMacro.steps[0]);
+    
+    Serial.print("Macro started: ");
+    Serial.println(activeMacro.name);
+    return true;
+}
+
+void MacroManager::stopMacro() {
+    if (activeIndex < 0) return;
+    
+    activeIndex = -1;
+    if (motorController) {
+        motorController->stop();
+    }
+    Serial.println("Macro stopped");
+}
+
+void MacroManager::cancel() {
+    activeIndex = -1;
+}
+
+bool MacroManager::isRunning() const {
+    return activeIndex >= 0;
+}
+
+bool MacroManager::update(uint32_t nowUs) {
+    if (activeIndex < 0) return false;
+    
+    const Macro& macro = activeMacro;
+    bool changed = false;
+    
+    // 단계 경계는 이전 경계에 누적하여 계산 (틱 지연이 다음 단계로 전파되지 않음)
+    while (activeIndex >= 0 &&
+           (int32_t)(nowUs - stepStartUs) >= (int32_t)macro.steps[activeStep].durationMs * 1000) {
+        stepStartUs += (uint32_t)macro.steps[activeStep].durationMs * 1000;
+        activeStep++;
+        changed = true;
+        
+        if (activeStep >= macro.stepCount) {
+            activeIndex = -1;
+            if (motorController) {
+                motorController->stop();
+            }
+            Serial.print("Macro finished: ");
+            Serial.println(macro.name);
+        } else {
+            applyStep(macro.steps[activeStep]);
+        }
+    }
+    return changed;
+}
+
+bool MacroManager::isDefined(int index) const {
+    return index >= 0 && index < MACRO_MAX_COUNT && macros[index].used;
+}
+
+uint8_t MacroManager::getCount() const {
+    uint8_t count = 0;
+    for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+        if (macros[i].used) count++;
+    }
+    return count;
+}
+
+String MacroManager::getMacroString(int index) const {
+    if (!isDefined(index)) {
+        return String("");
+    }
+    
+    const Macro& macro = macros[index];
+    unsigned long totalMs = 0;
+    for (int i = 0; i < macro.stepCount; i++) {
+        totalMs += macro.steps[i].durationMs;
+    }
+    
+    String info = "macro:";
+    info += index;
+    info += " ";
+    info += macro.name;
+    info += " steps:";
+    info += macro.stepCount;
+    info += " ";
+    info += totalMs;
+    info += "ms";
+    return info;
+}
+
+String MacroManager::getStatusString() const {
+    String status = "macros:";
+    status += getCount();
+    status += "/";
+    status += MACRO_MAX_COUNT;
+    status += " runs:";
+    status += runCount;
+    
+    if (activeIndex >= 0) {
+        status += " running:";
+        status += activeMacro.name;
+        status += " step:";
+        status += activeStep + 1;
+    }
+    return status;
+}
+
+void MacroManager::loadMacros() {
+    uint8_t record[2 + MACRO_NAME_MAX_LENGTH + MACRO_MAX_STEPS * 5];
+    char key[8];
+    
+    for (int i = 0; i < MACRO_MAX_COUNT; i++) {
+        makeKey(i, key);
+        if (!preferences.isKey(key)) continue;
+        
+        size_t length = preferences.getBytesLength(key);
+        if (length < 2 || length > sizeof(record)) continue;
+        preferences.getBytes(key, record, length);
+        
+        uint8_t stepCount = record[0];
+        uint8_t nameLength = record[1];
+        if (stepCount == 0 || stepCount > MACRO_MAX_STEPS || nameLength == 0 ||
+            nameLength > MACRO_NAME_MAX_LENGTH || length != 2u + nameLength + stepCount * 5u) {
+            Serial.print("Skipping corrupt macro record: ");
+            Serial.println(key);
+            continue;
+        }
+        
+        Macro& macro = macros[i];
+        macro.used = true;
+        memcpy(macro.name, record + 2, nameLength);
+        macro.name[nameLength] = '\0';
+        macro.stepCount = stepCount;
+        
+        const uint8_t* p = record + 2 + nameLength;
+        for (int s = 0; s < stepCount; s++, p += 5) {
+            macro.steps[s].vx = (int8_t)p[0];
+            macro.steps[s].vy = (int8_t)p[1];
+            macro.steps[s].omega = (int8_t)p[2];
+            macro.steps[s].durationMs = (uint16_t)(p[3] | (p[4] << 8));
+        }
+    }
+}
+
+bool MacroManager::saveMacro(int index, const Macro& macro) {
+    uint8_t record[2 + MACRO_NAME_MAX_LENGTH + MACRO_MAX_STEPS * 5];
+    uint8_t nameLength = (uint8_t)strlen(macro.name);
+    
+    record[0] = macro.stepCount;
+    record[1] = nameLength;
+    memcpy(record + 2, macro.name, nameLength);
+    
+    uint8_t* p = record + 2 + nameLength;
+    for (int s = 0; s < macro.stepCount; s++, p += 5) {
+        p[0] = (uint8_t)macro.steps[s].vx;
+        p[1] = (uint8_t)macro.steps[s].vy;
+        p[2] = (uint8_t)macro.steps[s].omega;
+        p[3] = (uint8_t)(macro.steps[s].durationMs & 0xFF);
+        p[4] = (uint8_t)(macro.steps[s].durationMs >> 8);
+    }
+    
+    char key[8];
+    makeKey(index, key);
+    size_t length = p - record;
+    return preferences.putBytes(key, record, length) == length;
+}
+
+void MacroManager::applyStep(const MacroStep& step) {
+    if (motorController) {
+        motorController->setBodyVelocity(step.vx, step.vy, step.omega);
+    }
+}
+
+void MacroManager::makeKey(int index, char* key) {
+    // "m0" ~ "m7"
+    snprintf(key, 8, "m%d", index);
+}
\ No newline at end of file
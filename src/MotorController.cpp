@@ -1,7 +1,25 @@
 #include "MotorController.h"
+#include <Wire.h>
+#include "LatencyTracker.h"
+#include "ParameterRegistry.h"
+#include "I2cBusScheduler.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+// 벤치마크 완료 기록: 대기 시간이 지난 뒤 도착한 완료도 안전하게 쓸 수 있도록 정적 슬롯에 프레임 번호와 함께 기록
+static portMUX_TYPE benchmarkLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t benchmarkFrameTag = 0;
+static uint32_t benchmarkDoneTag = 0;
+static uint32_t benchmarkDoneUs = 0;
 
 MotorController::MotorController() 
-    : pwm(nullptr), currentSpeed(PWM_HALF), currentDirection(DIR_STOP), isRunning(false) {
+    : pwm(nullptr), i2cBus(nullptr), outputWorker(nullptr), asyncOutput(I2C_ASYNC_MOTOR_OUTPUT), currentSpeed(PWM_HALF), currentDirection(DIR_STOP), isRunning(false), appliedPwmFrequency(0),
+      outputFrameCount(0), lastOutputStartCycles(0), lastOutputEndCycles(0), benchmarkPhase(BENCHMARK_IDLE),
+      benchmarkFrames(0), benchmarkIndex(0), benchmarkPending(false), benchmarkTag(0), benchmarkStartUs(0) {
+    for (int i = 0; i < 4; i++) {
+        wheelDuty[i] = 0;
+    }
+    memset(frameChannels, 0, sizeof(frameChannels));
 }
 
 MotorController::~MotorController() {
@@ -16,8 +34,10 @@ bool MotorController::initialize() {
         return false;
     }
     
+    acquireBus();
     pwm->begin();
-    pwm->setPWMFreq(PWM_FREQUENCY);
+    releaseBus();
+    applyPwmFrequency();
     
     // 모든 모터 정지 상태로 초기화
     setMecanumMotors(0, 0, 0, 0);
@@ -26,6 +46,217 @@ bool MotorController::initialize() {
     return true;
 }
 
+void MotorController::applyPwmFrequency() {
+    uint16_t frequency = ParameterRegistry::values().pwmFrequency;
+    if (!pwm || frequency == appliedPwmFrequency) return;
+    
+    // setPWMFreq()는 버스를 잡은 채 delay(5)를 하므로 직접 쓰고, 발진기 안정화는 버스를 놓고 기다림
+    acquireBus();
+    writePrescale(frequency);
+    releaseBus();
+    appliedPwmFrequency = frequency;
+    delayMicroseconds(PCA9685_WAKE_US);
+    writeFrame();  // 현재 출력 다시 쓰기
+    
+    Serial.print("PWM frequency set to: ");
+    Serial.println(frequency);
+}
+
+void MotorController::beginResync() {
+    if (!pwm) return;
+    
+    // 복구 중에 리셋되었을 수 있으므로 모드/주파수를 처음부터 다시 씀 (pwm->begin()의 delay(10) 없이)
+    uint16_t frequency = ParameterRegistry::values().pwmFrequency;
+    acquireBus();
+    writePrescale(frequency);
+    releaseBus();
+    appliedPwmFrequency = frequency;
+}
+
+void MotorController::resyncOutput() {
+    if (!pwm) return;
+    
+    // beginResync() 후 발진기가 안정되면 호출: 이전 출력 대신 정지 프레임을 보냄
+    stop();
+    Serial.println("Motor driver resynced (stopped)");
+}
+
+bool MotorController::writeRegister(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+void MotorController::writePrescale(uint16_t frequency) {
+    // Adafruit_PWMServoDriver::setPWMFreq()와 같은 계산 (25MHz / (4096 × freq) - 1)
+    int32_t prescale = ((int32_t)PCA9685_OSCILLATOR_HZ + (int32_t)frequency * 2048) / ((int32_t)frequency * 4096) - 1;
+    if (prescale < 3) prescale = 3;
+    if (prescale > 255) prescale = 255;
+    
+    writeRegister(PCA9685_MODE1, PCA9685_MODE1_AI | PCA9685_MODE1_SLEEP);
+    writeRegister(PCA9685_PRESCALE, (uint8_t)prescale);
+    writeRegister(PCA9685_MODE1, PCA9685_MODE1_AI);
+}
+
+void MotorController::setI2cBusScheduler(I2cBusScheduler* scheduler) {
+    i2cBus = scheduler;
+}
+
+void MotorController::setI2cWorker(I2cWorker* worker) {
+    outputWorker = worker;
+}
+
+void MotorController::setAsyncOutput(bool enabled) {
+    asyncOutput = enabled;
+    Serial.print("Motor output: ");
+    Serial.println(enabled ? "async" : "sync");
+}
+
+bool MotorController::isAsyncOutput() const {
+    return asyncOutput && outputWorker && outputWorker->isRunning();
+}
+
+void MotorController::writeFrame() {
+    if (isAsyncOutput()) {
+        submitFrame(nullptr, nullptr);
+    } else {
+        writeFrameSync();
+    }
+}
+
+size_t MotorController::buildFrame(uint8_t* data, int firstChannel, int count) const {
+    // 연속 채널을 자동 증가 쓰기 한 번으로 (시작 레지스터 + 채널마다 LEDn_ON_L, ON_H, OFF_L, OFF_H)
+    data[0] = PCA9685_LED0_ON_L + firstChannel * 4;
+    for (int i = 0; i < count; i++) {
+        uint16_t off = frameChannels[firstChannel + i];
+        uint8_t* registers = data + 1 + i * 4;
+        registers[0] = 0;
+        registers[1] = 0;
+        registers[2] = off & 0xFF;
+        registers[3] = off >> 8;
+    }
+    return 1 + count * 4;
+}
+
+void MotorController::writeFrameSync() {
+    writeChannelsSync(0, MOTOR_CHANNEL_COUNT);
+}
+
+void MotorController::writeChannelsSync(int firstChannel, int count) {
+    // 워커와 같은 연속 쓰기를 호출한 태스크에서 직접 수행 (전송이 끝날 때까지 멈춤)
+    uint8_t data[I2C_TRANSACTION_MAX_LENGTH];
+    size_t length = buildFrame(data, firstChannel, count);
+    acquireBus();
+    Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+    Wire.write(data, length);
+    Wire.endTransmission();
+    releaseBus();
+}
+
+void MotorController::submitFrame(I2cCompletion onComplete, void* context) {
+    I2cTransaction transaction;
+    transaction.client = I2C_CLIENT_MOTOR;
+    transaction.address = PCA9685_I2C_ADDRESS;
+    transaction.length = buildFrame(transaction.data, 0, MOTOR_CHANNEL_COUNT);
+    transaction.onComplete = onComplete;
+    transaction.context = context;
+    outputWorker->submitLatest(transaction);
+}
+
+void MotorController::onBenchmarkComplete(void* context, bool success) {
+    // context는 프레임 번호 (스택 변수 주소를 넘기면 시간 초과 후 완료가 죽은 스택에 쓰게 됨)
+    uint32_t nowUs = micros();
+    portENTER_CRITICAL(&benchmarkLock);
+    benchmarkDoneTag = (uint32_t)(uintptr_t)context;
+    benchmarkDoneUs = nowUs;
+    portEXIT_CRITICAL(&benchmarkLock);
+}
+
+bool MotorController::startBenchmark(int frames) {
+    if (!pwm) return false;
+    
+    benchmarkSyncHistogram.reset();
+    benchmarkAsyncHistogram.reset();
+    benchmarkDoneHistogram.reset();
+    benchmarkFrames = frames;
+    benchmarkIndex = 0;
+    benchmarkPending = false;
+    benchmarkPhase = BENCHMARK_SYNC;
+    return true;
+}
+
+void MotorController::updateBenchmark(uint32_t nowUs) {
+    // 같은 프레임을 다시 쓰므로 바퀴 출력은 바뀌지 않음
+    if (benchmarkPhase == BENCHMARK_SYNC) {
+        uint32_t start = micros();
+        writeFrameSync();
+        benchmarkSyncHistogram.record(micros() - start);
+        if (++benchmarkIndex >= benchmarkFrames) {
+            benchmarkIndex = 0;
+            benchmarkPhase = (outputWorker && outputWorker->isRunning()) ? BENCHMARK_ASYNC : BENCHMARK_DONE;
+        }
+        return;
+    }
+    if (benchmarkPhase != BENCHMARK_ASYNC) return;
+    
+    if (benchmarkPending) {
+        // 프레임이 합쳐지지 않도록 완료(또는 시간 초과)를 확인한 뒤 다음 틱에 다음 프레임
+        // 시간 초과로 늦게 온 이전 프레임의 완료는 번호가 달라 무시됨
+        portENTER_CRITICAL(&benchmarkLock);
+        bool done = benchmarkDoneTag == benchmarkTag;
+        uint32_t doneUs = benchmarkDoneUs;
+        portEXIT_CRITICAL(&benchmarkLock);
+        if (done) {
+            benchmarkDoneHistogram.record(doneUs - benchmarkStartUs);
+        } else if (nowUs - benchmarkStartUs < I2C_BENCHMARK_FRAME_TIMEOUT_US) {
+            return;
+        }
+        benchmarkPending = false;
+        if (++benchmarkIndex >= benchmarkFrames) {
+            benchmarkPhase = BENCHMARK_DONE;
+        }
+        return;
+    }
+    
+    benchmarkTag = ++benchmarkFrameTag;
+    benchmarkStartUs = micros();
+    submitFrame(onBenchmarkComplete, (void*)(uintptr_t)benchmarkTag);
+    benchmarkAsyncHistogram.record(micros() - benchmarkStartUs);
+    benchmarkPending = true;
+}
+
+bool MotorController::isBenchmarkRunning() const {
+    return benchmarkPhase == BENCHMARK_SYNC || benchmarkPhase == BENCHMARK_ASYNC;
+}
+
+String MotorController::getBenchmarkResult() const {
+    if (!pwm) return "i2c:bench unavailable";
+    
+    // 예: "i2c:bench frames:20 | sync n:20 p50:1023us ... | async n:20 p50:15us ... | done n:20 ..."
+    String result = "i2c:bench frames:";
+    result += benchmarkFrames;
+    result += " | ";
+    result += benchmarkSyncHistogram.toString("sync");
+    result += " | ";
+    result += benchmarkAsyncHistogram.toString("async");
+    result += " | ";
+    result += benchmarkDoneHistogram.toString("done");
+    return result;
+}
+
+void MotorController::acquireBus() {
+    if (i2cBus) {
+        i2cBus->acquire(I2C_CLIENT_MOTOR);
+    }
+}
+
+void MotorController::releaseBus() {
+    if (i2cBus) {
+        i2cBus->release();
+    }
+}
+
 void MotorController::setMotor(MotorIndex motorIndex, int speed) {
     int speedChannel, dirAChannel, dirBChannel;
     String motorName;
@@ -56,82 +287,104 @@ void MotorController::setMotor(MotorIndex motorIndex, int speed) {
             motorName = "RR";
             break;
         default:
-            Serial.println("Invalid motor index");
+            LOG(LOG_MOTOR_INVALID_INDEX, motorIndex);
             return;
     }
     
     int pwmSpeed = abs(speed);
     if (pwmSpeed > PWM_MAX) pwmSpeed = PWM_MAX;
     
+    lastOutputStartCycles = LatencyTracker::now();
     if (speed > 0) {
         // 정방향
-        pwm->setPWM(dirAChannel, 0, PWM_MAX);
-        pwm->setPWM(dirBChannel, 0, 0);
+        frameChannels[dirAChannel] = PWM_MAX;
+        frameChannels[dirBChannel] = 0;
     } else if (speed < 0) {
         // 역방향
-        pwm->setPWM(dirAChannel, 0, 0);
-        pwm->setPWM(dirBChannel, 0, PWM_MAX);
+        frameChannels[dirAChannel] = 0;
+        frameChannels[dirBChannel] = PWM_MAX;
     } else {
         // 정지
-        pwm->setPWM(dirAChannel, 0, 0);
-        pwm->setPWM(dirBChannel, 0, 0);
+        frameChannels[dirAChannel] = 0;
+        frameChannels[dirBChannel] = 0;
     }
     
     // 속도 설정
-    pwm->setPWM(speedChannel, 0, pwmSpeed);
+    frameChannels[speedChannel] = pwmSpeed;
+    if (isAsyncOutput()) {
+        submitFrame(nullptr, nullptr);
+    } else {
+        // 동기 출력은 이 바퀴의 세 채널만 연속 쓰기 (나머지 9채널은 다시 쓰지 않음)
+        int firstChannel = min(speedChannel, min(dirAChannel, dirBChannel));
+        int lastChannel = max(speedChannel, max(dirAChannel, dirBChannel));
+        writeChannelsSync(firstChannel, lastChannel - firstChannel + 1);
+    }
+    lastOutputEndCycles = LatencyTracker::now();
+    outputFrameCount++;
+    wheelDuty[motorIndex - MOTOR_FRONT_LEFT] = speed < 0 ? -pwmSpeed : pwmSpeed;
     
-    Serial.print(motorName);
-    Serial.print(" Motor: ");
-    Serial.println(speed);
+    LOG_TEXT(LOG_MOTOR_SET, motorName.c_str(), speed);
 }
 
 void MotorController::setMecanumMotors(int frontLeft, int frontRight, int rearLeft, int rearRight) {
+    PROFILE_SCOPE(PROFILE_MECANUM_SET);
+    lastOutputStartCycles = LatencyTracker::now();
+    
+    // 최대 출력 파라미터: 바퀴 간 비율을 유지하며 축소
+    uint8_t maxSpeed = ParameterRegistry::values().maxSpeed;
+    if (maxSpeed < 100) {
+        frontLeft = frontLeft * maxSpeed / 100;
+        frontRight = frontRight * maxSpeed / 100;
+        rearLeft = rearLeft * maxSpeed / 100;
+        rearRight = rearRight * maxSpeed / 100;
+    }
+    
     // 전방 좌측 모터
     if (frontLeft > 0) {
-        pwm->setPWM(MOTOR_FL_DIR_A, 0, PWM_MAX);
-        pwm->setPWM(MOTOR_FL_DIR_B, 0, 0);
+        frameChannels[MOTOR_FL_DIR_A] = PWM_MAX;
+        frameChannels[MOTOR_FL_DIR_B] = 0;
     } else if (frontLeft < 0) {
-        pwm->setPWM(MOTOR_FL_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_FL_DIR_B, 0, PWM_MAX);
+        frameChannels[MOTOR_FL_DIR_A] = 0;
+        frameChannels[MOTOR_FL_DIR_B] = PWM_MAX;
     } else {
-        pwm->setPWM(MOTOR_FL_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_FL_DIR_B, 0, 0);
+        frameChannels[MOTOR_FL_DIR_A] = 0;
+        frameChannels[MOTOR_FL_DIR_B] = 0;
     }
     
     // 전방 우측 모터
     if (frontRight > 0) {
-        pwm->setPWM(MOTOR_FR_DIR_A, 0, PWM_MAX);
-        pwm->setPWM(MOTOR_FR_DIR_B, 0, 0);
+        frameChannels[MOTOR_FR_DIR_A] = PWM_MAX;
+        frameChannels[MOTOR_FR_DIR_B] = 0;
     } else if (frontRight < 0) {
-        pwm->setPWM(MOTOR_FR_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_FR_DIR_B, 0, PWM_MAX);
+        frameChannels[MOTOR_FR_DIR_A] = 0;
+        frameChannels[MOTOR_FR_DIR_B] = PWM_MAX;
     } else {
-        pwm->setPWM(MOTOR_FR_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_FR_DIR_B, 0, 0);
+        frameChannels[MOTOR_FR_DIR_A] = 0;
+        frameChannels[MOTOR_FR_DIR_B] = 0;
     }
     
     // 후방 좌측 모터
     if (rearLeft > 0) {
-        pwm->setPWM(MOTOR_RL_DIR_A, 0, PWM_MAX);
-        pwm->setPWM(MOTOR_RL_DIR_B, 0, 0);
+        frameChannels[MOTOR_RL_DIR_A] = PWM_MAX;
+        frameChannels[MOTOR_RL_DIR_B] = 0;
     } else if (rearLeft < 0) {
-        pwm->setPWM(MOTOR_RL_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_RL_DIR_B, 0, PWM_MAX);
+        frameChannels[MOTOR_RL_DIR_A] = 0;
+        frameChannels[MOTOR_RL_DIR_B] = PWM_MAX;
     } else {
-        pwm->setPWM(MOTOR_RL_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_RL_DIR_B, 0, 0);
+        frameChannels[MOTOR_RL_DIR_A] = 0;
+        frameChannels[MOTOR_RL_DIR_B] = 0;
     }
     
     // 후방 우측 모터
     if (rearRight > 0) {
-        pwm->setPWM(MOTOR_RR_DIR_A, 0, PWM_MAX);
-        pwm->setPWM(MOTOR_RR_DIR_B, 0, 0);
+        frameChannels[MOTOR_RR_DIR_A] = PWM_MAX;
+        frameChannels[MOTOR_RR_DIR_B] = 0;
     } else if (rearRight < 0) {
-        pwm->setPWM(MOTOR_RR_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_RR_DIR_B, 0, PWM_MAX);
+        frameChannels[MOTOR_RR_DIR_A] = 0;
+        frameChannels[MOTOR_RR_DIR_B] = PWM_MAX;
     } else {
-        pwm->setPWM(MOTOR_RR_DIR_A, 0, 0);
-        pwm->setPWM(MOTOR_RR_DIR_B, 0, 0);
+        frameChannels[MOTOR_RR_DIR_A] = 0;
+        frameChannels[MOTOR_RR_DIR_B] = 0;
     }
     
     // 속도 설정 (동시에)
@@ -145,21 +398,22 @@ void MotorController::setMecanumMotors(int frontLeft, int frontRight, int rearLe
     if (pwmRL > PWM_MAX) pwmRL = PWM_MAX;
     if (pwmRR > PWM_MAX) pwmRR = PWM_MAX;
     
-    pwm->setPWM(MOTOR_FL_SPEED, 0, pwmFL);
-    pwm->setPWM(MOTOR_FR_SPEED, 0, pwmFR);
-    pwm->setPWM(MOTOR_RL_SPEED, 0, pwmRL);
-    pwm->setPWM(MOTOR_RR_SPEED, 0, pwmRR);
+    frameChannels[MOTOR_FL_SPEED] = pwmFL;
+    frameChannels[MOTOR_FR_SPEED] = pwmFR;
+    frameChannels[MOTOR_RL_SPEED] = pwmRL;
+    frameChannels[MOTOR_RR_SPEED] = pwmRR;
+    writeFrame();
+    lastOutputEndCycles = LatencyTracker::now();
+    outputFrameCount++;
+    
+    wheelDuty[0] = frontLeft < 0 ? -pwmFL : pwmFL;
+    wheelDuty[1] = frontRight < 0 ? -pwmFR : pwmFR;
+    wheelDuty[2] = rearLeft < 0 ? -pwmRL : pwmRL;
+    wheelDuty[3] = rearRight < 0 ? -pwmRR : pwmRR;
     
     isRunning = (frontLeft != 0 || frontRight != 0 || rearLeft != 0 || rearRight != 0);
     
-    Serial.print("Mecanum Motors - FL:");
-    Serial.print(frontLeft);
-    Serial.print(" FR:");
-    Serial.print(frontRight);
-    Serial.print(" RL:");
-    Serial.print(rearLeft);
-    Serial.print(" RR:");
-    Serial.println(rearRight);
+    LOG(LOG_MECANUM_SET, frontLeft, frontRight, rearLeft, rearRight);
 }
 
 void MotorController::moveForward() {
@@ -208,14 +462,25 @@ void MotorController::stop() {
     isRunning = false;
 }
 
+void MotorController::setBodyVelocity(int vx, int vy, int omega) {
+    int frontLeft = vx - vy - omega;
+    int frontRight = vx + vy + omega;
+    int rearLeft = vx + vy - omega;
+    int rearRight = vx - vy + omega;
+    
+    // 합성 결과가 100%를 넘으면 바퀴 간 비율을 유지하며 축소
+    int peak = max(max(abs(frontLeft), abs(frontRight)), max(abs(rearLeft), abs(rearRight)));
+    int scale = peak > 100 ? peak : 100;
+    
+    setMecanumMotors(frontLeft * PWM_MAX / scale, frontRight * PWM_MAX / scale,
+                     rearLeft * PWM_MAX / scale, rearRight * PWM_MAX / scale);
+    currentDirection = isRunning ? DIR_VELOCITY : DIR_STOP;
+}
+
 void MotorController::setSpeed(int speed) {
     // 0-100% 범위를 PWM 값으로 변환
     currentSpeed = map(constrain(speed, 0, 100), 0, 100, 0, PWM_MAX);
-    Serial.print("Speed set to: ");
-    Serial.print(speed);
-    Serial.print("% (PWM: ");
-    Serial.print(currentSpeed);
-    Serial.println(")");
+    LOG(LOG_SPEED_SET, speed, currentSpeed);
 }
 
 int MotorController::getSpeed() const {
@@ -231,6 +496,25 @@ bool MotorController::isMotorRunning() const {
     return isRunning;
 }
 
+int MotorController::getWheelDuty(MotorIndex motorIndex) const {
+    if (motorIndex < MOTOR_FRONT_LEFT || motorIndex > MOTOR_REAR_RIGHT) {
+        return 0;
+    }
+    return wheelDuty[motorIndex - MOTOR_FRONT_LEFT];
+}
+
+uint32_t MotorController::getOutputFrameCount() const {
+    return outputFrameCount;
+}
+
+uint32_t MotorController::getLastOutputStartCycles() const {
+    return lastOutputStartCycles;
+}
+
+uint32_t MotorController::getLastOutputEndCycles() const {
+    return lastOutputEndCycles;
+}
+
 String MotorController::directionToString(Direction dir) const {
     switch(dir) {
         case DIR_STOP: return "STOP";
@@ -242,6 +526,7 @@ String MotorController::directionToString(Direction dir) const {
         case DIR_ROTATE_RIGHT: return "ROT_RIGHT";
         case DIR_DIAGONAL_FL: return "DIAG_FL";
         case DIR_DIAGONAL_FR: return "DIAG_FR";
+        case DIR_VELOCITY: return "VELOCITY";
         default: return "UNKNOWN";
     }
 }
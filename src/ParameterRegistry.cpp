@@ -0,0 +1,248 @@
+#include "ParameterRegistry.h"
+#include <stddef.h>
+
+// 파라미터 테이블 (ID 순)
+static const ParameterInfo PARAMETER_TABLE[] = {
+    { PARAM_MAX_SPEED, "max_speed", PARAM_TYPE_U8,
+      offsetof(RobotParameters, maxSpeed), 0, 100, 100 },
+    { PARAM_PWM_FREQUENCY, "pwm_freq", PARAM_TYPE_U16,
+      offsetof(RobotParameters, pwmFrequency), 24, 1526, PWM_FREQUENCY },   // PCA9685 지원 범위
+    { PARAM_ENCODER_PRINT_MS, "encoder_print_ms", PARAM_TYPE_U32,
+      offsetof(RobotParameters, encoderPrintMs), 100, 600000, ENCODER_PRINT_INTERVAL },
+    { PARAM_TELEMETRY_BATCH_MS, "telemetry_batch_ms", PARAM_TYPE_U16,
+      offsetof(RobotParameters, telemetryBatchMs), 1, 1000, TELEMETRY_MAX_BATCH_MS },
+    { PARAM_KEEPALIVE_RAMP_MS, "keepalive_ramp_ms", PARAM_TYPE_U16,
+      offsetof(RobotParameters, keepaliveRampMs), 0, 5000, KEEPALIVE_RAMP_MS }
+};
+
+static const uint8_t PARAMETER_COUNT = sizeof(PARAMETER_TABLE) / sizeof(PARAMETER_TABLE[0]);
+
+RobotParameters ParameterRegistry::current;
+
+ParameterRegistry::ParameterRegistry() : storageReady(false), savePending(false) {
+    saveLock = portMUX_INITIALIZER_UNLOCKED;
+    // 다른 모듈이 initialize() 전에 읽어도 기본값을 보도록 생성 시점에 채움
+    resetToDefaults();
+}
+
+ParameterRegistry::~ParameterRegistry() {
+    preferences.end();
+}
+
+bool ParameterRegistry::initialize() {
+    storageReady = preferences.begin(PARAM_NVS_NAMESPACE, false);
+    if (!storageReady) {
+        Serial.println("Failed to open parameter storage!");
+        return false;
+    }
+    
+    load();
+    Serial.print("Parameter registry initialized: ");
+    Serial.print(PARAMETER_COUNT);
+    Serial.println(" parameters");
+    return true;
+}
+
+uint8_t ParameterRegistry::getCount() {
+    return PARAMETER_COUNT;
+}
+
+const ParameterInfo* ParameterRegistry::getInfo(uint8_t index) {
+    return index < PARAMETER_COUNT ? &PARAMETER_TABLE[index] : nullptr;
+}
+
+const ParameterInfo* ParameterRegistry::findById(uint8_t id) {
+    for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+        if (PARAMETER_TABLE[i].id == id) return &PARAMETER_TABLE[i];
+    }
+    return nullptr;
+}
+
+const ParameterInfo* ParameterRegistry::findByName(const String& name) {
+    for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+        if (name == PARAMETER_TABLE[i].name) return &PARAMETER_TABLE[i];
+    }
+    return nullptr;
+}
+
+int32_t ParameterRegistry::get(const ParameterInfo& info) const {
+    return readField(current, info);
+}
+
+int32_t ParameterRegistry::readField(const RobotParameters& values, const ParameterInfo& info) {
+    const uint8_t* field = (const uint8_t*)&values + info.offset;
+    switch (info.type) {
+        case PARAM_TYPE_U8: return *field;
+        case PARAM_TYPE_U16: return *(const uint16_t*)field;
+        case PARAM_TYPE_U32: return (int32_t)*(const uint32_t*)field;
+        default: return *(const int32_t*)field;
+    }
+}
+
+ParameterStatus ParameterRegistry::set(const ParameterInfo& info, int32_t value) {
+    if (value < info.minValue || value > info.maxValue) {
+        return PARAM_STATUS_OUT_OF_RANGE;
+    }
+    
+    uint8_t* field = (uint8_t*)&current + info.offset;
+    switch (info.type) {
+        case PARAM_TYPE_U8: *field = (uint8_t)value; break;
+        case PARAM_TYPE_U16: *(uint16_t*)field = (uint16_t)value; break;
+        case PARAM_TYPE_U32: *(uint32_t*)field = (uint32_t)value; break;
+        default: *(int32_t*)field = value; break;
+    }
+    return PARAM_STATUS_OK;
+}
+
+void ParameterRegistry::resetToDefaults() {
+    for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+        set(PARAMETER_TABLE[i], PARAMETER_TABLE[i].defaultValue);
+    }
+}
+
+void ParameterRegistry::makeKey(uint8_t id, char* key) {
+    // ID 기준 키라 테이블 순서가 바뀌어도 저장값이 유지됨
+    snprintf(key, 8, "p%u", id);
+}
+
+void ParameterRegistry::load() {
+    char key[8];
+    for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+        const ParameterInfo& info = PARAMETER_TABLE[i];
+        makeKey(info.id, key);
+        if (!preferences.isKey(key)) continue;
+        
+        // 펌웨어 갱신으로 범위가 좁아졌으면 기본값 유지
+        if (set(info, preferences.getInt(key, info.defaultValue)) != PARAM_STATUS_OK) {
+            Serial.print("Stored parameter out of range: ");
+            Serial.println(info.name);
+        }
+    }
+}
+
+bool ParameterRegistry::save() {
+    if (!storageReady) return false;
+    
+    portENTER_CRITICAL(&saveLock);
+    pendingSave = current;
+    savePending = true;
+    portEXIT_CRITICAL(&saveLock);
+    return true;
+}
+
+void ParameterRegistry::commitStorage() {
+    if (!savePending) return;
+    
+    RobotParameters values;
+    portENTER_CRITICAL(&saveLock);
+    values = pendingSave;
+    savePending = false;
+    portEXIT_CRITICAL(&saveLock);
+    
+    char key[8];
+    for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+        makeKey(PARAMETER_TABLE[i].id, key);
+        if (preferences.putInt(key, readField(values, PARAMETER_TABLE[i])) == 0) {
+            Serial.println("Failed to save parameters to NVS");
+            return;
+        }
+    }
+    Serial.println("Parameters saved");
+}
+
+int32_t ParameterRegistry::readInt32(const uint8_t* in) {
+    return (int32_t)((uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24));
+}
+
+size_t ParameterRegistry::writeRecord(const ParameterInfo& info, uint8_t* out) const {
+    uint32_t value = (uint32_t)get(info);
+    out[0] = info.id;
+    out[1] = (uint8_t)info.type;
+    out[2] = value & 0xFF;
+    out[3] = (value >> 8) & 0xFF;
+    out[4] = (value >> 16) & 0xFF;
+    out[5] = (value >> 24) & 0xFF;
+    return PARAM_RECORD_SIZE;
+}
+
+size_t ParameterRegistry::handleBinary(const uint8_t* request, size_t length, uint8_t* response, size_t capacity) {
+    if (capacity < PARAM_RESPONSE_HEADER_SIZE + (size_t)PARAMETER_COUNT * PARAM_RECORD_SIZE) {
+        return 0;
+    }
+    
+    uint8_t op = length >= 2 ? request[1] : 0;
+    uint8_t status = PARAM_STATUS_OK;
+    uint8_t count = 0;
+    size_t pos = PARAM_RESPONSE_HEADER_SIZE;
+    
+    if (length < 2 || request[0] != PARAM_BINARY_MARKER) {
+        status = PARAM_STATUS_INVALID;
+    } else if (op == PARAM_OP_GET) {
+        if (length < 3 || request[2] > PARAMETER_COUNT || length != 3 + (size_t)request[2]) {
+            status = PARAM_STATUS_INVALID;
+        } else if (request[2] == 0) {
+            for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+                pos += writeRecord(PARAMETER_TABLE[i], response + pos);
+                count++;
+            }
+        } else {
+            for (uint8_t i = 0; i < request[2]; i++) {
+                const ParameterInfo* info = findById(request[3 + i]);
+                if (!info) {
+                    status = PARAM_STATUS_UNKNOWN_ID;
+                    continue;
+                }
+                pos += writeRecord(*info, response + pos);
+                count++;
+            }
+        }
+    } else if (op == PARAM_OP_SET) {
+        // 전부 검증한 뒤 적용 (일부만 바뀌는 일이 없도록)
+        if (length < 3 || request[2] > PARAMETER_COUNT || length != 3 + (size_t)request[2] * 5) {
+            status = PARAM_STATUS_INVALID;
+        } else {
+            for (uint8_t i = 0; i < request[2] && status == PARAM_STATUS_OK; i++) {
+                const uint8_t* item = request + 3 + i * 5;
+                const ParameterInfo* info = findById(item[0]);
+                int32_t value = readInt32(item + 1);
+                if (!info) {
+                    status = PARAM_STATUS_UNKNOWN_ID;
+                } else if (value < info->minValue || value > info->maxValue) {
+                    status = PARAM_STATUS_OUT_OF_RANGE;
+                }
+            }
+            for (uint8_t i = 0; i < request[2] && status == PARAM_STATUS_OK; i++) {
+                const uint8_t* item = request + 3 + i * 5;
+                const ParameterInfo* info = findById(item[0]);
+                set(*info, readInt32(item + 1));
+                pos += writeRecord(*info, response + pos);
+                count++;
+            }
+        }
+    } else if (op == PARAM_OP_SAVE) {
+        if (!save()) status = PARAM_STATUS_STORAGE;
+    } else if (op == PARAM_OP_RESET) {
+        resetToDefaults();
+    } else {
+        status = PARAM_STATUS_INVALID;
+    }
+    
+    response[0] = PARAM_BINARY_MARKER;
+    response[1] = op;
+    response[2] = status;
+    response[3] = count;
+    return pos;
+}
+
+String ParameterRegistry::getParameterString(const ParameterInfo& info) const {
+    String text = "param:";
+    text += info.name;
+    text += "=";
+    text += get(info);
+    text += " (";
+    text += info.minValue;
+    text += "-";
+    text += info.maxValue;
+    text += ")";
+    return text;
+}
\ No newline at end of file
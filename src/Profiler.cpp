@@ -0,0 +1,66 @@
+#include "Profiler.h"
+
+#if PROFILER_ENABLED
+
+LatencyHistogram Profiler::histograms[PROFILE_PROBE_COUNT];
+portMUX_TYPE Profiler::lock = portMUX_INITIALIZER_UNLOCKED;
+
+void Profiler::record(ProfileProbe probe, uint32_t cycles) {
+    if (probe >= PROFILE_PROBE_COUNT) return;
+    
+    portENTER_CRITICAL_SAFE(&lock);
+    histograms[probe].record(cycles);
+    portEXIT_CRITICAL_SAFE(&lock);
+}
+
+void Profiler::reset() {
+    portENTER_CRITICAL(&lock);
+    for (int i = 0; i < PROFILE_PROBE_COUNT; i++) {
+        histograms[i].reset();
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+String Profiler::getProbeString(ProfileProbe probe) {
+    if (probe >= PROFILE_PROBE_COUNT) return String();
+    
+    // 출력 중에 바뀌지 않도록 복사본으로 계산
+    portENTER_CRITICAL(&lock);
+    LatencyHistogram snapshot = histograms[probe];
+    portEXIT_CRITICAL(&lock);
+    
+    uint32_t cyclesPerUs = getCpuFrequencyMhz();
+    if (cyclesPerUs == 0) cyclesPerUs = 160;
+    
+    // 백분위는 버킷 상한 (2^n - 1 사이클)
+    String result = probeToString(probe);
+    result += " n:";
+    result += snapshot.getCount();
+    result += " min:";
+    result += snapshot.getMin();
+    result += " p50:";
+    result += snapshot.getPercentile(50);
+    result += " p99:";
+    result += snapshot.getPercentile(99);
+    result += " max:";
+    result += snapshot.getMax();
+    result += "cyc (p50:";
+    result += snapshot.getPercentile(50) / cyclesPerUs;
+    result += " p99:";
+    result += snapshot.getPercentile(99) / cyclesPerUs;
+    result += " max:";
+    result += snapshot.getMax() / cyclesPerUs;
+    result += "us)";
+    return result;
+}
+
+const char* Profiler::probeToString(ProfileProbe probe) {
+    switch (probe) {
+#define PROFILE_PROBE_NAME(id, name) case id: return name;
+        PROFILE_PROBES(PROFILE_PROBE_NAME)
+#undef PROFILE_PROBE_NAME
+        default: return "unknown";
+    }
+}
+
+#endif // PROFILER_ENABLED
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "SerialTransport.h"
+#include "LatencyTracker.h"
+
+SerialTransport::SerialTransport()
+    : commandQueue(nullptr), inFrame(false), frameLength(0), frameStartCycles(0),
+      lineLength(0), lineStartCycles(0), lastFrameTime(0), linkActive(false), lastAppliedSequence(COMMAND_SEQUENCE_NONE),
+      framesReceived(0), framesSent(0), badFrames(0), txDropped(0) {
+}
+
+SerialTransport::~SerialTransport() {
+}
+
+bool SerialTransport::initialize() {
+#if ARDUINO_USB_CDC_ON_BOOT
+    // 호스트가 포트를 열지 않았을 때 쓰기가 loop()를 막지 않도록
+    Serial.setTxTimeoutMs(0);
+#endif
+
+    Serial.println("Serial transport initialized successfully");
+    return true;
+}
+
+void SerialTransport::setCommandQueue(CommandQueue* queue) {
+    commandQueue = queue;
+}
+
+void SerialTransport::update() {
+    int available = Serial.available();
+    while (available-- > 0) {
+        uint8_t c = (uint8_t)Serial.read();
+        
+        if (c == 0) {
+            // 구분자: 프레임 시작 또는 끝 (연속된 0x00은 재동기화용)
+            if (inFrame && frameLength > 0) {
+                handleFrame(frameStartCycles);
+                inFrame = false;
+            } else {
+                inFrame = true;
+                lineLength = 0;
+            }
+            frameLength = 0;
+            frameStartCycles = LatencyTracker::now();
+            continue;
+        }
+        
+        if (inFrame) {
+            if (frameLength < sizeof(frameBuffer)) {
+                frameBuffer[frameLength++] = c;
+            } else {
+                // 너무 긴 프레임은 버리고 다음 구분자까지 무시
+                badFrames++;
+                inFrame = false;
+                frameLength = 0;
+            }
+        } else {
+            handleTextByte((char)c);
+        }
+    }
+    
+    if (linkActive && millis() - lastFrameTime > SERIAL_LINK_TIMEOUT_MS) {
+        linkActive = false;
+        Serial.println("Serial frame link inactive");
+    }
+}
+
+bool SerialTransport::isActive() const {
+    return linkActive;
+}
+
+const char* SerialTransport::getName() const {
+    return "serial";
+}
+
+bool SerialTransport::sendResponse(const char* text, size_t length) {
+    if (!linkActive) return false;
+    
+    if (length > SERIAL_FRAME_MAX_PAYLOAD) length = SERIAL_FRAME_MAX_PAYLOAD;
+    return sendFrame(SERIAL_FRAME_RESPONSE, lastAppliedSequence, (const uint8_t*)text, length);
+}
+
+bool SerialTransport::sendTextResponse(const char* text, size_t length) {
+    // 프레임 링크가 없으면 텍스트 줄 사용자: 응답을 잘리지 않은 한 줄로 출력 (로그 레벨과 무관)
+    if (Serial.availableForWrite() < (int)length + 2) {
+        txDropped++;
+        return false;
+    }
+    Serial.write((const uint8_t*)text, length);
+    Serial.write((const uint8_t*)"\r\n", 2);
+    return true;
+}
+
+bool SerialTransport::sendTelemetry(const uint8_t* data, size_t length) {
+    if (!linkActive) return false;
+    return sendFrame(SERIAL_FRAME_TELEMETRY, lastAppliedSequence, data, length);
+}
+
+size_t SerialTransport::getMaxPayload() const {
+    return SERIAL_FRAME_MAX_PAYLOAD;
+}
+
+uint16_t SerialTransport::getLastAppliedSequence() const {
+    return lastAppliedSequence;
+}
+
+void SerialTransport::acknowledgeSequence(uint16_t sequence) {
+    lastAppliedSequence = sequence;
+}
+
+String SerialTransport::getStatusString() const {
+    String status = "serial:";
+    status += linkActive ? "active" : "idle";
+    status += " rx:";
+    status += framesReceived;
+    status += " tx:";
+    status += framesSent;
+    status += " bad:";
+    status += badFrames;
+    status += " txdrop:";
+    status += txDropped;
+    return status;
+}
+
+void SerialTransport::handleFrame(uint32_t rxCycles) {
+    uint8_t decoded[SERIAL_FRAME_MAX_ENCODED];
+    SerialFrame frame;
+    if (!SerialFrameCodec::decodeFrame(frameBuffer, frameLength, decoded, frame)) {
+        badFrames++;
+        return;
+    }
+    
+    framesReceived++;
+    lastFrameTime = millis();
+    if (!linkActive) {
+        // 새 세션: 이전 호스트의 ACK를 이어 쓰지 않음
+        linkActive = true;
+        lastAppliedSequence = COMMAND_SEQUENCE_NONE;
+        Serial.println("Serial frame link active");
+    }
+    
+    if (frame.type != SERIAL_FRAME_COMMAND || frame.length == 0) {
+        return;  // 빈 명령 프레임은 링크 유지용
+    }
+    
+    CommandMessage message;
+    message.source = COMMAND_SOURCE_SERIAL_FRAME;
+    message.transport = this;
+    message.hasSequence = frame.sequence != COMMAND_SEQUENCE_NONE;
+    message.sequence = frame.sequence;
+    message.clientTime = frame.clientTime;
+    message.rxCycles = rxCycles;
+    message.overLength = frame.length > COMMAND_MAX_LENGTH;
+    
+    size_t length = frame.length;
+    if (message.overLength) length = COMMAND_MAX_LENGTH;
+    memcpy(message.text, frame.payload, length);
+    message.text[length] = '\0';
+    message.length = length;
+    
+    if (!commandQueue || !commandQueue->push(message)) {
+        Serial.println("Warning: Command queue full, serial frame dropped!");
+    }
+}
+
+void SerialTransport::handleTextByte(char c) {
+    if (lineLength == 0) {
+        lineStartCycles = LatencyTracker::now();
+    }
+    
+    if (c == '\n' || c == '\r') {
+        // 버퍼보다 긴 줄은 길이만 세어 두었다가 큐에서 overLength로 표시됨
+        if (lineLength > 0 && commandQueue) {
+            commandQueue->push(COMMAND_SOURCE_SERIAL, this, lineBuffer, lineLength, lineStartCycles);
+        }
+        lineLength = 0;
+    } else {
+        if (lineLength < COMMAND_MAX_LENGTH) {
+            lineBuffer[lineLength] = c;
+        }
+        if (lineLength <= COMMAND_MAX_LENGTH) {
+            lineLength++;
+        }
+    }
+}
+
+bool SerialTransport::sendFrame(uint8_t type, uint16_t sequence, const uint8_t* payload, size_t length) {
+    uint8_t encoded[SERIAL_FRAME_MAX_ENCODED];
+    size_t encodedLength = SerialFrameCodec::encodeFrame(type, sequence, micros(), payload, length, encoded);
+    if (encodedLength == 0) return false;
+    
+    // 호스트가 읽지 않아 TX 버퍼가 찼으면 통신 태스크를 막지 않고 버림
+    if (Serial.availableForWrite() < (int)encodedLength) {
+        txDropped++;
+        return false;
+    }
+    
+    Serial.write(encoded, encodedLength);
+    framesSent++;
+    return true;
+}
\ No newline at end of file
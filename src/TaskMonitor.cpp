@@ -0,0 +1,96 @@
+#include "TaskMonitor.h"
+
+TaskMonitor::TaskMonitor() : taskCount(0), windowStartUs(esp_timer_get_time()) {
+    lock = portMUX_INITIALIZER_UNLOCKED;
+    memset(tasks, 0, sizeof(tasks));
+}
+
+int TaskMonitor::registerTask(TaskHandle_t handle, const char* name) {
+    if (!handle) return -1;
+    
+    portENTER_CRITICAL(&lock);
+    int id = -1;
+    if (taskCount < TASK_MONITOR_MAX_TASKS) {
+        id = taskCount++;
+        tasks[id].handle = handle;
+        tasks[id].name = name;
+        tasks[id].reportsBusy = true;
+    }
+    portEXIT_CRITICAL(&lock);
+    
+    if (id < 0) {
+        Serial.print("Task monitor full, not tracking: ");
+        Serial.println(name);
+    }
+    return id;
+}
+
+int TaskMonitor::registerTaskByName(const char* name) {
+    TaskHandle_t handle = xTaskGetHandle(name);
+    if (!handle) return -1;
+    
+    int id = registerTask(handle, name);
+    if (id >= 0) {
+        tasks[id].reportsBusy = false;
+    }
+    return id;
+}
+
+void TaskMonitor::addBusyTime(int id, uint32_t busyUs) {
+    if (id < 0 || id >= taskCount) return;
+    
+    // 64비트 누적값은 한 번에 쓰이지 않으므로 읽는 쪽과 잠금으로 맞춤
+    portENTER_CRITICAL(&lock);
+    TaskEntry& entry = tasks[id];
+    entry.busyUs += busyUs;
+    if (busyUs > entry.maxBusyUs) {
+        entry.maxBusyUs = busyUs;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void TaskMonitor::resetStats() {
+    portENTER_CRITICAL(&lock);
+    for (int i = 0; i < taskCount; i++) {
+        tasks[i].busyUs = 0;
+        tasks[i].maxBusyUs = 0;
+    }
+    windowStartUs = esp_timer_get_time();
+    portEXIT_CRITICAL(&lock);
+}
+
+String TaskMonitor::getStatusString() {
+    TaskEntry snapshot[TASK_MONITOR_MAX_TASKS];
+    portENTER_CRITICAL(&lock);
+    int count = taskCount;
+    memcpy(snapshot, tasks, sizeof(snapshot));
+    uint64_t windowUs = esp_timer_get_time() - windowStartUs;
+    portEXIT_CRITICAL(&lock);
+    
+    // 예: "tasks: window:10000ms control:p5 cpu:2.4% max:180us stack:2210B comms:p3 cpu:1.1% ... esp_timer:p22 stack:2804B"
+    // 스택 값은 부팅 이후 가장 적게 남았을 때의 여유 (바이트)
+    String status = "tasks: window:";
+    status += (unsigned long)(windowUs / 1000);
+    status += "ms";
+    for (int i = 0; i < count; i++) {
+        const TaskEntry& entry = snapshot[i];
+        status += " ";
+        status += entry.name;
+        status += ":p";
+        status += (unsigned long)uxTaskPriorityGet(entry.handle);
+        if (entry.reportsBusy) {
+            status += " cpu:";
+            uint32_t permille = windowUs > 0 ? (uint32_t)(entry.busyUs * 1000 / windowUs) : 0;
+            status += permille / 10;
+            status += ".";
+            status += permille % 10;
+            status += "% max:";
+            status += entry.maxBusyUs;
+            status += "us";
+        }
+        status += " stack:";
+        status += (unsigned long)uxTaskGetStackHighWaterMark(entry.handle);
+        status += "B";
+    }
+    return status;
+}
\ No newline at end of file
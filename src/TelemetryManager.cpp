@@ -0,0 +1,263 @@
+#include "TelemetryManager.h"
+#include "MotorController.h"
+#include "EncoderManager.h"
+#include "BluetoothManager.h"
+#include "CommandProcessor.h"
+#include "TransportManager.h"
+#include "ParameterRegistry.h"
+
+TelemetryManager::TelemetryManager()
+    : motorController(nullptr), encoderManager(nullptr), bluetoothManager(nullptr), commandProcessor(nullptr), transportManager(nullptr),
+      sampleTimer(nullptr), rateHz(0), head(0), tail(0), overrun(false),
+      nextSequence(0), frameStartTime(0),
+      lastLoopUs(0), framesSent(0), samplesDropped(0) {
+    bufferLock = portMUX_INITIALIZER_UNLOCKED;
+    for (int i = 0; i < TRANSPORT_MAX_COUNT; i++) {
+        lastSentAck[i] = COMMAND_SEQUENCE_NONE;
+        lastAckTime[i] = 0;
+    }
+}
+
+TelemetryManager::~TelemetryManager() {
+    if (sampleTimer) {
+        esp_timer_stop(sampleTimer);
+        esp_timer_delete(sampleTimer);
+    }
+}
+
+bool TelemetryManager::initialize() {
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &TelemetryManager::sampleTimerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "telemetry";
+    
+    if (esp_timer_create(&timerArgs, &sampleTimer) != ESP_OK) {
+        Serial.println("Failed to create telemetry timer!");
+        return false;
+    }
+    
+    startFrame();
+    setRate(TELEMETRY_DEFAULT_RATE_HZ);
+    
+    Serial.println("Telemetry manager initialized successfully");
+    return true;
+}
+
+void TelemetryManager::setMotorController(MotorController* controller) {
+    motorController = controller;
+}
+
+void TelemetryManager::setEncoderManager(EncoderManager* manager) {
+    encoderManager = manager;
+}
+
+void TelemetryManager::setBluetoothManager(BluetoothManager* manager) {
+    bluetoothManager = manager;
+}
+
+void TelemetryManager::setCommandProcessor(CommandProcessor* processor) {
+    commandProcessor = processor;
+}
+
+void TelemetryManager::setTransportManager(TransportManager* manager) {
+    transportManager = manager;
+}
+
+bool TelemetryManager::setRate(int hz) {
+    if (!sampleTimer) return false;
+    
+    if (hz != 0 && (hz < TELEMETRY_MIN_RATE_HZ || hz > TELEMETRY_MAX_RATE_HZ)) {
+        Serial.print("Invalid telemetry rate: ");
+        Serial.println(hz);
+        return false;
+    }
+    
+    esp_timer_stop(sampleTimer);
+    rateHz = hz;
+    
+    if (hz == 0) {
+        Serial.println("Telemetry stopped");
+        return true;
+    }
+    
+    esp_timer_start_periodic(sampleTimer, 1000000ULL / hz);
+    Serial.print("Telemetry rate set to: ");
+    Serial.print(hz);
+    Serial.println(" Hz");
+    return true;
+}
+
+int TelemetryManager::getRate() const {
+    return rateHz;
+}
+
+void TelemetryManager::recordLoopTime(unsigned long loopUs) {
+    lastLoopUs = loopUs > 0xFFFF ? 0xFFFF : (uint16_t)loopUs;
+}
+
+void TelemetryManager::update() {
+    TelemetrySample sample;
+    while (popSample(sample)) {
+        if (frame.sampleCount() == 0) {
+            startFrame();  // 새 프레임마다 현재 MTU 기준으로 크기 재계산
+        }
+        if (!frame.append(sample)) {
+            flushFrame();
+            frame.append(sample);  // 빈 프레임에는 항상 들어감 (MTU보다 크면 조각으로 전송)
+        }
+        if (frame.sampleCount() == 1) {
+            frameStartTime = millis();
+        }
+    }
+    
+    // 저속 전송률에서도 지연이 커지지 않도록 일정 시간이 지나면 전송
+    if (frame.sampleCount() > 0 && millis() - frameStartTime >= ParameterRegistry::values().telemetryBatchMs) {
+        flushFrame();
+    }
+    
+    // 텔레메트리에 실어 보낼 기회가 없으면 ACK만 담은 빈 프레임을 제한된 주기로 전송
+    if (!transportManager) return;
+    for (uint8_t i = 0; i < transportManager->getCount(); i++) {
+        CommandTransport* transport = transportManager->getTransport(i);
+        if (!transport->isActive()) continue;
+        uint16_t ack = transport->getLastAppliedSequence();
+        if (ack != lastSentAck[i] && millis() - lastAckTime[i] >= BLE_ACK_INTERVAL_MS) {
+            sendAckOnlyFrame(i, transport, ack);
+        }
+    }
+}
+
+String TelemetryManager::getStatusString() const {
+    String status = "Telemetry: ";
+    status += rateHz > 0 ? String(rateHz) + "Hz" : String("OFF");
+    status += " frames:";
+    status += framesSent;
+    status += " dropped:";
+    status += samplesDropped;
+    return status;
+}
+
+void TelemetryManager::sampleTimerCallback(void* arg) {
+    static_cast<TelemetryManager*>(arg)->takeSample();
+}
+
+void TelemetryManager::takeSample() {
+    TelemetrySample sample;
+    sample.timeMs = millis();
+    
+    for (int i = 0; i < 4; i++) {
+        MotorIndex motor = static_cast<MotorIndex>(MOTOR_FRONT_LEFT + i);
+        sample.encoder[i] = encoderManager ? encoderManager->getEncoderCount(motor) : 0;
+        sample.duty[i] = motorController ? motorController->getWheelDuty(motor) : 0;
+    }
+    
+    sample.direction = motorController ? motorController->getCurrentDirection() : DIR_STOP;
+    sample.speed = motorController ? motorController->getSpeed() : 0;
+    sample.loopUs = lastLoopUs;
+    
+    sample.status = 0;
+    if (bluetoothManager && bluetoothManager->isConnected()) sample.status |= TELEMETRY_STATUS_CONNECTED;
+    if (motorController && motorController->isMotorRunning()) sample.status |= TELEMETRY_STATUS_RUNNING;
+    if (commandProcessor && commandProcessor->isInAutoMode()) sample.status |= TELEMETRY_STATUS_AUTO_MODE;
+    
+    portENTER_CRITICAL(&bufferLock);
+    if (overrun) {
+        sample.status |= TELEMETRY_STATUS_OVERRUN;
+    }
+    uint16_t next = (head + 1) % TELEMETRY_BUFFER_SIZE;
+    if (next == tail) {
+        // 버퍼가 가득 차면 가장 오래된 샘플을 버린다
+        tail = (tail + 1) % TELEMETRY_BUFFER_SIZE;
+        samplesDropped++;
+        overrun = true;
+    } else {
+        overrun = false;
+    }
+    samples[head] = sample;
+    head = next;
+    portEXIT_CRITICAL(&bufferLock);
+}
+
+bool TelemetryManager::popSample(TelemetrySample& sample) {
+    bool available = false;
+    portENTER_CRITICAL(&bufferLock);
+    if (tail != head) {
+        sample = samples[tail];
+        tail = (tail + 1) % TELEMETRY_BUFFER_SIZE;
+        available = true;
+    }
+    portEXIT_CRITICAL(&bufferLock);
+    return available;
+}
+
+void TelemetryManager::startFrame() {
+    frame.begin(frameBuffer, getFrameCapacity(), nextSequence);
+}
+
+void TelemetryManager::flushFrame() {
+    uint8_t count = frame.sampleCount();
+    if (count == 0) return;
+    
+    // 활성화되지 않은 경로로는 보내지 않고 시퀀스만 진행
+    // ACK는 경로마다 다르므로 전송 직전에 헤더의 ackSeq만 바꿔 같은 프레임을 보낸다
+    bool sent = false;
+    if (transportManager) {
+        for (uint8_t i = 0; i < transportManager->getCount(); i++) {
+            CommandTransport* transport = transportManager->getTransport(i);
+            if (!transport->isActive()) continue;
+            uint16_t ack = transport->getLastAppliedSequence();
+            frame.setAck(ack);
+            if (sendFrame(transport, frame.size())) {
+                sent = true;
+                lastSentAck[i] = ack;
+                lastAckTime[i] = millis();
+            }
+        }
+    }
+    if (sent) {
+        framesSent++;
+    }
+    
+    nextSequence += count;
+    startFrame();
+}
+
+bool TelemetryManager::sendFrame(CommandTransport* transport, size_t length) {
+    size_t payload = transport->getMaxPayload();
+    if (length <= payload) {
+        return transport->sendTelemetry(frameBuffer, length);
+    }
+    
+    // 샘플 하나짜리 프레임도 MTU보다 크면 조각으로 나누어 전송 (하나라도 실패하면 프레임 전체 유실)
+    size_t fragments = TelemetryCodec::fragmentCount(length, payload);
+    if (fragments == 0 || length > TELEMETRY_FRAME_MIN_BUFFER) return false;
+    uint8_t fragment[TELEMETRY_FRAME_MIN_BUFFER];
+    for (size_t i = 0; i < fragments; i++) {
+        size_t n = TelemetryCodec::buildFragment(fragment, payload, frameBuffer, length, (uint8_t)i);
+        if (!transport->sendTelemetry(fragment, n)) return false;
+    }
+    return true;
+}
+
+void TelemetryManager::sendAckOnlyFrame(uint8_t index, CommandTransport* transport, uint16_t ack) {
+    uint8_t ackBuffer[TELEMETRY_FRAME_HEADER_MAX];
+    TelemetryCodec::FrameEncoder ackFrame;
+    ackFrame.begin(ackBuffer, sizeof(ackBuffer), nextSequence);
+    ackFrame.setAck(ack);
+    
+    if (transport->sendTelemetry(ackBuffer, ackFrame.size())) {
+        lastSentAck[index] = ack;
+        lastAckTime[index] = millis();
+    }
+}
+
+size_t TelemetryManager::getFrameCapacity() const {
+    // 같은 프레임을 모든 경로로 보내므로 활성화된 경로 중 가장 작은 크기에 맞춘다
+    size_t capacity = TELEMETRY_MAX_FRAME_SIZE;
+    if (transportManager) {
+        size_t payload = transportManager->getMinPayload();
+        if (payload > 0 && payload < capacity) capacity = payload;
+    }
+    return capacity;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "TransportManager.h"
+
+TransportManager::TransportManager() : count(0) {
+    for (int i = 0; i < TRANSPORT_MAX_COUNT; i++) {
+        transports[i] = nullptr;
+    }
+}
+
+bool TransportManager::addTransport(CommandTransport* transport) {
+    if (!transport || count >= TRANSPORT_MAX_COUNT) {
+        Serial.println("Failed to register transport!");
+        return false;
+    }
+    
+    transports[count++] = transport;
+    Serial.print("Transport registered: ");
+    Serial.println(transport->getName());
+    return true;
+}
+
+uint8_t TransportManager::getCount() const {
+    return count;
+}
+
+CommandTransport* TransportManager::getTransport(uint8_t index) const {
+    return index < count ? transports[index] : nullptr;
+}
+
+int TransportManager::indexOf(const CommandTransport* transport) const {
+    for (int i = 0; i < count; i++) {
+        if (transports[i] == transport) return i;
+    }
+    return -1;
+}
+
+void TransportManager::update() {
+    for (int i = 0; i < count; i++) {
+        transports[i]->update();
+    }
+}
+
+void TransportManager::sendResponse(const String& response) {
+    for (int i = 0; i < count; i++) {
+        if (transports[i]->isActive()) {
+            transports[i]->sendResponse(response.c_str(), response.length());
+        } else {
+            transports[i]->sendTextResponse(response.c_str(), response.length());
+        }
+    }
+}
+
+void TransportManager::sendResponse(const uint8_t* data, size_t length) {
+    for (int i = 0; i < count; i++) {
+        if (transports[i]->isActive()) {
+            transports[i]->sendResponse((const char*)data, length);
+        }
+    }
+}
+
+size_t TransportManager::getMinPayload() const {
+    size_t minPayload = 0;
+    for (int i = 0; i < count; i++) {
+        if (!transports[i]->isActive()) continue;
+        size_t payload = transports[i]->getMaxPayload();
+        if (minPayload == 0 || payload < minPayload) {
+            minPayload = payload;
+        }
+    }
+    return minPayload;
+}
+
+String TransportManager::getStatusString() const {
+    String status = "transports:";
+    for (int i = 0; i < count; i++) {
+        status += " ";
+        status += transports[i]->getName();
+        status += transports[i]->isActive() ? "+" : "-";
+    }
+    return status;
+}
\ No newline at end of file
@@ -7,6 +7,26 @@
 #include "BluetoothManager.h"
 #include "DisplayManager.h"
 #include "CommandProcessor.h"
+#include "TelemetryManager.h"
+#include "CommandQueue.h"
+#include "LatencyTracker.h"
+#include "CommandScheduler.h"
+#include "ControlLoop.h"
+#include "MacroManager.h"
+#include "SerialTransport.h"
+#include "EspNowTransport.h"
+#include "TransportManager.h"
+#include "FleetReceiver.h"
+#include "KeepaliveMonitor.h"
+#include "ParameterRegistry.h"
+#include "LedEffectEngine.h"
+#include "I2cBusScheduler.h"
+#include "I2cWorker.h"
+#include "I2cHealthMonitor.h"
+#include "BootSequencer.h"
+#include "TaskMonitor.h"
+#include "CommsLoop.h"
+#include "Logger.h"
 
 // 전역 객체 선언
 MotorController* motorController;
@@ -14,11 +34,56 @@ EncoderManager* encoderManager;
 BluetoothManager* bluetoothManager;
 DisplayManager* displayManager;
 CommandProcessor* commandProcessor;
+TelemetryManager* telemetryManager;
+CommandQueue* commandQueue;
+LatencyTracker* latencyTracker;
+CommandScheduler* commandScheduler;
+ControlLoop* controlLoop;
+MacroManager* macroManager;
+SerialTransport* serialTransport;
+EspNowTransport* espNowTransport;
+TransportManager* transportManager;
+FleetReceiver* fleetReceiver;
+KeepaliveMonitor* keepaliveMonitor;
+ParameterRegistry* parameterRegistry;
+LedEffectEngine* ledEffects;
+I2cBusScheduler* i2cBus;
+I2cWorker* i2cWorker;
+I2cHealthMonitor* i2cHealth;
+BootSequencer* bootSequencer;
+TaskMonitor* taskMonitor;
+CommsLoop* commsLoop;
+int loopMonitorId = -1;
+
+// 부팅 백그라운드 단계: 명령 처리에 필요 없는 디스플레이/LED 작업 (loop()와 동시에 진행)
+static void runBackgroundBootStage(void* arg) {
+    Serial.println("\n[boot] Initializing Display Manager in background...");
+    if (!displayManager->initialize()) {
+        // 디스플레이 없이도 명령/BLE는 동작
+        Serial.println("WARNING: Display unavailable, continuing without OLED");
+    } else {
+        // 이후 화면 전송은 낮은 우선순위 태스크가 고정 주기로 처리 (실패 시 호출 시점에 바로 전송)
+        if (!displayManager->startRefreshTask()) {
+            Serial.println("WARNING: Display refresh task unavailable, updating synchronously");
+        }
+        displayManager->updateStartupScreen();
+        displayManager->updateMotorStatus();
+    }
+    
+    // 시작 신호 LED (타이머로 진행되므로 바로 반환)
+    displayManager->showStartupEffect();
+}
 
 void setup() {
-    // 시리얼 통신 초기화
+    // 시리얼 통신 초기화 (버퍼 크기는 begin 전에 설정)
+#if ARDUINO_USB_CDC_ON_BOOT
+    Serial.setRxBufferSize(SERIAL_RX_BUFFER_SIZE);
+    Serial.setTxBufferSize(SERIAL_TX_BUFFER_SIZE);
+#endif
     Serial.begin(SERIAL_BAUD_RATE);
-    delay(1000); // 시리얼 통신 안정화를 위한 지연
+    // 시리얼 안정화 대기(1초)는 두지 않음: 모니터가 늦게 붙어 놓친 부팅 로그는 "boot" 명령으로 확인
+    bootSequencer = new BootSequencer();
+    bootSequencer->mark(BOOT_STAGE_SERIAL);
     Serial.println("\n\n=== ESP32C3 Mecanum Wheel Robot (4 Motors) - Modular Version ===");
     Serial.println("Starting initialization sequence...");
     
@@ -27,14 +92,22 @@ void setup() {
     digitalWrite(LED_PIN, LOW);
     Serial.println("LED pin configured");
     
-    // I2C 통신 초기화 (가장 먼저)
+    // I2C 통신 초기화 (가장 먼저, 속도는 객체 생성 후 probe로 결정)
     Serial.println("Initializing I2C...");
     Wire.begin();
-    Wire.setClock(400000); // 400kHz
-    Serial.println("I2C initialized at 400kHz");
+    Wire.setClock(I2C_BUS_CLOCK_HZ);
+    Serial.println("I2C initialized");
     
     // 객체 생성
     Serial.println("\nCreating objects...");
+    Serial.println("Creating ParameterRegistry...");
+    parameterRegistry = new ParameterRegistry();  // 다른 모듈이 읽는 기본값을 먼저 채움
+    Serial.println("Creating I2cBusScheduler...");
+    i2cBus = new I2cBusScheduler();
+    Serial.println("Creating I2cWorker...");
+    i2cWorker = new I2cWorker();
+    Serial.println("Creating I2cHealthMonitor...");
+    i2cHealth = new I2cHealthMonitor();
     Serial.println("Creating MotorController...");
     motorController = new MotorController();
     Serial.println("Creating EncoderManager...");
@@ -45,24 +118,81 @@ void setup() {
     bluetoothManager = new BluetoothManager();
     Serial.println("Creating CommandProcessor...");
     commandProcessor = new CommandProcessor();
+    Serial.println("Creating TelemetryManager...");
+    telemetryManager = new TelemetryManager();
+    Serial.println("Creating CommandQueue...");
+    commandQueue = new CommandQueue();
+    Serial.println("Creating LatencyTracker...");
+    latencyTracker = new LatencyTracker();
+    Serial.println("Creating CommandScheduler...");
+    commandScheduler = new CommandScheduler();
+    Serial.println("Creating ControlLoop...");
+    controlLoop = new ControlLoop();
+    Serial.println("Creating MacroManager...");
+    macroManager = new MacroManager();
+    Serial.println("Creating SerialTransport...");
+    serialTransport = new SerialTransport();
+    Serial.println("Creating EspNowTransport...");
+    espNowTransport = new EspNowTransport();
+    Serial.println("Creating TransportManager...");
+    transportManager = new TransportManager();
+    Serial.println("Creating FleetReceiver...");
+    fleetReceiver = new FleetReceiver();
+    Serial.println("Creating KeepaliveMonitor...");
+    keepaliveMonitor = new KeepaliveMonitor();
+    Serial.println("Creating LedEffectEngine...");
+    ledEffects = new LedEffectEngine();
+    Serial.println("Creating TaskMonitor...");
+    taskMonitor = new TaskMonitor();
+    Serial.println("Creating CommsLoop...");
+    commsLoop = new CommsLoop();
     Serial.println("All objects created successfully");
     
+    // 모듈 초기화 전에 버스 속도 결정 (1MHz → 800/400/100kHz 순으로 fallback)
+    i2cBus->selectClock();
+    
+    // 공유 I2C 버스 중재는 각 모듈 초기화(첫 I2C 전송) 전에 연결
+    motorController->setI2cBusScheduler(i2cBus);
+    motorController->setI2cWorker(i2cWorker);
+    displayManager->setI2cBusScheduler(i2cBus);
+    i2cWorker->setI2cBusScheduler(i2cBus);
+    i2cWorker->setHealthMonitor(i2cHealth);
+    i2cWorker->setTaskMonitor(taskMonitor);
+    i2cHealth->setI2cBusScheduler(i2cBus);
+    i2cHealth->setCommandProcessor(commandProcessor);
+    i2cHealth->setDisplayManager(displayManager);
+    bootSequencer->mark(BOOT_STAGE_I2C);
+    
     // 각 모듈 초기화
     Serial.println("\nInitializing modules...");
     
-    Serial.println("\n1. Initializing Display Manager...");
-    if (!displayManager->initialize()) {
-        Serial.println("ERROR: Failed to initialize display manager!");
-        return;
+    // 저장된 파라미터를 모터/텔레메트리 초기화 전에 적용 (실패해도 기본값으로 동작)
+    Serial.println("\n0. Loading Parameter Registry...");
+    if (!parameterRegistry->initialize()) {
+        Serial.println("WARNING: Parameter storage unavailable, using defaults");
     }
-    Serial.println("Display manager initialized successfully");
     
-    Serial.println("\n2. Initializing Motor Controller...");
+    // 모터를 가장 먼저 안전한 상태로 (워커 시작 전이므로 정지 프레임은 동기 전송으로 확인됨)
+    Serial.println("\n1. Initializing Motor Controller...");
     if (!motorController->initialize()) {
         Serial.println("ERROR: Failed to initialize motor controller!");
         return;
     }
     Serial.println("Motor controller initialized successfully");
+    bootSequencer->mark(BOOT_STAGE_MOTORS_SAFE);
+    
+    // 비동기 I2C 워커 (실패하면 모터는 동기 출력으로 동작)
+    if (!i2cWorker->initialize()) {
+        Serial.println("WARNING: I2C worker unavailable, motor output stays synchronous");
+    }
+    
+    // LED 효과 엔진은 디스플레이/BLE가 사용하므로 먼저 (실패해도 효과만 생략)
+    if (!ledEffects->initialize()) {
+        Serial.println("WARNING: LED effects unavailable");
+    }
+    
+    // 디스플레이는 setup() 끝에서 백그라운드 단계로 초기화
+    Serial.println("\n2. Display Manager deferred to background stage");
     
     Serial.println("\n3. Initializing Encoder Manager...");
     if (!encoderManager->initialize()) {
@@ -76,44 +206,170 @@ void setup() {
     Serial.println("Connecting Display Manager to Motor and Encoder...");
     displayManager->setMotorController(motorController);
     displayManager->setEncoderManager(encoderManager);
+    displayManager->setLedEffectEngine(ledEffects);
+    displayManager->setTaskMonitor(taskMonitor);
     
     Serial.println("Connecting Command Processor to all managers...");
     commandProcessor->setMotorController(motorController);
     commandProcessor->setEncoderManager(encoderManager);
     commandProcessor->setDisplayManager(displayManager);
+    commandProcessor->setTelemetryManager(telemetryManager);
+    commandProcessor->setBluetoothManager(bluetoothManager);
+    commandProcessor->setLatencyTracker(latencyTracker);
+    commandProcessor->setCommandScheduler(commandScheduler);
+    commandProcessor->setMacroManager(macroManager);
+    commandProcessor->setTransportManager(transportManager);
+    commandProcessor->setEspNowTransport(espNowTransport);
+    commandProcessor->setFleetReceiver(fleetReceiver);
+    commandProcessor->setKeepaliveMonitor(keepaliveMonitor);
+    commandProcessor->setParameterRegistry(parameterRegistry);
+    commandProcessor->setLedEffectEngine(ledEffects);
+    commandProcessor->setI2cBusScheduler(i2cBus);
+    commandProcessor->setI2cWorker(i2cWorker);
+    commandProcessor->setI2cHealthMonitor(i2cHealth);
+    commandProcessor->setBootSequencer(bootSequencer);
+    commandProcessor->setTaskMonitor(taskMonitor);
+    commandProcessor->setControlLoop(controlLoop);
+    
+    Serial.println("Connecting Telemetry Manager to data sources...");
+    telemetryManager->setMotorController(motorController);
+    telemetryManager->setEncoderManager(encoderManager);
+    telemetryManager->setBluetoothManager(bluetoothManager);
+    telemetryManager->setCommandProcessor(commandProcessor);
+    telemetryManager->setTransportManager(transportManager);
+    
+    Serial.println("Connecting Bluetooth Manager to Command Queue...");
+    bluetoothManager->setCommandQueue(commandQueue);
+    bluetoothManager->setLedEffectEngine(ledEffects);
+    serialTransport->setCommandQueue(commandQueue);
+    espNowTransport->setCommandQueue(commandQueue);
+    fleetReceiver->setCommandQueue(commandQueue);
+    
+    Serial.println("Connecting Macro Manager and Keepalive Monitor to Motor Controller...");
+    macroManager->setMotorController(motorController);
+    keepaliveMonitor->setMotorController(motorController);
     
-    Serial.println("Connecting Bluetooth Manager to Command Processor...");
-    bluetoothManager->setCommandProcessor(commandProcessor);
+    Serial.println("Connecting Control Loop to Command Scheduler...");
+    controlLoop->setCommandScheduler(commandScheduler);
+    controlLoop->setCommandProcessor(commandProcessor);
+    controlLoop->setTaskMonitor(taskMonitor);
+    
+    Serial.println("Connecting Comms Loop to transports and Command Processor...");
+    commsLoop->setBluetoothManager(bluetoothManager);
+    commsLoop->setTransportManager(transportManager);
+    commsLoop->setFleetReceiver(fleetReceiver);
+    commsLoop->setCommandQueue(commandQueue);
+    commsLoop->setCommandProcessor(commandProcessor);
+    commsLoop->setTelemetryManager(telemetryManager);
+    commsLoop->setTaskMonitor(taskMonitor);
+    
+    Serial.println("\n4. Initializing Command Queue...");
+    if (!commandQueue->initialize()) {
+        Serial.println("ERROR: Failed to initialize command queue!");
+        return;
+    }
+    Serial.println("Command queue initialized successfully");
+    
+    Serial.println("\n5. Initializing Serial Transport...");
+    if (!serialTransport->initialize()) {
+        Serial.println("ERROR: Failed to initialize serial transport!");
+        return;
+    }
+    Serial.println("Serial transport initialized successfully");
+    bootSequencer->mark(BOOT_STAGE_COMMAND_PATH);
     
-    Serial.println("\n4. Initializing Bluetooth Manager...");
+    Serial.println("\n6. Initializing Bluetooth Manager...");
     if (!bluetoothManager->initialize()) {
         Serial.println("ERROR: Failed to initialize bluetooth manager!");
         return;
     }
     Serial.println("Bluetooth manager initialized successfully");
+    bootSequencer->mark(BOOT_STAGE_ADVERTISING);  // initialize() 마지막에 광고 시작
     
-    // 시작 화면 표시
-    Serial.println("\nUpdating display...");
-    displayManager->updateStartupScreen();
-    Serial.println("\nUpdating display(Effect)...");
-    displayManager->showStartupEffect();
+    Serial.println("\n7. Initializing Fleet Receiver...");
+    if (!fleetReceiver->initialize()) {
+        Serial.println("ERROR: Failed to initialize fleet receiver!");
+        return;
+    }
+    Serial.println("Fleet receiver initialized successfully");
+    
+    Serial.println("\n8. Initializing ESP-NOW Transport...");
+    bool espNowReady = espNowTransport->initialize();
+    if (!espNowReady) {
+        Serial.println("WARNING: ESP-NOW unavailable, continuing with BLE/serial only");
+    }
+    
+    Serial.println("Registering transports...");
+    transportManager->addTransport(bluetoothManager);
+    transportManager->addTransport(serialTransport);
+    if (espNowReady) {
+        transportManager->addTransport(espNowTransport);
+    }
+    
+    Serial.println("\n9. Initializing Telemetry Manager...");
+    if (!telemetryManager->initialize()) {
+        Serial.println("ERROR: Failed to initialize telemetry manager!");
+        return;
+    }
+    Serial.println("Telemetry manager initialized successfully");
+    
+    Serial.println("\n10. Initializing Macro Manager...");
+    if (!macroManager->initialize()) {
+        Serial.println("ERROR: Failed to initialize macro manager!");
+        return;
+    }
+    Serial.println("Macro manager initialized successfully");
+    
+    Serial.println("\n11. Initializing Control Loop...");
+    if (!controlLoop->initialize()) {
+        Serial.println("ERROR: Failed to initialize control loop!");
+        return;
+    }
+    Serial.println("Control loop initialized successfully");
+    
+    // 그동안 도착한 명령은 큐에 쌓여 있다가 통신 태스크가 시작되면 바로 처리됨
+    Serial.println("\n12. Initializing Comms Loop...");
+    if (!commsLoop->initialize()) {
+        Serial.println("ERROR: Failed to initialize comms loop!");
+        return;
+    }
+    Serial.println("Comms loop initialized successfully");
+    
+    // loop()는 UI/로그/버스 감시만 담당, 라이브러리 태스크는 스택 여유만 보고
+    loopMonitorId = taskMonitor->registerTask(xTaskGetCurrentTaskHandle(), "loop");
+    taskMonitor->registerTaskByName("esp_timer");
+    taskMonitor->registerTaskByName("BTC_TASK");
+    taskMonitor->registerTaskByName("BTU_TASK");
     
-    Serial.println("\nInitial status update...");
-    // 초기 상태 업데이트
-    displayManager->updateMotorStatus();
+    // 여기부터 통신 태스크가 명령을 받음, 시작 화면/LED 효과는 그와 동시에 진행
+    bootSequencer->mark(BOOT_STAGE_SETUP_DONE);
+    bootSequencer->runInBackground(runBackgroundBootStage, nullptr);
     
     Serial.println("\n=== 4-Motor Mecanum Robot setup complete ===");
+    bootSequencer->printSummary();
     Serial.println("Ready for commands...");
     Serial.println("----------------------------------------");
 }
 
 void loop() {
-    // 블루투스 연결 상태 변경 처리
-    bluetoothManager->handleConnectionChange();
+    // 우선순위 1의 UI/감시 루프: 명령 처리는 통신 태스크(3), 화면 전송은 디스플레이 태스크(0), LED는 타이머가 담당
+    // 핫패스 로그 출력(Logger::drain)과 설정의 NVS 쓰기도 여기서
+    unsigned long loopStart = micros();
+    
+    // I2C 버스 상태 감시 (복구는 호출마다 한 단계씩)
+    i2cHealth->update(millis());
     
     // 인코더 정보 주기적 출력
     encoderManager->periodicPrint();
     
-    // 메인 루프 지연
-    delay(10);
+    // 명령 처리 중에 바뀐 설정의 NVS 쓰기 (통신/제어 태스크 밖에서)
+    macroManager->commitStorage();
+    fleetReceiver->commitStorage();
+    parameterRegistry->commitStorage();
+    
+    // 다른 태스크가 쌓아 둔 로그 레코드를 시리얼로 내보냄
+    Logger::drain();
+    
+    taskMonitor->addBusyTime(loopMonitorId, micros() - loopStart);
+    delay(UI_LOOP_PERIOD_MS);
 }
\ No newline at end of file
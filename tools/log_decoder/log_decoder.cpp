@@ -0,0 +1,167 @@
+// 호스트용 바이너리 로그 디코더
+//
+// 빌드:  g++ -std=c++11 -O2 -I../../include log_decoder.cpp -o log_decoder
+// 사용:
+//   ./log_decoder < /dev/ttyACM0       USB 시리얼 원시 바이트에서 SERIAL_FRAME_LOG 프레임을 찾아 글자로 출력
+//                                      (프레임이 아닌 디버그 텍스트는 그대로 통과, 다른 프레임은 무시)
+//   ./log_decoder --catalog            펌웨어와 같은 카탈로그 (번호, 레벨, 이름, 형식) 출력
+//   ./log_decoder --selftest           인코딩 → 프레임 → 디코딩 왕복 검증
+//
+// 카탈로그는 include/LogCatalog.h를 그대로 쓰므로 펌웨어와 같은 소스 버전으로 빌드해야 한다.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "LogCatalog.h"
+#include "SerialFrameCodec.h"
+
+// 프레임 안의 레코드를 한 줄씩 출력 (프레임 번호가 건너뛰면 stderr로 알림)
+static bool printLogFrame(const SerialFrame& frame, uint16_t& expectedSeq, bool& haveSeq, FILE* out) {
+    if (haveSeq && frame.sequence != expectedSeq) {
+        fprintf(stderr, "gap: expected log frame %u, got %u\n", expectedSeq, frame.sequence);
+    }
+    expectedSeq = (uint16_t)(frame.sequence + 1);
+    haveSeq = true;
+    
+    size_t offset = 0;
+    while (offset < frame.length) {
+        size_t length = frame.payload[offset];
+        if (length < LOG_RECORD_HEADER_SIZE || offset + length > frame.length) {
+            fprintf(stderr, "skip: malformed log record at offset %zu\n", offset);
+            return false;
+        }
+        char line[512];
+        LogCatalog::formatLine(frame.payload + offset, length, line, sizeof(line));
+        fprintf(out, "%s\n", line);
+        offset += length;
+    }
+    return true;
+}
+
+// 0x00 사이의 바이트열: CRC가 맞는 로그 프레임이면 디코딩, 아니면 디버그 텍스트로 통과
+static void handleChunk(const std::vector<uint8_t>& chunk, uint16_t& expectedSeq, bool& haveSeq, FILE* out) {
+    if (chunk.empty()) return;
+    
+    uint8_t decoded[SERIAL_FRAME_MAX_ENCODED];
+    SerialFrame frame;
+    if (chunk.size() <= SERIAL_FRAME_MAX_ENCODED &&
+        SerialFrameCodec::decodeFrame(chunk.data(), chunk.size(), decoded, frame)) {
+        if (frame.type == SERIAL_FRAME_LOG) {
+            printLogFrame(frame, expectedSeq, haveSeq, out);
+        }
+        return;
+    }
+    fwrite(chunk.data(), 1, chunk.size(), out);
+}
+
+static int decodeSerialStream() {
+    std::vector<uint8_t> chunk;
+    uint16_t expectedSeq = 0;
+    bool haveSeq = false;
+    int c;
+    
+    while ((c = fgetc(stdin)) != EOF) {
+        if (c != 0) {
+            chunk.push_back((uint8_t)c);
+            continue;
+        }
+        handleChunk(chunk, expectedSeq, haveSeq, stdout);
+        chunk.clear();
+        fflush(stdout);
+    }
+    handleChunk(chunk, expectedSeq, haveSeq, stdout);
+    return 0;
+}
+
+static int printCatalog() {
+    for (uint16_t id = 0; id < LOG_ID_COUNT; id++) {
+        const LogCatalog::Entry* entry = LogCatalog::find(id);
+        printf("%3u %c %-28s \"%s\"\n", id, LogCatalog::levelToChar(entry->level), entry->name, entry->format);
+    }
+    return 0;
+}
+
+// 펌웨어의 Logger와 같은 방식으로 레코드를 프레임에 묶어 텍스트 사이에 섞은 뒤 다시 디코딩
+static int runSelfTest() {
+    struct Case {
+        LogId id;
+        int32_t args[LOG_MAX_ARGS];
+        uint8_t argCount;
+        const char* text;
+        const char* expected;
+    };
+    static const Case cases[] = {
+        { LOG_MECANUM_SET, { 4095, -4095, 0, -1 }, 4, nullptr, "Mecanum Motors - FL:4095 FR:-4095 RL:0 RR:-1" },
+        { LOG_MOTOR_SET, { -2048 }, 1, "FL", "FL Motor: -2048" },
+        { LOG_SPEED_SET, { 50, 2047 }, 2, nullptr, "Speed set to: 50% (PWM: 2047)" },
+        { LOG_BLE_RECEIVED, { 2 }, 1, "fwd", "BLE Received: fwd (conn:2)" },
+        { LOG_BLE_WRITE, { 0 }, 0, nullptr, "CharacteristicCallbacks::onWrite called" },
+        { LOG_COMMAND_PROCESSING, { 0 }, 0, "", "Processing command: " },
+    };
+    const size_t caseCount = sizeof(cases) / sizeof(cases[0]);
+    
+    std::vector<uint8_t> stream;
+    const char* noise = "plain debug text\r\n";
+    stream.insert(stream.end(), noise, noise + strlen(noise));
+    
+    uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+    size_t payloadLength = 0;
+    for (size_t i = 0; i < caseCount; i++) {
+        const Case& c = cases[i];
+        payloadLength += LogCatalog::encodeRecord(c.id, (uint32_t)(1000000 + i * 1500), c.args, c.argCount,
+                                                  c.text, payload + payloadLength);
+    }
+    uint8_t encoded[SERIAL_FRAME_MAX_ENCODED];
+    size_t encodedLength = SerialFrameCodec::encodeFrame(SERIAL_FRAME_LOG, 0, 0, payload, payloadLength, encoded);
+    stream.insert(stream.end(), encoded, encoded + encodedLength);
+    stream.insert(stream.end(), noise, noise + strlen(noise));
+    
+    // 디코딩 결과를 메모리로 받아 비교
+    FILE* out = tmpfile();
+    if (!out) return 1;
+    std::vector<uint8_t> chunk;
+    uint16_t expectedSeq = 0;
+    bool haveSeq = false;
+    for (uint8_t b : stream) {
+        if (b != 0) {
+            chunk.push_back(b);
+            continue;
+        }
+        handleChunk(chunk, expectedSeq, haveSeq, out);
+        chunk.clear();
+    }
+    handleChunk(chunk, expectedSeq, haveSeq, out);
+    
+    rewind(out);
+    std::string text;
+    char buf[512];
+    while (fgets(buf, sizeof(buf), out)) text += buf;
+    fclose(out);
+    
+    for (size_t i = 0; i < caseCount; i++) {
+        if (text.find(cases[i].expected) == std::string::npos) {
+            fprintf(stderr, "FAIL: missing \"%s\"\n%s", cases[i].expected, text.c_str());
+            return 1;
+        }
+    }
+    if (text.find("[1.000000] D Mecanum") == std::string::npos || text.find(noise) == std::string::npos) {
+        fprintf(stderr, "FAIL: prefix or passthrough text wrong\n%s", text.c_str());
+        return 1;
+    }
+    
+    printf("selftest OK: %zu records in %zu bytes (frame %zu bytes)\n", caseCount, payloadLength, encodedLength);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--catalog") == 0) {
+        return printCatalog();
+    }
+    if (argc > 1 && strcmp(argv[1], "--selftest") == 0) {
+        return runSelfTest();
+    }
+    return decodeSerialStream();
+}
\ No newline at end of file
@@ -0,0 +1,293 @@
+// 호스트용 텔레메트리 디코더
+//
+// 빌드:  g++ -std=c++11 -O2 -I../../include telemetry_decoder.cpp -o telemetry_decoder
+// 사용:
+//   ./telemetry_decoder < frames.txt      한 줄에 프레임 하나(16진수 문자열)를 읽어 CSV로 출력
+//   ./telemetry_decoder --loopback [mtu]   BLE 링크 대신 LoopbackTransport로 인코딩→디코딩 왕복 검증
+//   ./telemetry_decoder --serial < /dev/ttyACM0
+//                                          USB 시리얼 원시 바이트에서 COBS 프레임을 찾아 CSV로 출력
+//                                          (디버그 텍스트는 무시, 텍스트 응답은 stderr로 출력)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TelemetryCodec.h"
+#include "SerialFrameCodec.h"
+#include "LoopbackTransport.h"
+
+static const size_t MAX_SAMPLES_PER_FRAME = 255;
+
+static void printHeader() {
+    printf("ack,seq,time_ms,enc_fl,enc_fr,enc_rl,enc_rr,duty_fl,duty_fr,duty_rl,duty_rr,dir,speed,loop_us,status\n");
+}
+
+static void printSample(uint16_t ack, uint32_t seq, const TelemetrySample& s) {
+    printf("%u,%u,%u,%d,%d,%d,%d,%d,%d,%d,%d,%u,%u,%u,0x%02X\n",
+           ack, seq, s.timeMs,
+           s.encoder[0], s.encoder[1], s.encoder[2], s.encoder[3],
+           s.duty[0], s.duty[1], s.duty[2], s.duty[3],
+           s.direction, s.speed, s.loopUs, s.status);
+}
+
+static bool parseHex(const std::string& line, std::vector<uint8_t>& out) {
+    out.clear();
+    int high = -1;
+    for (char c : line) {
+        int v;
+        if (c >= '0' && c <= '9') v = c - '0';
+        else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+        else if (c == ' ' || c == ':' || c == '-' || c == '\r' || c == '\t') continue;
+        else return false;
+        
+        if (high < 0) {
+            high = v;
+        } else {
+            out.push_back((uint8_t)((high << 4) | v));
+            high = -1;
+        }
+    }
+    return high < 0 && !out.empty();
+}
+
+// 프레임 하나를 CSV로 출력 (시퀀스 불연속은 stderr로 알림)
+static void printFrame(const uint8_t* data, size_t length, uint32_t& expectedSeq, bool& haveSeq) {
+    TelemetrySample samples[MAX_SAMPLES_PER_FRAME];
+    uint32_t firstSeq = 0;
+    uint16_t ack = 0;
+    int count = TelemetryCodec::decodeFrame(data, length, samples, MAX_SAMPLES_PER_FRAME, &firstSeq, &ack);
+    if (count < 0) {
+        fprintf(stderr, "skip: malformed frame (%zu bytes)\n", length);
+        return;
+    }
+    if (count == 0) {
+        printf("%u,,,,,,,,,,,,,\n", ack);  // 순수 ACK 프레임
+        return;
+    }
+    
+    if (haveSeq && firstSeq != expectedSeq) {
+        fprintf(stderr, "gap: expected seq %u, got %u\n", expectedSeq, firstSeq);
+    }
+    for (int i = 0; i < count; i++) {
+        printSample(ack, firstSeq + i, samples[i]);
+    }
+    expectedSeq = firstSeq + count;
+    haveSeq = true;
+}
+
+// 조각이면 이어 붙이고, 프레임이 완성되었을 때만 출력
+static void printPacket(TelemetryCodec::FrameAssembler& assembler, const uint8_t* data, size_t length,
+                        uint32_t& expectedSeq, bool& haveSeq) {
+    if (!TelemetryCodec::isFragment(data, length)) {
+        printFrame(data, length, expectedSeq, haveSeq);
+    } else if (assembler.push(data, length)) {
+        printFrame(assembler.frame(), assembler.size(), expectedSeq, haveSeq);
+    }
+}
+
+static int decodeStream() {
+    std::vector<uint8_t> frame;
+    char buf[4096];
+    uint32_t expectedSeq = 0;
+    bool haveSeq = false;
+    TelemetryCodec::FrameAssembler assembler;
+    
+    printHeader();
+    while (fgets(buf, sizeof(buf), stdin)) {
+        std::string line(buf);
+        if (!line.empty() && line.back() == '\n') line.pop_back();
+        if (line.empty()) continue;
+        
+        if (!parseHex(line, frame)) {
+            fprintf(stderr, "skip: invalid hex line\n");
+            continue;
+        }
+        
+        printPacket(assembler, frame.data(), frame.size(), expectedSeq, haveSeq);
+    }
+    return 0;
+}
+
+static int decodeSerialStream() {
+    std::vector<uint8_t> chunk;
+    uint8_t decoded[SERIAL_FRAME_MAX_ENCODED];
+    uint32_t expectedSeq = 0;
+    bool haveSeq = false;
+    TelemetryCodec::FrameAssembler assembler;
+    int c;
+    
+    printHeader();
+    while ((c = fgetc(stdin)) != EOF) {
+        if (c != 0) {
+            if (chunk.size() < SERIAL_FRAME_MAX_ENCODED) chunk.push_back((uint8_t)c);
+            continue;
+        }
+        
+        // 0x00 사이의 바이트열 중 CRC가 맞는 것만 프레임으로 인정 (디버그 텍스트는 여기서 걸러짐)
+        SerialFrame frame;
+        if (!chunk.empty() && SerialFrameCodec::decodeFrame(chunk.data(), chunk.size(), decoded, frame)) {
+            if (frame.type == SERIAL_FRAME_TELEMETRY) {
+                printPacket(assembler, frame.payload, frame.length, expectedSeq, haveSeq);
+            } else if (frame.type == SERIAL_FRAME_RESPONSE) {
+                fprintf(stderr, "response: %.*s\n", (int)frame.length, (const char*)frame.payload);
+            }
+            fflush(stdout);
+        }
+        chunk.clear();
+    }
+    return 0;
+}
+
+static TelemetrySample makeSample(uint32_t i) {
+    TelemetrySample s;
+    s.timeMs = 100000 + i * 5;
+    s.encoder[0] = (int32_t)(i * 37);
+    s.encoder[1] = -(int32_t)(i * 41);
+    s.encoder[2] = (int32_t)(i * i);
+    s.encoder[3] = (i % 50 == 0) ? 2000000000 : -(int32_t)i;
+    s.duty[0] = (int16_t)((i * 97) % 8191 - 4095);
+    s.duty[1] = (int16_t)(i % 2 ? 4095 : -4095);
+    s.duty[2] = 0;
+    s.duty[3] = (int16_t)(i % 4096);
+    s.direction = (uint8_t)(i % 9);
+    s.speed = (uint8_t)(i % 101);
+    s.loopUs = (uint16_t)(i * 13);
+    s.status = (uint8_t)(i & 0x87);
+    return s;
+}
+
+static bool sameSample(const TelemetrySample& a, const TelemetrySample& b) {
+    if (a.timeMs != b.timeMs || a.direction != b.direction || a.speed != b.speed ||
+        a.loopUs != b.loopUs || a.status != b.status) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (a.encoder[i] != b.encoder[i] || a.duty[i] != b.duty[i]) return false;
+    }
+    return true;
+}
+
+// 루프백 경로에 쌓인 패킷을 모두 꺼내 디코딩/검증
+static bool drainLoopback(LoopbackTransport& link, TelemetryCodec::FrameAssembler& assembler, uint32_t& expected,
+                          size_t& fragments) {
+    TelemetrySample samples[MAX_SAMPLES_PER_FRAME];
+    uint8_t payload[LOOPBACK_PACKET_SIZE];
+    uint8_t kind;
+    size_t length;
+    while (link.receive(&kind, payload, &length)) {
+        if (kind != LOOPBACK_TELEMETRY) continue;
+        const uint8_t* data = payload;
+        if (TelemetryCodec::isFragment(payload, length)) {
+            fragments++;
+            if (!assembler.push(payload, length)) continue;
+            data = assembler.frame();
+            length = assembler.size();
+        }
+        uint32_t firstSeq = 0;
+        uint16_t ack = 0;
+        int count = TelemetryCodec::decodeFrame(data, length, samples, MAX_SAMPLES_PER_FRAME, &firstSeq, &ack);
+        if (count <= 0 || firstSeq != expected || ack != link.getLastAppliedSequence()) {
+            fprintf(stderr, "FAIL: frame decode error at seq %u\n", expected);
+            return false;
+        }
+        for (int i = 0; i < count; i++) {
+            if (!sameSample(samples[i], makeSample(firstSeq + i))) {
+                fprintf(stderr, "FAIL: sample %u mismatch\n", firstSeq + i);
+                return false;
+            }
+        }
+        expected += count;
+    }
+    return true;
+}
+
+// 펌웨어의 TelemetryManager::sendFrame()과 같이 MTU보다 큰 프레임은 조각으로 전송
+static bool sendFrame(CommandTransport& transport, const uint8_t* frame, size_t length) {
+    size_t payload = transport.getMaxPayload();
+    if (length <= payload) {
+        return transport.sendTelemetry(frame, length);
+    }
+    size_t fragments = TelemetryCodec::fragmentCount(length, payload);
+    if (fragments == 0 || length > TELEMETRY_FRAME_MIN_BUFFER) return false;
+    uint8_t fragment[TELEMETRY_FRAME_MIN_BUFFER];
+    for (size_t i = 0; i < fragments; i++) {
+        size_t n = TelemetryCodec::buildFragment(fragment, payload, frame, length, (uint8_t)i);
+        if (!transport.sendTelemetry(fragment, n)) return false;
+    }
+    return true;
+}
+
+static int runLoopback(size_t mtu) {
+    const uint32_t totalSamples = 1000;
+    LoopbackTransport link(mtu);
+    CommandTransport& transport = link;  // 펌웨어와 같은 인터페이스로만 전송
+    size_t capacity = transport.getMaxPayload();
+    if (capacity > LOOPBACK_PACKET_SIZE) capacity = LOOPBACK_PACKET_SIZE;
+    
+    // 펌웨어의 TelemetryManager와 같은 방식으로 프레임을 채우고 전송
+    std::vector<uint8_t> buffer(capacity > TELEMETRY_FRAME_MIN_BUFFER ? capacity : TELEMETRY_FRAME_MIN_BUFFER);
+    TelemetryCodec::FrameEncoder frame;
+    TelemetryCodec::FrameAssembler assembler;
+    uint32_t nextSeq = 0;
+    uint32_t expected = 0;
+    size_t frames = 0;
+    size_t fragments = 0;
+    size_t bytes = 0;
+    frame.begin(buffer.data(), capacity, nextSeq);
+    
+    for (uint32_t i = 0; i <= totalSamples; i++) {
+        TelemetrySample s = makeSample(i);
+        bool last = (i == totalSamples);
+        if (last || !frame.append(s)) {
+            if (frame.sampleCount() == 0) {
+                if (last) break;
+                fprintf(stderr, "FAIL: sample %u does not fit in MTU %zu\n", i, mtu);
+                return 1;
+            }
+            transport.acknowledgeSequence((uint16_t)frames);  // 명령 적용을 흉내내 ACK 진행
+            frame.setAck(transport.getLastAppliedSequence());
+            if (!sendFrame(transport, buffer.data(), frame.size())) {
+                fprintf(stderr, "FAIL: frame at seq %u could not be sent at MTU %zu\n", nextSeq, mtu);
+                return 1;
+            }
+            frames++;
+            bytes += frame.size();
+            nextSeq += frame.sampleCount();
+            if (!drainLoopback(link, assembler, expected, fragments)) return 1;
+            if (last) break;
+            
+            frame.begin(buffer.data(), capacity, nextSeq);
+            if (!frame.append(s)) {
+                fprintf(stderr, "FAIL: sample %u does not fit in MTU %zu\n", i, mtu);
+                return 1;
+            }
+        }
+    }
+    
+    if (expected != totalSamples) {
+        fprintf(stderr, "FAIL: decoded %u of %u samples\n", expected, totalSamples);
+        return 1;
+    }
+    
+    printf("loopback OK: mtu=%zu samples=%u frames=%zu fragments=%zu bytes=%zu (%.1f B/sample, raw %zu B/sample)\n",
+           mtu, totalSamples, frames, fragments, bytes, (double)bytes / totalSamples, sizeof(TelemetrySample));
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--loopback") == 0) {
+        size_t mtu = argc > 2 ? (size_t)atoi(argv[2]) : 247;
+        if (mtu < 23) {
+            fprintf(stderr, "MTU must be >= 23\n");
+            return 2;
+        }
+        return runLoopback(mtu);
+    }
+    if (argc > 1 && strcmp(argv[1], "--serial") == 0) {
+        return decodeSerialStream();
+    }
+    return decodeStream();
+}
\ No newline at end of file